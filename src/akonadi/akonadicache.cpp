@@ -50,6 +50,8 @@ Cache::Cache(const SerializerInterface::Ptr &serializer, const MonitorInterface:
             this, &Cache::onItemAdded);
     connect(m_monitor.data(), &MonitorInterface::itemChanged,
             this, &Cache::onItemChanged);
+    connect(m_monitor.data(), &MonitorInterface::itemMetadataChanged,
+            this, &Cache::onItemMetadataChanged);
     connect(m_monitor.data(), &MonitorInterface::itemRemoved,
             this, &Cache::onItemRemoved);
 }
@@ -121,7 +123,7 @@ void Cache::populateCollection(const Collection &collection, const Item::List &i
 {
     auto &ids = m_collectionItems[collection.id()];
     for (const auto &item : items) {
-        m_items.insert(item.id(), item);
+        insertItem(item);
         if (!ids.contains(item.id()))
             ids << item.id();
     }
@@ -177,7 +179,7 @@ void Cache::populateTag(const Tag &tag, const Item::List &items)
 {
     auto &ids = m_tagItems[tag.id()];
     for (const auto &item : items) {
-        m_items.insert(item.id(), item);
+        insertItem(item);
         if (!ids.contains(item.id()))
             ids << item.id();
     }
@@ -188,6 +190,32 @@ Item Cache::item(Item::Id id) const
     return m_items.value(id);
 }
 
+Item::List Cache::descendantItems(const Item &item) const
+{
+    auto result = Item::List();
+    auto visited = QSet<Item::Id>();
+    visited.insert(item.id());
+
+    auto pendingUids = QStringList();
+    pendingUids << m_itemUids.value(item.id());
+    while (!pendingUids.isEmpty()) {
+        const auto uid = pendingUids.takeFirst();
+        if (uid.isEmpty())
+            continue;
+
+        for (const auto childId : m_childItems.value(uid)) {
+            if (visited.contains(childId))
+                continue;
+
+            visited.insert(childId);
+            result << m_items.value(childId);
+            pendingUids << m_itemUids.value(childId);
+        }
+    }
+
+    return result;
+}
+
 void Cache::onCollectionAdded(const Collection &collection)
 {
     const auto index = m_collections.indexOf(collection);
@@ -223,7 +251,7 @@ void Cache::onCollectionRemoved(const Collection &collection)
     m_collections.removeAll(collection);
 
     for (const auto itemId : m_collectionItems.value(collection.id())) {
-        m_items.remove(itemId);
+        removeItem(itemId);
 
         for (auto &itemList : m_tagItems)
             itemList.removeAll(itemId);
@@ -270,13 +298,14 @@ void Cache::onItemAdded(const Item &item)
         }
     }
     if (needsInsert)
-        m_items.insert(item.id(), item);
+        insertItem(item);
 
 }
 
 void Cache::onItemChanged(const Item &item)
 {
-    const auto oldItem = m_items.take(item.id());
+    const auto oldItem = m_items.value(item.id());
+    removeItem(item.id());
     const auto oldTags = oldItem.tags();
     const auto newTags = item.tags();
 
@@ -292,7 +321,7 @@ void Cache::onItemChanged(const Item &item)
 
     for (const auto &oldTag : oldTags) {
         if (!newTags.contains(oldTag) && m_tagItems.contains(oldTag.id())) {
-            m_tagItems[oldTag.id()].removeAll(oldTag.id());
+            m_tagItems[oldTag.id()].removeAll(item.id());
         }
     }
 
@@ -306,13 +335,30 @@ void Cache::onItemChanged(const Item &item)
                                             [this](const Tag &tag) { return m_tagItems.contains(tag.id()); });
 
     if (inPopulatedTag || m_collectionItems.contains(item.parentCollection().id())) {
-        m_items.insert(item.id(), item);
+        insertItem(item);
     }
 }
 
+void Cache::onItemMetadataChanged(const Item &item)
+{
+    // The notification might not carry the payload nor the tags depending
+    // on the monitor scope, so only the bookkeeping gets refreshed
+    auto it = m_items.find(item.id());
+    if (it == m_items.end())
+        return;
+
+    it->setRevision(item.revision());
+    it->setRemoteId(item.remoteId());
+    it->setRemoteRevision(item.remoteRevision());
+    it->setFlags(item.flags());
+    it->setModificationTime(item.modificationTime());
+    foreach (const auto attribute, item.attributes())
+        it->addAttribute(attribute->clone());
+}
+
 void Cache::onItemRemoved(const Item &item)
 {
-    m_items.remove(item.id());
+    removeItem(item.id());
     for (auto &itemList : m_collectionItems)
         itemList.removeAll(item.id());
     for (auto &itemList : m_tagItems)
@@ -325,3 +371,33 @@ bool Cache::matchCollection(StorageInterface::FetchContentTypes contentTypes, co
         || ((contentTypes & StorageInterface::Tasks) && m_serializer->isTaskCollection(collection))
         || ((contentTypes & StorageInterface::Notes) && m_serializer->isNoteCollection(collection));
 }
+
+void Cache::insertItem(const Item &item)
+{
+    removeItem(item.id());
+    m_items.insert(item.id(), item);
+
+    // Keep the parent/child index in sync to find descendants without payload scans
+    m_itemUids.insert(item.id(), m_serializer->itemUid(item));
+    const auto relatedUid = m_serializer->relatedUidFromItem(item);
+    if (!relatedUid.isEmpty())
+        m_childItems[relatedUid] << item.id();
+}
+
+void Cache::removeItem(Item::Id id)
+{
+    const auto it = m_items.find(id);
+    if (it == m_items.end())
+        return;
+
+    const auto relatedUid = m_serializer->relatedUidFromItem(*it);
+    const auto children = m_childItems.find(relatedUid);
+    if (children != m_childItems.end()) {
+        children->removeAll(id);
+        if (children->isEmpty())
+            m_childItems.erase(children);
+    }
+
+    m_itemUids.remove(id);
+    m_items.erase(it);
+}
@@ -67,6 +67,7 @@ public:
     void populateTag(const Tag &tag, const Item::List &items);
 
     Item item(Item::Id id) const;
+    Item::List descendantItems(const Item &item) const;
 
 private slots:
     void onCollectionAdded(const Collection &collection);
@@ -79,12 +80,16 @@ private slots:
 
     void onItemAdded(const Item &item);
     void onItemChanged(const Item &item);
+    void onItemMetadataChanged(const Item &item);
     void onItemRemoved(const Item &item);
 
 private:
     bool matchCollection(StorageInterface::FetchContentTypes contentTypes,
                          const Collection &collection) const;
 
+    void insertItem(const Item &item);
+    void removeItem(Item::Id id);
+
     SerializerInterface::Ptr m_serializer;
     MonitorInterface::Ptr m_monitor;
 
@@ -98,6 +103,8 @@ private:
     QHash<Tag::Id, QVector<Item::Id>> m_tagItems;
 
     QHash<Item::Id, Item> m_items;
+    QHash<Item::Id, QString> m_itemUids;
+    QHash<QString, QVector<Item::Id>> m_childItems;
 };
 
 }
@@ -32,6 +32,8 @@
 
 #include <QTimer>
 
+#include <algorithm>
+
 using namespace Akonadi;
 
 class CachingCollectionFetchJob : public KCompositeJob, public CollectionFetchJobInterface
@@ -183,6 +185,8 @@ public:
             QTimer::singleShot(0, this, &CachingCollectionItemsFetchJob::retrieveFromCache);
         } else {
             auto job = m_storage->fetchItems(m_collection);
+            if (m_itemsReceived)
+                job->setItemsReceivedFunction(m_itemsReceived);
             addSubjob(job->kjob());
         }
 
@@ -200,6 +204,12 @@ public:
         m_collection = collection;
     }
 
+    void setItemsReceivedFunction(const ItemsReceivedFunction &function) override
+    {
+        // Forwarded to the storage job so that batches go through as they arrive
+        m_itemsReceived = function;
+    }
+
 private:
     void slotResult(KJob *kjob) override
     {
@@ -218,6 +228,8 @@ private:
     void retrieveFromCache()
     {
         m_items = m_cache->items(m_collection);
+        if (m_itemsReceived)
+            m_itemsReceived(m_items);
         emitResult();
     }
 
@@ -226,6 +238,7 @@ private:
     Cache::Ptr m_cache;
     Collection m_collection;
     Item::List m_items;
+    ItemsReceivedFunction m_itemsReceived;
 };
 
 class CachingSingleItemFetchJob : public KCompositeJob, public ItemFetchJobInterface
@@ -450,7 +463,28 @@ CachingStorage::~CachingStorage()
 
 Collection CachingStorage::defaultTaskCollection()
 {
-    return m_storage->defaultTaskCollection();
+    const auto isWritable = [] (const Collection &collection) {
+        return (collection.rights() & Collection::CanCreateItem)
+            && (collection.rights() & Collection::CanChangeItem)
+            && (collection.rights() & Collection::CanDeleteItem);
+    };
+
+    // The configured collection wins unless we know it's read-only
+    const auto configured = m_storage->defaultTaskCollection();
+    if (configured.isValid()) {
+        const auto known = m_cache->collection(configured.id());
+        if (!known.isValid() || isWritable(known))
+            return configured;
+    }
+
+    // Otherwise resolve the fallback from the collections we already know,
+    // the monitor keeps them up to date so there's no need to fetch them again
+    if (!m_cache->isContentTypesPopulated(StorageInterface::Tasks))
+        return configured;
+
+    const auto collections = m_cache->collections(StorageInterface::Tasks);
+    const auto it = std::find_if(collections.constBegin(), collections.constEnd(), isWritable);
+    return it != collections.constEnd() ? *it : configured;
 }
 
 Collection CachingStorage::defaultNoteCollection()
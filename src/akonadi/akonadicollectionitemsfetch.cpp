@@ -0,0 +1,67 @@
+/* This file is part of Zanshin
+
+   Copyright 2016 Kevin Ottens <ervin@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+#include "akonadicollectionitemsfetch.h"
+
+#include <QVector>
+
+#include "akonadiitemfetchjobinterface.h"
+
+#include "utils/compositejob.h"
+#include "utils/future.h"
+
+using namespace Akonadi;
+
+namespace {
+    Utils::Future<CollectionItems> fetchCollectionItems(const StorageInterface::Ptr &storage, const Item::List &items)
+    {
+        auto collections = QHash<Collection::Id, Collection>();
+        foreach (const auto &item, items)
+            collections.insert(item.parentCollection().id(), item.parentCollection());
+
+        auto collectionIds = QVector<Collection::Id>();
+        auto fetches = QVector<Utils::Future<Item::List>>();
+        foreach (const auto &collection, collections) {
+            ItemFetchJobInterface *fetchJob = storage->fetchItems(collection);
+            collectionIds << collection.id();
+            fetches << Utils::fromJob(fetchJob->kjob(), [fetchJob] { return fetchJob->items(); });
+        }
+
+        return Utils::whenAll(fetches).then([collectionIds] (const QVector<Item::List> &itemLists) {
+            auto result = CollectionItems();
+            for (int i = 0; i < collectionIds.size(); i++)
+                result.insert(collectionIds.at(i), itemLists.at(i));
+            return result;
+        });
+    }
+}
+
+void Akonadi::installCollectionItemsFetch(const StorageInterface::Ptr &storage, Utils::CompositeJob *job,
+                                          const Item::List &items,
+                                          const std::function<void(const CollectionItems &)> &handler)
+{
+    auto fetchJob = Utils::toJob(fetchCollectionItems(storage, items).then(handler));
+    job->addSubjob(fetchJob);
+    fetchJob->start();
+}
@@ -0,0 +1,54 @@
+/* This file is part of Zanshin
+
+   Copyright 2016 Kevin Ottens <ervin@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+#ifndef AKONADI_COLLECTIONITEMSFETCH_H
+#define AKONADI_COLLECTIONITEMSFETCH_H
+
+#include <functional>
+
+#include <QHash>
+
+#include <AkonadiCore/Collection>
+#include <AkonadiCore/Item>
+
+#include "akonadi/akonadistorageinterface.h"
+
+namespace Utils {
+class CompositeJob;
+}
+
+namespace Akonadi {
+
+typedef QHash<Collection::Id, Item::List> CollectionItems;
+
+// Fetches in parallel the content of all the collections the items belong to,
+// the handler is called once with everything when all the fetches succeeded,
+// otherwise job fails with the error of the first failed fetch
+void installCollectionItemsFetch(const StorageInterface::Ptr &storage, Utils::CompositeJob *job,
+                                 const Item::List &items,
+                                 const std::function<void(const CollectionItems &)> &handler);
+
+}
+
+#endif // AKONADI_COLLECTIONITEMSFETCH_H
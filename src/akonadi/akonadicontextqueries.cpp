@@ -59,3 +59,22 @@ ContextQueries::TaskResult::Ptr ContextQueries::findTopLevelTasks(Domain::Contex
     m_integrator->bind("ContextQueries::findTopLevelTasks", query, fetch, predicate);
     return query->result();
 }
+
+Domain::Counter::Ptr ContextQueries::countTopLevelTasks(Domain::Context::Ptr context) const
+{
+    // All the contexts are counted out of a single fetch, the items
+    // being grouped by the tags they carry
+    auto fetch = m_helpers->fetchItems(StorageInterface::Tasks | StorageInterface::Notes);
+    auto groups = [] (const Akonadi::Item &item) -> QList<Akonadi::Tag::Id> {
+        QList<Akonadi::Tag::Id> tagIds;
+        foreach (const auto &tag, item.tags())
+            tagIds << tag.id();
+        return tagIds;
+    };
+    m_integrator->bindGroupCount("ContextQueries::countTopLevelTasks", m_countToplevel, fetch, groups);
+
+    if (!context->property("tagId").isValid())
+        return Domain::Counter::Ptr::create();
+
+    return m_countToplevel->counter(context->property("tagId").value<Akonadi::Tag::Id>());
+}
@@ -47,6 +47,8 @@ public:
     typedef Domain::QueryResult<Domain::Context::Ptr> ContextResult;
     typedef Domain::QueryResultProvider<Domain::Context::Ptr> ContextProvider;
 
+    typedef Domain::LiveGroupCountOutput<Akonadi::Tag::Id> CountOutput;
+
     ContextQueries(const StorageInterface::Ptr &storage,
                    const SerializerInterface::Ptr &serializer,
                    const MonitorInterface::Ptr &monitor);
@@ -54,6 +56,7 @@ public:
 
     ContextResult::Ptr findAll() const Q_DECL_OVERRIDE;
     TaskResult::Ptr findTopLevelTasks(Domain::Context::Ptr context) const Q_DECL_OVERRIDE;
+    Domain::Counter::Ptr countTopLevelTasks(Domain::Context::Ptr context) const Q_DECL_OVERRIDE;
 
 private:
     SerializerInterface::Ptr m_serializer;
@@ -62,6 +65,7 @@ private:
 
     mutable ContextQueryOutput::Ptr m_findAll;
     mutable QHash<Akonadi::Tag::Id, TaskQueryOutput::Ptr> m_findToplevel;
+    mutable CountOutput::Ptr m_countToplevel;
 };
 
 } // akonadi namespace
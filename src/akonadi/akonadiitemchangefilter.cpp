@@ -0,0 +1,79 @@
+/* This file is part of Zanshin
+
+   Copyright 2016 Kevin Ottens <ervin@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+#include "akonadiitemchangefilter.h"
+
+using namespace Akonadi;
+
+ItemChangeFilter::ChangeKind ItemChangeFilter::itemChanged(const Item &item, const QSet<QByteArray> &parts)
+{
+    // We already forwarded this revision or a newer one, it's a duplicate
+    const auto it = m_states.constFind(item.id());
+    if (it != m_states.constEnd() && item.revision() >= 0 && item.revision() <= it->revision)
+        return DuplicateChange;
+
+    if (item.revision() >= 0)
+        m_states.insert(item.id(), {item.revision(), item.parentCollection().id()});
+
+    // No information on what changed, better be safe
+    if (parts.isEmpty())
+        return RelevantChange;
+
+    // Everything we display comes from the payload (including the parent
+    // relationship for todos) or from the tags. Flags, attributes and
+    // remote ids/revisions are only bookkeeping for the resources
+    foreach (const auto &part, parts) {
+        if (part.startsWith("PLD:") || part == "TAG" || part == "TAGS")
+            return RelevantChange;
+    }
+
+    return MetadataChange;
+}
+
+void ItemChangeFilter::itemMoved(const Item &item)
+{
+    const auto it = m_states.find(item.id());
+    if (it != m_states.end())
+        it->collection = item.parentCollection().id();
+}
+
+void ItemChangeFilter::itemRemoved(const Item &item)
+{
+    m_states.remove(item.id());
+}
+
+void ItemChangeFilter::collectionRemoved(const Collection &collection)
+{
+    for (auto it = m_states.begin(); it != m_states.end();) {
+        if (it->collection == collection.id())
+            it = m_states.erase(it);
+        else
+            ++it;
+    }
+}
+
+int ItemChangeFilter::trackedItemCount() const
+{
+    return m_states.size();
+}
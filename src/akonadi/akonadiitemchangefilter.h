@@ -0,0 +1,70 @@
+/* This file is part of Zanshin
+
+   Copyright 2016 Kevin Ottens <ervin@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+#ifndef AKONADI_ITEMCHANGEFILTER_H
+#define AKONADI_ITEMCHANGEFILTER_H
+
+#include <QHash>
+#include <QSet>
+
+#include <AkonadiCore/Collection>
+#include <AkonadiCore/Item>
+
+namespace Akonadi {
+
+// Sorts the item change notifications coming from the server, it
+// remembers the last revision seen for each item to spot duplicates
+class ItemChangeFilter
+{
+public:
+    enum ChangeKind {
+        // Already seen this revision or a newer one
+        DuplicateChange,
+        // Only touches bookkeeping (flags, attributes, remote id or revision),
+        // the cached items need it but nothing displayed changes
+        MetadataChange,
+        // Touches the payload or the tags
+        RelevantChange
+    };
+
+    ChangeKind itemChanged(const Item &item, const QSet<QByteArray> &parts);
+    void itemMoved(const Item &item);
+    void itemRemoved(const Item &item);
+    void collectionRemoved(const Collection &collection);
+
+    int trackedItemCount() const;
+
+private:
+    struct ItemState
+    {
+        int revision;
+        Collection::Id collection;
+    };
+
+    QHash<Item::Id, ItemState> m_states;
+};
+
+}
+
+#endif // AKONADI_ITEMCHANGEFILTER_H
@@ -42,3 +42,14 @@ KJob *ItemFetchJobInterface::kjob()
     Q_ASSERT(job);
     return job;
 }
+
+void ItemFetchJobInterface::setItemsReceivedFunction(const ItemsReceivedFunction &function)
+{
+    auto job = kjob();
+    QObject::connect(job, &KJob::result, job, [this, function] (KJob *job) {
+        if (job->error() != KJob::NoError)
+            return;
+
+        function(items());
+    });
+}
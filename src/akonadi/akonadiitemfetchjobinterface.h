@@ -24,6 +24,8 @@
 #ifndef AKONADI_ITEMFETCHJOBINTERFACE_H
 #define AKONADI_ITEMFETCHJOBINTERFACE_H
 
+#include <functional>
+
 #include <AkonadiCore/Collection>
 #include <AkonadiCore/Item>
 
@@ -34,6 +36,8 @@ namespace Akonadi {
 class ItemFetchJobInterface
 {
 public:
+    typedef std::function<void(const Item::List &)> ItemsReceivedFunction;
+
     ItemFetchJobInterface();
     virtual ~ItemFetchJobInterface();
 
@@ -41,6 +45,10 @@ public:
 
     virtual Item::List items() const = 0;
     virtual void setCollection(const Akonadi::Collection &collection) = 0;
+
+    // Called with batches of items as they arrive, jobs which can't stream
+    // call it only once with all their items when they succeed
+    virtual void setItemsReceivedFunction(const ItemsReceivedFunction &function);
 };
 
 }
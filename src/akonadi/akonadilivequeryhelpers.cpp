@@ -28,10 +28,39 @@
 #include "akonadi/akonadiitemfetchjobinterface.h"
 #include "akonadi/akonaditagfetchjobinterface.h"
 
-#include "utils/jobhandler.h"
+#include "utils/future.h"
+
+#include <QQueue>
+#include <QSet>
+#include <QSharedPointer>
 
 using namespace Akonadi;
 
+namespace {
+    // Upper bound on the item fetches running at the same time, enough to hide
+    // the round-trips without flooding the server when there are many collections
+    const int MaxConcurrentItemFetches = 4;
+
+    typedef QSharedPointer<QQueue<Collection>> CollectionQueue;
+
+    void fetchNextCollectionItems(const StorageInterface::Ptr &storage,
+                                  const CollectionQueue &pending,
+                                  const Domain::LiveQueryInput<Item>::AddFunction &add)
+    {
+        if (pending->isEmpty())
+            return;
+
+        auto job = storage->fetchItems(pending->dequeue());
+        job->setItemsReceivedFunction([add] (const Item::List &items) {
+            foreach (const auto &item, items)
+                add(item);
+        });
+        Utils::fromJob(job->kjob()).onFinished([storage, pending, add] {
+            fetchNextCollectionItems(storage, pending, add);
+        });
+    }
+}
+
 LiveQueryHelpers::LiveQueryHelpers(const SerializerInterface::Ptr &serializer,
                                    const StorageInterface::Ptr &storage)
     : m_serializer(serializer),
@@ -44,13 +73,11 @@ LiveQueryHelpers::CollectionFetchFunction LiveQueryHelpers::fetchAllCollections(
     auto storage = m_storage;
     return [storage, contentTypes] (const Domain::LiveQueryInput<Collection>::AddFunction &add) {
         auto job = storage->fetchCollections(Collection::root(), StorageInterface::Recursive, contentTypes);
-        Utils::JobHandler::install(job->kjob(), [job, add] {
-            if (job->kjob()->error())
-                return;
-
-            foreach (const auto &collection, job->collections())
-                add(collection);
-        });
+        Utils::fromJob(job->kjob(), [job] { return job->collections(); })
+            .then([add] (const Collection::List &collections) {
+                foreach (const auto &collection, collections)
+                    add(collection);
+            });
     };
 }
 
@@ -59,22 +86,20 @@ LiveQueryHelpers::CollectionFetchFunction LiveQueryHelpers::fetchCollections(con
     auto storage = m_storage;
     return [storage, contentTypes, root] (const Domain::LiveQueryInput<Collection>::AddFunction &add) {
         auto job = storage->fetchCollections(root, StorageInterface::Recursive, contentTypes);
-        Utils::JobHandler::install(job->kjob(), [root, job, add] {
-            if (job->kjob()->error())
-                return;
-
-            auto directChildren = QHash<Collection::Id, Collection>();
-            foreach (const auto &collection, job->collections()) {
-                auto directChild = collection;
-                while (directChild.parentCollection() != root)
-                    directChild = directChild.parentCollection();
-                if (!directChildren.contains(directChild.id()))
-                    directChildren[directChild.id()] = directChild;
-            }
-
-            foreach (const auto &directChild, directChildren)
-                add(directChild);
-        });
+        Utils::fromJob(job->kjob(), [job] { return job->collections(); })
+            .then([root, add] (const Collection::List &collections) {
+                auto directChildren = QHash<Collection::Id, Collection>();
+                foreach (const auto &collection, collections) {
+                    auto directChild = collection;
+                    while (directChild.parentCollection() != root)
+                        directChild = directChild.parentCollection();
+                    if (!directChildren.contains(directChild.id()))
+                        directChildren[directChild.id()] = directChild;
+                }
+
+                foreach (const auto &directChild, directChildren)
+                    add(directChild);
+            });
     };
 }
 
@@ -86,53 +111,70 @@ LiveQueryHelpers::ItemFetchFunction LiveQueryHelpers::fetchItems(StorageInterfac
         auto job = storage->fetchCollections(Akonadi::Collection::root(),
                                              StorageInterface::Recursive,
                                              contentTypes);
-        Utils::JobHandler::install(job->kjob(), [serializer, storage, job, add] {
-            if (job->kjob()->error() != KJob::NoError)
-                return;
-
-            foreach (const auto &collection, job->collections()) {
-                if (!serializer->isSelectedCollection(collection))
-                    continue;
-
-                auto job = storage->fetchItems(collection);
-                Utils::JobHandler::install(job->kjob(), [job, add] {
-                    if (job->kjob()->error() != KJob::NoError)
-                        return;
-
-                    foreach (const auto &item, job->items())
-                        add(item);
-                });
-            }
-        });
+        Utils::fromJob(job->kjob(), [job] { return job->collections(); })
+            .then([serializer, storage, add] (const Collection::List &collections) {
+                auto pending = CollectionQueue::create();
+                foreach (const auto &collection, collections) {
+                    if (serializer->isSelectedCollection(collection))
+                        pending->enqueue(collection);
+                }
+
+                const int fetchCount = qMin(pending->size(), MaxConcurrentItemFetches);
+                for (int i = 0; i < fetchCount; i++)
+                    fetchNextCollectionItems(storage, pending, add);
+            });
     };
 }
 
 LiveQueryHelpers::ItemFetchFunction LiveQueryHelpers::fetchItems(const Tag &tag) const
 {
-    // TODO: Qt5, use the proper implementation once we got a working akonadi
-#if 0
+    auto serializer = m_serializer;
     auto storage = m_storage;
-    return [storage, tag] (const Domain::LiveQueryInput<Item>::AddFunction &add) {
-        auto job = storage->fetchTagItems(tag);
-        Utils::JobHandler::install(job->kjob(), [job, add] {
-            if (job->kjob()->error() != KJob::NoError)
+    auto fetchAllItems = fetchItems(StorageInterface::Tasks | StorageInterface::Notes);
+
+    return [serializer, storage, tag, fetchAllItems] (const Domain::LiveQueryInput<Item>::AddFunction &add) {
+        // Only the items of the selected collections are wanted, knowing
+        // them is cheap since the collections are cached
+        auto job = storage->fetchCollections(Akonadi::Collection::root(),
+                                             StorageInterface::Recursive,
+                                             StorageInterface::Tasks | StorageInterface::Notes);
+        auto items = Utils::fromJob(job->kjob(), [job] { return job->collections(); })
+            .then([serializer, storage, tag] (const Collection::List &collections) {
+                auto selectedIds = QSet<Collection::Id>();
+                foreach (const auto &collection, collections) {
+                    if (serializer->isSelectedCollection(collection))
+                        selectedIds.insert(collection.id());
+                }
+
+                auto job = storage->fetchTagItems(tag);
+                return Utils::fromJob(job->kjob(), [job, selectedIds] {
+                    auto items = Item::List();
+                    foreach (const auto &item, job->items()) {
+                        if (selectedIds.contains(item.parentCollection().id()))
+                            items << item;
+                    }
+                    return items;
+                });
+            });
+
+        items.onFinished([items, tag, add, fetchAllItems] {
+            if (items.isCanceled())
                 return;
 
-            foreach (const auto &item, job->items())
-                add(item);
-        });
-    };
-#else
-    auto fetchFunction = fetchItems(StorageInterface::Tasks | StorageInterface::Notes);
+            // Don't leave the page empty if the server can't tell about the
+            // tag, go through all the items and filter them instead
+            if (items.error() != KJob::NoError) {
+                fetchAllItems([tag, add] (const Item &item) {
+                    if (item.tags().contains(tag))
+                        add(item);
+                });
+                return;
+            }
 
-    return [tag, fetchFunction] (const Domain::LiveQueryInput<Item>::AddFunction &add) {
-        auto filterAdd = [tag, add] (const Item &item) {
-            if (item.tags().contains(tag))
+            foreach (const auto &item, items.result())
                 add(item);
-        };
-        fetchFunction(filterAdd);
+        });
     };
-#endif
 }
 
 LiveQueryHelpers::ItemFetchFunction LiveQueryHelpers::fetchSiblings(const Item &item) const
@@ -140,22 +182,18 @@ LiveQueryHelpers::ItemFetchFunction LiveQueryHelpers::fetchSiblings(const Item &
     auto storage = m_storage;
     return [storage, item] (const Domain::LiveQueryInput<Item>::AddFunction &add) {
         auto job = storage->fetchItem(item);
-        Utils::JobHandler::install(job->kjob(), [storage, job, add] {
-            if (job->kjob()->error() != KJob::NoError)
-                return;
-
-            Q_ASSERT(job->items().size() == 1);
-            auto item = job->items().at(0);
-            Q_ASSERT(item.parentCollection().isValid());
-            auto job = storage->fetchItems(item.parentCollection());
-            Utils::JobHandler::install(job->kjob(), [job, add] {
-                if (job->kjob()->error() != KJob::NoError)
-                    return;
-
-                foreach (const auto &item, job->items())
+        Utils::fromJob(job->kjob(), [job] { return job->items(); })
+            .then([storage] (const Item::List &items) {
+                Q_ASSERT(items.size() == 1);
+                auto item = items.at(0);
+                Q_ASSERT(item.parentCollection().isValid());
+                auto job = storage->fetchItems(item.parentCollection());
+                return Utils::fromJob(job->kjob(), [job] { return job->items(); });
+            })
+            .then([add] (const Item::List &items) {
+                foreach (const auto &item, items)
                     add(item);
             });
-        });
     };
 }
 
@@ -164,9 +202,10 @@ LiveQueryHelpers::TagFetchFunction LiveQueryHelpers::fetchTags() const
     auto storage = m_storage;
     return [storage] (const Domain::LiveQueryInput<Tag>::AddFunction &add) {
         auto job = storage->fetchTags();
-        Utils::JobHandler::install(job->kjob(), [job, add] {
-            foreach (const auto &tag, job->tags())
-                add(tag);
-        });
+        Utils::fromJob(job->kjob(), [job] { return job->tags(); })
+            .then([add] (const Tag::List &tags) {
+                foreach (const auto &tag, tags)
+                    add(tag);
+            });
     };
 }
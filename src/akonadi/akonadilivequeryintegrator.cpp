@@ -24,15 +24,37 @@
 
 #include "akonadilivequeryintegrator.h"
 
+#include <QTimer>
+
 using namespace Akonadi;
 
+namespace {
+    // More item events than that within the window means a resource is syncing
+    // or a calendar got imported, the queries then get bulk updates
+    const int ItemBurstThreshold = 100;
+    const int ItemBurstWindow = 200;
+    // The burst is over when nothing happened during that delay, but we don't
+    // hold the changes back longer than the max duration to keep the views alive
+    const int ItemBurstSettleDelay = 300;
+    const int ItemBurstMaxDuration = 2000;
+}
+
 LiveQueryIntegrator::LiveQueryIntegrator(const SerializerInterface::Ptr &serializer,
                                          const MonitorInterface::Ptr &monitor,
                                          QObject *parent)
     : QObject(parent),
       m_serializer(serializer),
-      m_monitor(monitor)
+      m_monitor(monitor),
+      m_titleCollator(new QCollator),
+      m_itemEventCount(0),
+      m_itemBurstTimer(new QTimer(this))
 {
+    m_titleCollator->setCaseSensitivity(Qt::CaseInsensitive);
+
+    m_itemBurstTimer->setSingleShot(true);
+    m_itemBurstTimer->setInterval(ItemBurstSettleDelay);
+    connect(m_itemBurstTimer, &QTimer::timeout, this, &LiveQueryIntegrator::flushItemBurst);
+
     connect(m_monitor.data(), &MonitorInterface::collectionSelectionChanged,
             this, &LiveQueryIntegrator::onCollectionSelectionChanged);
 
@@ -66,6 +88,8 @@ void LiveQueryIntegrator::addRemoveHandler(const LiveQueryIntegrator::TagRemoveH
 
 void LiveQueryIntegrator::onCollectionSelectionChanged()
 {
+    flushItemBurst();
+
     foreach (const auto &weak, m_itemInputQueries) {
         auto query = weak.toStrongRef();
         if (query)
@@ -75,6 +99,8 @@ void LiveQueryIntegrator::onCollectionSelectionChanged()
 
 void LiveQueryIntegrator::onCollectionAdded(const Collection &collection)
 {
+    flushItemBurst();
+
     foreach (const auto &weak, m_collectionInputQueries) {
         auto query = weak.toStrongRef();
         if (query)
@@ -84,6 +110,8 @@ void LiveQueryIntegrator::onCollectionAdded(const Collection &collection)
 
 void LiveQueryIntegrator::onCollectionRemoved(const Collection &collection)
 {
+    flushItemBurst();
+
     foreach (const auto &weak, m_collectionInputQueries) {
         auto query = weak.toStrongRef();
         if (query)
@@ -98,6 +126,8 @@ void LiveQueryIntegrator::onCollectionRemoved(const Collection &collection)
 
 void LiveQueryIntegrator::onCollectionChanged(const Collection &collection)
 {
+    flushItemBurst();
+
     foreach (const auto &weak, m_collectionInputQueries) {
         auto query = weak.toStrongRef();
         if (query)
@@ -107,38 +137,33 @@ void LiveQueryIntegrator::onCollectionChanged(const Collection &collection)
 
 void LiveQueryIntegrator::onItemAdded(const Item &item)
 {
-    foreach (const auto &weak, m_itemInputQueries) {
-        auto query = weak.toStrongRef();
-        if (query)
-            query->onAdded(item);
-    }
+    if (bufferItemEvent(ItemAdded, item))
+        return;
+
+    dispatchItemEvent(ItemAdded, item, m_itemInputQueries);
 }
 
 void LiveQueryIntegrator::onItemRemoved(const Item &item)
 {
-    foreach (const auto &weak, m_itemInputQueries) {
-        auto query = weak.toStrongRef();
-        if (query)
-            query->onRemoved(item);
-    }
-
-    foreach (const auto &handler, m_itemRemoveHandlers)
-        handler(item);
+    if (bufferItemEvent(ItemRemoved, item))
+        return;
 
+    dispatchItemEvent(ItemRemoved, item, m_itemInputQueries);
     cleanupQueries();
 }
 
 void LiveQueryIntegrator::onItemChanged(const Item &item)
 {
-    foreach (const auto &weak, m_itemInputQueries) {
-        auto query = weak.toStrongRef();
-        if (query)
-            query->onChanged(item);
-    }
+    if (bufferItemEvent(ItemChanged, item))
+        return;
+
+    dispatchItemEvent(ItemChanged, item, m_itemInputQueries);
 }
 
 void LiveQueryIntegrator::onTagAdded(const Tag &tag)
 {
+    flushItemBurst();
+
     foreach (const auto &weak, m_tagInputQueries) {
         auto query = weak.toStrongRef();
         if (query)
@@ -148,6 +173,8 @@ void LiveQueryIntegrator::onTagAdded(const Tag &tag)
 
 void LiveQueryIntegrator::onTagRemoved(const Tag &tag)
 {
+    flushItemBurst();
+
     foreach (const auto &weak, m_tagInputQueries) {
         auto query = weak.toStrongRef();
         if (query)
@@ -162,6 +189,8 @@ void LiveQueryIntegrator::onTagRemoved(const Tag &tag)
 
 void LiveQueryIntegrator::onTagChanged(const Tag &tag)
 {
+    flushItemBurst();
+
     foreach (const auto &weak, m_tagInputQueries) {
         auto query = weak.toStrongRef();
         if (query)
@@ -169,6 +198,102 @@ void LiveQueryIntegrator::onTagChanged(const Tag &tag)
     }
 }
 
+void LiveQueryIntegrator::flushItemBurst()
+{
+    m_itemBurstTimer->stop();
+    if (m_pendingItemEvents.isEmpty())
+        return;
+
+    const auto events = m_pendingItemEvents;
+    m_pendingItemEvents.clear();
+    // Queries bound after the burst started fetched from a storage which
+    // already had those changes, they must not get them a second time
+    const auto queries = m_itemBurstQueries;
+    m_itemBurstQueries.clear();
+    m_itemEventCount = 0;
+    m_itemEventWindow.invalidate();
+
+    auto strongQueries = Domain::LiveQueryInput<Item>::List();
+    foreach (const auto &weak, queries) {
+        auto query = weak.toStrongRef();
+        if (query) {
+            query->beginBulkUpdate();
+            strongQueries << query;
+        }
+    }
+
+    foreach (const auto &event, events)
+        dispatchItemEvent(event.first, event.second, queries);
+
+    foreach (const auto &query, strongQueries)
+        query->endBulkUpdate();
+
+    cleanupQueries();
+}
+
+bool LiveQueryIntegrator::bufferItemEvent(ItemEvent event, const Item &item)
+{
+    if (m_pendingItemEvents.isEmpty()) {
+        if (!m_itemEventWindow.isValid() || m_itemEventWindow.elapsed() > ItemBurstWindow) {
+            m_itemEventWindow.start();
+            m_itemEventCount = 0;
+        }
+
+        m_itemEventCount++;
+        if (m_itemEventCount <= ItemBurstThreshold)
+            return false;
+
+        m_itemBurstDuration.start();
+        m_itemBurstQueries = m_itemInputQueries;
+    }
+
+    m_pendingItemEvents << qMakePair(event, item);
+
+    if (m_itemBurstDuration.elapsed() >= ItemBurstMaxDuration)
+        flushItemBurst();
+    else
+        m_itemBurstTimer->start();
+
+    return true;
+}
+
+void LiveQueryIntegrator::dispatchItemEvent(ItemEvent event, const Item &item,
+                                            const Domain::LiveQueryInput<Item>::WeakList &queries)
+{
+    // Removals first, an item moving between queries then
+    // always leaves one before entering the other
+    if (event == ItemChanged) {
+        foreach (const auto &weak, queries) {
+            auto query = weak.toStrongRef();
+            if (query)
+                query->onChangedAway(item);
+        }
+    }
+
+    foreach (const auto &weak, queries) {
+        auto query = weak.toStrongRef();
+        if (!query)
+            continue;
+
+        switch (event) {
+        case ItemAdded:
+            query->onAdded(item);
+            break;
+        case ItemRemoved:
+            query->onRemoved(item);
+            break;
+        case ItemChanged:
+            query->onChanged(item);
+            break;
+        }
+    }
+
+    if (event == ItemRemoved) {
+        foreach (const auto &handler, m_itemRemoveHandlers)
+            handler(item);
+    }
+}
+
 void LiveQueryIntegrator::cleanupQueries()
 {
     m_collectionInputQueries.removeAll(Domain::LiveQueryInput<Collection>::WeakPtr());
@@ -24,20 +24,28 @@
 #ifndef AKONADI_LIVEQUERYINTEGRATOR_H
 #define AKONADI_LIVEQUERYINTEGRATOR_H
 
+#include <QCollator>
+#include <QElapsedTimer>
 #include <QObject>
+#include <QPair>
 #include <QSharedPointer>
+#include <QVector>
 
 #include <AkonadiCore/Collection>
 #include <AkonadiCore/Item>
 #include <AkonadiCore/Tag>
 
 #include <functional>
+#include <tuple>
+#include <utility>
 
 #include "akonadi/akonadimonitorinterface.h"
 #include "akonadi/akonadiserializerinterface.h"
 
 #include "domain/livequery.h"
 
+class QTimer;
+
 namespace Akonadi {
 
 class LiveQueryIntegrator : public QObject
@@ -85,6 +93,63 @@ class LiveQueryIntegrator : public QObject
     struct UnaryFunctionTraits<const std::function<Function> &>
         : public UnaryFunctionTraits<Function> {};
 
+    // Steps of the queries created by bind, the types being known there
+    // the calls can be inlined instead of going through std::function
+    template<typename InputType, typename OutputType,
+             typename FetchFunction, typename PredicateFunction,
+             typename... ExtraArgs>
+    struct BoundFunctions
+    {
+        BoundFunctions(LiveQueryIntegrator *integrator,
+                       const FetchFunction &fetch,
+                       const PredicateFunction &predicate,
+                       ExtraArgs... extra)
+            : integrator(integrator),
+              fetch(fetch),
+              predicate(predicate),
+              extra(extra...)
+        {
+        }
+
+        OutputType convert(const InputType &input) const
+        {
+            return convert(input, std::index_sequence_for<ExtraArgs...>());
+        }
+
+        void update(const InputType &input, OutputType &output) const
+        {
+            update(input, output, std::index_sequence_for<ExtraArgs...>());
+        }
+
+        bool represents(const InputType &input, const OutputType &output) const
+        {
+            return integrator->represents<InputType, OutputType>(input, output);
+        }
+
+        template<std::size_t... Indexes>
+        OutputType convert(const InputType &input, std::index_sequence<Indexes...>) const
+        {
+            return integrator->create<InputType, OutputType, ExtraArgs...>(input, std::get<Indexes>(extra)...);
+        }
+
+        template<std::size_t... Indexes>
+        void update(const InputType &input, OutputType &output, std::index_sequence<Indexes...>) const
+        {
+            integrator->update<InputType, OutputType, ExtraArgs...>(input, output, std::get<Indexes>(extra)...);
+        }
+
+        LiveQueryIntegrator *integrator;
+        FetchFunction fetch;
+        PredicateFunction predicate;
+        std::tuple<ExtraArgs...> extra;
+    };
+
+    template<typename T>
+    struct IsArtifact : public std::false_type {};
+
+    template<typename T>
+    struct IsArtifact<QSharedPointer<T>> : public std::is_base_of<Domain::Artifact, T> {};
+
 public:
     typedef QSharedPointer<LiveQueryIntegrator> Ptr;
     typedef std::function<void(const Collection &)> CollectionRemoveHandler;
@@ -97,6 +162,8 @@ public:
 
 
 
+    // Artifacts come out ordered by title, an artifact moving only when its
+    // own title changes, the other outputs follow the fetch order
     template<typename OutputType, typename FetchFunction, typename PredicateFunction, typename... ExtraArgs>
     void bind(const QByteArray &debugName,
               QSharedPointer<Domain::LiveQueryOutput<OutputType>> &output,
@@ -124,16 +191,69 @@ public:
         if (output)
             return;
 
-        using namespace std::placeholders;
+        typedef BoundFunctions<InputType, OutputType, FetchFunction, PredicateFunction, ExtraArgs...> Functions;
+        typedef Domain::LiveQueryImpl<InputType, OutputType, Functions> Query;
+
+        auto query = Query::Ptr::create(Functions(this, fetch, predicate, extra...));
+        query->setDebugName(debugName);
+        sortByTitle<OutputType>(query);
+
+        inputQueries<InputType>() << query;
+        output = query;
+    }
+
+    // Counts the inputs bind would turn into outputs, without creating them
+    template<typename FetchFunction, typename PredicateFunction>
+    void bindCount(const QByteArray &debugName,
+                   QSharedPointer<Domain::LiveCountOutput> &output,
+                   FetchFunction fetch,
+                   PredicateFunction predicate)
+    {
+        typedef UnaryFunctionTraits<PredicateFunction> PredicateTraits;
+        typedef typename std::decay<typename PredicateTraits::ArgType>::type InputType;
+
+        static_assert(std::is_same<typename PredicateTraits::ReturnType, bool>::value,
+                      "Predicate function must return bool");
+
+        if (output)
+            return;
 
-        auto query = Domain::LiveQuery<InputType, OutputType>::Ptr::create();
+        typedef Domain::LiveCount<InputType, qint64> Query;
 
+        auto query = Query::Ptr::create();
         query->setDebugName(debugName);
         query->setFetchFunction(fetch);
         query->setPredicateFunction(predicate);
-        query->setConvertFunction(std::bind(&LiveQueryIntegrator::create<InputType, OutputType, ExtraArgs...>, this, _1, extra...));
-        query->setUpdateFunction(std::bind(&LiveQueryIntegrator::update<InputType, OutputType, ExtraArgs...>, this, _1, _2, extra...));
-        query->setRepresentsFunction(std::bind(&LiveQueryIntegrator::represents<InputType, OutputType>, this, _1, _2));
+        query->setKeyFunction([] (const InputType &input) { return qint64(input.id()); });
+
+        inputQueries<InputType>() << query;
+        output = query;
+    }
+
+    // Same as bindCount for many groups at once, the inputs are fetched
+    // a single time whatever the number of groups asked for
+    template<typename GroupType, typename FetchFunction, typename GroupsFunction>
+    void bindGroupCount(const QByteArray &debugName,
+                        QSharedPointer<Domain::LiveGroupCountOutput<GroupType>> &output,
+                        FetchFunction fetch,
+                        GroupsFunction groups)
+    {
+        typedef UnaryFunctionTraits<GroupsFunction> GroupsTraits;
+        typedef typename std::decay<typename GroupsTraits::ArgType>::type InputType;
+
+        static_assert(std::is_same<typename GroupsTraits::ReturnType, QList<GroupType>>::value,
+                      "Groups function must return a list of groups");
+
+        if (output)
+            return;
+
+        typedef Domain::LiveGroupCount<InputType, qint64, GroupType> Query;
+
+        auto query = Query::Ptr::create();
+        query->setDebugName(debugName);
+        query->setFetchFunction(fetch);
+        query->setGroupsFunction(groups);
+        query->setKeyFunction([] (const InputType &input) { return qint64(input.id()); });
 
         inputQueries<InputType>() << query;
         output = query;
@@ -158,9 +278,37 @@ private slots:
     void onTagRemoved(const Akonadi::Tag &tag);
     void onTagChanged(const Akonadi::Tag &tag);
 
+    void flushItemBurst();
+
 private:
+    enum ItemEvent {
+        ItemAdded,
+        ItemRemoved,
+        ItemChanged
+    };
+
+    bool bufferItemEvent(ItemEvent event, const Item &item);
+    void dispatchItemEvent(ItemEvent event, const Item &item,
+                           const Domain::LiveQueryInput<Item>::WeakList &queries);
+
     void cleanupQueries();
 
+    template<typename OutputType, typename Query>
+    typename std::enable_if<IsArtifact<OutputType>::value>::type
+    sortByTitle(const QSharedPointer<Query> &query)
+    {
+        auto collator = m_titleCollator;
+        query->template setSortKey<QCollatorSortKey>([collator] (const OutputType &output) {
+            return collator->sortKey(output->title());
+        });
+    }
+
+    template<typename OutputType, typename Query>
+    typename std::enable_if<!IsArtifact<OutputType>::value>::type
+    sortByTitle(const QSharedPointer<Query> &/*query*/)
+    {
+    }
+
     template<typename InputType, typename OutputType, typename... ExtraArgs>
     OutputType create(const InputType &input, ExtraArgs... extra);
     template<typename InputType, typename OutputType, typename... ExtraArgs>
@@ -181,6 +329,15 @@ private:
 
     SerializerInterface::Ptr m_serializer;
     MonitorInterface::Ptr m_monitor;
+    QSharedPointer<QCollator> m_titleCollator;
+
+    // Sync storms are buffered and applied as one bulk update per query
+    QElapsedTimer m_itemEventWindow;
+    int m_itemEventCount;
+    QElapsedTimer m_itemBurstDuration;
+    QTimer *m_itemBurstTimer;
+    QVector<QPair<ItemEvent, Item>> m_pendingItemEvents;
+    Domain::LiveQueryInput<Item>::WeakList m_itemBurstQueries;
 };
 
 template<>
@@ -37,12 +37,8 @@
 using namespace Akonadi;
 
 Messaging::Messaging()
-    : m_itip(new ITIPHandler)
+    : m_itip(Q_NULLPTR)
 {
-    m_itip->setShowDialogsOnError(true);
-
-    auto calendar = new ETMCalendar(QStringList() << KCalCore::Todo::todoMimeType());
-    m_itip->setCalendar(CalendarBase::Ptr(calendar));
 }
 
 Messaging::~Messaging()
@@ -75,6 +71,21 @@ void Messaging::sendDelegationMessage(Item item)
 
     if (!email.isEmpty()) {
         todo->setOrganizer(email);
-        m_itip->sendiTIPMessage(KCalCore::iTIPRequest, todo, window);
+        itipHandler()->sendiTIPMessage(KCalCore::iTIPRequest, todo, window);
+    }
+}
+
+ITIPHandler *Messaging::itipHandler()
+{
+    // The calendar loads all the todos in its own entity tree model,
+    // so it is only created once a message actually needs to be sent
+    if (!m_itip) {
+        m_itip = new ITIPHandler;
+        m_itip->setShowDialogsOnError(true);
+
+        auto calendar = new ETMCalendar(QStringList() << KCalCore::Todo::todoMimeType());
+        m_itip->setCalendar(CalendarBase::Ptr(calendar));
     }
+
+    return m_itip;
 }
@@ -39,6 +39,8 @@ public:
     void sendDelegationMessage(Akonadi::Item item) Q_DECL_OVERRIDE;
 
 private:
+    ITIPHandler *itipHandler();
+
     ITIPHandler *m_itip;
 };
 
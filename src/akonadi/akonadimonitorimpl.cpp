@@ -38,8 +38,9 @@
 
 using namespace Akonadi;
 
-MonitorImpl::MonitorImpl()
-    : m_monitor(new Akonadi::Monitor)
+MonitorImpl::MonitorImpl(ItemScope scope)
+    : m_monitor(new Akonadi::Monitor),
+      m_suppressedItemChangeCount(0)
 {
     AttributeFactory::registerAttribute<ApplicationSelectedAttribute>();
     AttributeFactory::registerAttribute<TimestampAttribute>();
@@ -48,7 +49,8 @@ MonitorImpl::MonitorImpl()
     m_monitor->setCollectionMonitored(Akonadi::Collection::root());
 
     m_monitor->setMimeTypeMonitored(KCalCore::Todo::todoMimeType());
-    m_monitor->setMimeTypeMonitored(NoteUtils::noteMimeType());
+    if (scope == FullItemScope)
+        m_monitor->setMimeTypeMonitored(NoteUtils::noteMimeType());
 
     auto collectionScope = m_monitor->collectionFetchScope();
     collectionScope.setContentMimeTypes(m_monitor->mimeTypesMonitored());
@@ -57,22 +59,26 @@ MonitorImpl::MonitorImpl()
     m_monitor->setCollectionFetchScope(collectionScope);
 
     connect(m_monitor, &Akonadi::Monitor::collectionAdded, this, &MonitorImpl::collectionAdded);
-    connect(m_monitor, &Akonadi::Monitor::collectionRemoved, this, &MonitorImpl::collectionRemoved);
+    connect(m_monitor, &Akonadi::Monitor::collectionRemoved, this, &MonitorImpl::onCollectionRemoved);
     connect(m_monitor, static_cast<void(Akonadi::Monitor::*)(const Collection &, const QSet<QByteArray> &)>(&Akonadi::Monitor::collectionChanged),
             this, &MonitorImpl::onCollectionChanged);
 
     auto itemScope = m_monitor->itemFetchScope();
     itemScope.fetchFullPayload();
-    itemScope.fetchAllAttributes();
-    itemScope.setFetchTags(true);
-    itemScope.tagFetchScope().setFetchIdOnly(false);
-    itemScope.setAncestorRetrieval(ItemFetchScope::All);
+    if (scope == FullItemScope) {
+        itemScope.fetchAllAttributes();
+        itemScope.setFetchTags(true);
+        itemScope.tagFetchScope().setFetchIdOnly(false);
+        itemScope.setAncestorRetrieval(ItemFetchScope::All);
+    } else {
+        itemScope.setAncestorRetrieval(ItemFetchScope::Parent);
+    }
     m_monitor->setItemFetchScope(itemScope);
 
     connect(m_monitor, &Akonadi::Monitor::itemAdded, this, &MonitorImpl::itemAdded);
-    connect(m_monitor, &Akonadi::Monitor::itemRemoved, this, &MonitorImpl::itemRemoved);
-    connect(m_monitor, &Akonadi::Monitor::itemChanged, this, &MonitorImpl::itemChanged);
-    connect(m_monitor, &Akonadi::Monitor::itemMoved, this, &MonitorImpl::itemMoved);
+    connect(m_monitor, &Akonadi::Monitor::itemRemoved, this, &MonitorImpl::onItemRemoved);
+    connect(m_monitor, &Akonadi::Monitor::itemChanged, this, &MonitorImpl::onItemChanged);
+    connect(m_monitor, &Akonadi::Monitor::itemMoved, this, &MonitorImpl::onItemMoved);
     connect(m_monitor, &Akonadi::Monitor::itemsTagsChanged, this, &MonitorImpl::onItemsTagsChanged);
 
     connect(m_monitor, &Akonadi::Monitor::tagAdded, this, &MonitorImpl::tagAdded);
@@ -84,6 +90,11 @@ MonitorImpl::~MonitorImpl()
 {
 }
 
+int MonitorImpl::suppressedItemChangeCount() const
+{
+    return m_suppressedItemChangeCount;
+}
+
 void MonitorImpl::onCollectionChanged(const Collection &collection, const QSet<QByteArray> &parts)
 {
     // Will probably need to be expanded and to also fetch the full parent chain before emitting in some cases
@@ -105,6 +116,41 @@ void MonitorImpl::onCollectionChanged(const Collection &collection, const QSet<Q
     }
 }
 
+void MonitorImpl::onItemChanged(const Item &item, const QSet<QByteArray> &parts)
+{
+    switch (m_itemChangeFilter.itemChanged(item, parts)) {
+    case ItemChangeFilter::DuplicateChange:
+        m_suppressedItemChangeCount++;
+        break;
+    case ItemChangeFilter::MetadataChange:
+        // The caches still need the new revision to modify the item later
+        m_suppressedItemChangeCount++;
+        emit itemMetadataChanged(item);
+        break;
+    case ItemChangeFilter::RelevantChange:
+        emit itemChanged(item);
+        break;
+    }
+}
+
+void MonitorImpl::onItemRemoved(const Item &item)
+{
+    m_itemChangeFilter.itemRemoved(item);
+    emit itemRemoved(item);
+}
+
+void MonitorImpl::onItemMoved(const Item &item)
+{
+    m_itemChangeFilter.itemMoved(item);
+    emit itemMoved(item);
+}
+
+void MonitorImpl::onCollectionRemoved(const Collection &collection)
+{
+    m_itemChangeFilter.collectionRemoved(collection);
+    emit collectionRemoved(collection);
+}
+
 void MonitorImpl::onItemsTagsChanged(const Akonadi::Item::List &items, const QSet<Akonadi::Tag> &addedTags, const QSet<Akonadi::Tag> &removedTags)
 {
     // Because itemChanged is not emitted on tag removal, we need to listen to itemsTagsChanged and
@@ -25,6 +25,7 @@
 #define AKONADI_MONITORIMPL_H
 
 #include "akonadimonitorinterface.h"
+#include "akonadiitemchangefilter.h"
 #include <AkonadiCore/Item>
 
 namespace Akonadi {
@@ -35,16 +36,34 @@ class MonitorImpl : public MonitorInterface
 {
     Q_OBJECT
 public:
-    MonitorImpl();
+    // The task scope only monitors todos and only fetches their payload and
+    // parent collection, enough for tools which don't show tags or notes
+    enum ItemScope {
+        FullItemScope,
+        TaskItemScope
+    };
+
+    explicit MonitorImpl(ItemScope scope = FullItemScope);
     virtual ~MonitorImpl();
 
+    // Number of item change notifications which were not forwarded as
+    // itemChanged because they didn't touch anything we use, for diagnostics
+    int suppressedItemChangeCount() const;
+
 private slots:
     void onCollectionChanged(const Akonadi::Collection &collection, const QSet<QByteArray> &parts);
+    void onItemChanged(const Akonadi::Item &item, const QSet<QByteArray> &parts);
+    void onItemRemoved(const Akonadi::Item &item);
+    void onItemMoved(const Akonadi::Item &item);
+    void onCollectionRemoved(const Akonadi::Collection &collection);
     void onItemsTagsChanged(const Akonadi::Item::List &items, const QSet<Akonadi::Tag> &addedTags, const QSet<Akonadi::Tag> &removedTags);
 
 private:
     bool hasSupportedMimeTypes(const Collection &collection);
+
     Akonadi::Monitor *m_monitor;
+    ItemChangeFilter m_itemChangeFilter;
+    int m_suppressedItemChangeCount;
 };
 
 }
@@ -51,6 +51,9 @@ signals:
     void itemAdded(const Akonadi::Item &item);
     void itemRemoved(const Akonadi::Item &item);
     void itemChanged(const Akonadi::Item &items);
+    // Only flags, attributes or remote id/revision changed, nothing
+    // displayed did but the cached items need the new revision
+    void itemMetadataChanged(const Akonadi::Item &item);
     void itemMoved(const Akonadi::Item &item);
 
     void tagAdded(const Akonadi::Tag &tag);
@@ -55,3 +55,14 @@ NoteQueries::NoteResult::Ptr NoteQueries::findInbox() const
     m_integrator->bind("NoteQueries::findInbox", m_findAll, fetch, predicate);
     return m_findAll->result();
 }
+
+Domain::Counter::Ptr NoteQueries::countInbox() const
+{
+    auto fetch = m_helpers->fetchItems(StorageInterface::Notes);
+    auto predicate = [this] (const Item &item) {
+        return m_serializer->isNoteItem(item)
+            && !m_serializer->hasAkonadiTags(item);
+    };
+    m_integrator->bindCount("NoteQueries::countInbox", m_countInbox, fetch, predicate);
+    return m_countInbox->counter();
+}
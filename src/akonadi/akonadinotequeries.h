@@ -41,6 +41,7 @@ public:
     typedef Domain::LiveQueryOutput<Domain::Note::Ptr> NoteQueryOutput;
     typedef Domain::QueryResultProvider<Domain::Note::Ptr> NoteProvider;
     typedef Domain::QueryResult<Domain::Note::Ptr> NoteResult;
+    typedef Domain::LiveCountOutput CountOutput;
 
     NoteQueries(const StorageInterface::Ptr &storage,
                 const SerializerInterface::Ptr &serializer,
@@ -48,6 +49,7 @@ public:
 
     NoteResult::Ptr findAll() const Q_DECL_OVERRIDE;
     NoteResult::Ptr findInbox() const Q_DECL_OVERRIDE;
+    Domain::Counter::Ptr countInbox() const Q_DECL_OVERRIDE;
 
 private:
     SerializerInterface::Ptr m_serializer;
@@ -55,6 +57,7 @@ private:
     LiveQueryIntegrator::Ptr m_integrator;
 
     mutable NoteQueryOutput::Ptr m_findAll;
+    mutable CountOutput::Ptr m_countInbox;
 };
 
 }
@@ -57,3 +57,24 @@ ProjectQueries::TaskResult::Ptr ProjectQueries::findTopLevel(Domain::Project::Pt
     m_integrator->bind("ProjectQueries::findTopLevel", query, fetch, predicate);
     return query->result();
 }
+
+Domain::Counter::Ptr ProjectQueries::countTopLevel(Domain::Project::Ptr project) const
+{
+    // All the projects are counted out of a single fetch, the tasks
+    // being grouped by their collection and the uid of their parent
+    auto fetch = m_helpers->fetchItems(StorageInterface::Tasks);
+    auto groups = [this] (const Akonadi::Item &item) -> QList<CountGroup> {
+        const auto relatedUid = m_serializer->relatedUidFromItem(item);
+        if (relatedUid.isEmpty())
+            return QList<CountGroup>();
+        return QList<CountGroup>() << CountGroup(item.parentCollection().id(), relatedUid);
+    };
+    m_integrator->bindGroupCount("ProjectQueries::countTopLevel", m_countTopLevel, fetch, groups);
+
+    const auto todoUid = project->property("todoUid").toString();
+    if (todoUid.isEmpty())
+        return Domain::Counter::Ptr::create();
+
+    const auto item = m_serializer->createItemFromProject(project);
+    return m_countTopLevel->counter(CountGroup(item.parentCollection().id(), todoUid));
+}
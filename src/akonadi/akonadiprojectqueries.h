@@ -45,12 +45,18 @@ public:
     typedef Domain::QueryResultProvider<Domain::Task::Ptr> TaskProvider;
     typedef Domain::QueryResult<Domain::Task::Ptr> TaskResult;
 
+    // Tasks are counted by collection and parent uid, like findTopLevel
+    // only looks at the collection of the project
+    typedef QPair<Akonadi::Collection::Id, QString> CountGroup;
+    typedef Domain::LiveGroupCountOutput<CountGroup> CountOutput;
+
     ProjectQueries(const StorageInterface::Ptr &storage,
                    const SerializerInterface::Ptr &serializer,
                    const MonitorInterface::Ptr &monitor);
 
     ProjectResult::Ptr findAll() const Q_DECL_OVERRIDE;
     TaskResult::Ptr findTopLevel(Domain::Project::Ptr project) const Q_DECL_OVERRIDE;
+    Domain::Counter::Ptr countTopLevel(Domain::Project::Ptr project) const Q_DECL_OVERRIDE;
 
 private:
     SerializerInterface::Ptr m_serializer;
@@ -59,6 +65,7 @@ private:
 
     mutable ProjectQueryOutput::Ptr m_findAll;
     mutable QHash<Akonadi::Item::Id, TaskQueryOutput::Ptr> m_findTopLevel;
+    mutable CountOutput::Ptr m_countTopLevel;
 };
 
 }
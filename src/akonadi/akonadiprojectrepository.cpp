@@ -24,6 +24,9 @@
 
 #include "akonadiprojectrepository.h"
 
+#include <KLocalizedString>
+
+#include "akonadicollectionitemsfetch.h"
 #include "akonadiitemfetchjobinterface.h"
 
 #include "utils/compositejob.h"
@@ -62,11 +65,7 @@ KJob *ProjectRepository::remove(Domain::Project::Ptr project)
 
 KJob *ProjectRepository::associate(Domain::Project::Ptr parent, Domain::Artifact::Ptr child)
 {
-    Item childItem;
-    if (auto task = child.objectCast<Domain::Task>())
-        childItem = m_serializer->createItemFromTask(task);
-    else if (auto note = child.objectCast<Domain::Note>())
-        childItem = m_serializer->createItemFromNote(note);
+    Item childItem = createItemFromArtifact(child);
     Q_ASSERT(childItem.isValid());
 
     auto job = new Utils::CompositeJob();
@@ -119,6 +118,61 @@ KJob *ProjectRepository::associate(Domain::Project::Ptr parent, Domain::Artifact
     return job;
 }
 
+KJob *ProjectRepository::associateArtifacts(Domain::Project::Ptr parent, const Domain::Artifact::List &children)
+{
+    auto partialParentItem = m_serializer->createItemFromProject(parent);
+    auto partialChildItems = Item::List();
+    foreach (const auto &child, children) {
+        const auto childItem = createItemFromArtifact(child);
+        Q_ASSERT(childItem.isValid());
+        partialChildItems << childItem;
+    }
+
+    auto job = new Utils::CompositeJob();
+    installCollectionItemsFetch(m_storage, job, Item::List() << partialParentItem << partialChildItems,
+                                [parent, children, partialParentItem, partialChildItems, job, this] (const CollectionItems &collectionItems) {
+        const auto parentItems = collectionItems.value(partialParentItem.parentCollection().id());
+        const auto parentIndex = parentItems.indexOf(partialParentItem);
+        if (parentIndex < 0) {
+            job->emitError(i18n("Could not find the project '%1'", parent->name()));
+            return;
+        }
+        const auto parentItem = parentItems.at(parentIndex);
+
+        auto childItems = Item::List();
+        for (int i = 0; i < partialChildItems.size(); i++) {
+            const auto &partialChildItem = partialChildItems.at(i);
+            const auto siblings = collectionItems.value(partialChildItem.parentCollection().id());
+            const auto childIndex = siblings.indexOf(partialChildItem);
+            if (childIndex < 0) {
+                job->emitError(i18n("Could not find '%1'", children.at(i)->title()));
+                return;
+            }
+            childItems << siblings.at(childIndex);
+        }
+
+        auto transaction = m_storage->createTransaction();
+        for (int i = 0; i < childItems.size(); i++) {
+            auto childItem = childItems.at(i);
+            m_serializer->updateItemProject(childItem, parent);
+            m_storage->updateItem(childItem, transaction);
+
+            // Tasks follow their project in its collection, with their descendants
+            if (children.at(i).objectCast<Domain::Task>()
+             && childItem.parentCollection().id() != parentItem.parentCollection().id()) {
+                const auto siblings = collectionItems.value(childItem.parentCollection().id());
+                Item::List movedItems = m_serializer->filterDescendantItems(siblings, childItem);
+                movedItems.push_front(childItem);
+                m_storage->moveItems(movedItems, parentItem.parentCollection(), transaction);
+            }
+        }
+        job->addSubjob(transaction);
+        transaction->start();
+    });
+
+    return job;
+}
+
 KJob *ProjectRepository::dissociate(Domain::Artifact::Ptr child)
 {
     auto job = new Utils::CompositeJob();
@@ -147,3 +201,13 @@ KJob *ProjectRepository::dissociate(Domain::Artifact::Ptr child)
 
     return job;
 }
+
+Item ProjectRepository::createItemFromArtifact(const Domain::Artifact::Ptr &artifact) const
+{
+    if (auto task = artifact.objectCast<Domain::Task>())
+        return m_serializer->createItemFromTask(task);
+    else if (auto note = artifact.objectCast<Domain::Note>())
+        return m_serializer->createItemFromNote(note);
+    else
+        return Item();
+}
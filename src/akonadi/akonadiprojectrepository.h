@@ -45,9 +45,12 @@ public:
     KJob *remove(Domain::Project::Ptr project) Q_DECL_OVERRIDE;
 
     KJob *associate(Domain::Project::Ptr parent, Domain::Artifact::Ptr child) Q_DECL_OVERRIDE;
+    KJob *associateArtifacts(Domain::Project::Ptr parent, const Domain::Artifact::List &children) Q_DECL_OVERRIDE;
     KJob *dissociate(Domain::Artifact::Ptr child) Q_DECL_OVERRIDE;
 
 private:
+    Item createItemFromArtifact(const Domain::Artifact::Ptr &artifact) const;
+
     StorageInterface::Ptr m_storage;
     SerializerInterface::Ptr m_serializer;
 };
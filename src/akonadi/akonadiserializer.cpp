@@ -162,6 +162,15 @@ bool Serializer::isTaskItem(Item item)
     return todo->customProperty("Zanshin", "Project").isEmpty();
 }
 
+bool Serializer::isRunningTaskItem(Item item)
+{
+    if (!isTaskItem(item))
+        return false;
+
+    auto todo = item.payload<KCalCore::Todo::Ptr>();
+    return todo->customProperty("Zanshin", "Running") == QLatin1String("1");
+}
+
 Domain::Task::Ptr Serializer::createTaskFromItem(Item item)
 {
     if (!isTaskItem(item))
@@ -264,6 +273,16 @@ Akonadi::Item Serializer::createItemFromTask(Domain::Task::Ptr task)
     return item;
 }
 
+QString Serializer::itemUid(Akonadi::Item item)
+{
+    if (isTaskItem(item)) {
+        const auto todo = item.payload<KCalCore::Todo::Ptr>();
+        return todo->uid();
+    } else {
+        return QString();
+    }
+}
+
 QString Serializer::relatedUidFromItem(Akonadi::Item item)
 {
     if (isTaskItem(item)) {
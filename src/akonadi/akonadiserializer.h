@@ -52,10 +52,12 @@ public:
     virtual bool isTaskCollection(Akonadi::Collection collection) Q_DECL_OVERRIDE;
 
     bool isTaskItem(Akonadi::Item item) Q_DECL_OVERRIDE;
+    bool isRunningTaskItem(Akonadi::Item item) Q_DECL_OVERRIDE;
     Domain::Task::Ptr createTaskFromItem(Akonadi::Item item) Q_DECL_OVERRIDE;
     void updateTaskFromItem(Domain::Task::Ptr task, Akonadi::Item item) Q_DECL_OVERRIDE;
     Akonadi::Item createItemFromTask(Domain::Task::Ptr task) Q_DECL_OVERRIDE;
     bool isTaskChild(Domain::Task::Ptr task, Akonadi::Item item) Q_DECL_OVERRIDE;
+    QString itemUid(Akonadi::Item item) Q_DECL_OVERRIDE;
     QString relatedUidFromItem(Akonadi::Item item) Q_DECL_OVERRIDE;
     void updateItemParent(Akonadi::Item item, Domain::Task::Ptr parent) Q_DECL_OVERRIDE;
     void updateItemProject(Akonadi::Item item, Domain::Project::Ptr project) Q_DECL_OVERRIDE;
@@ -67,11 +67,13 @@ public:
     virtual bool isTaskCollection(Akonadi::Collection collection) = 0;
 
     virtual bool isTaskItem(Akonadi::Item item) = 0;
+    virtual bool isRunningTaskItem(Akonadi::Item item) = 0;
     virtual Domain::Task::Ptr createTaskFromItem(Akonadi::Item item) = 0;
     virtual void updateTaskFromItem(Domain::Task::Ptr task, Akonadi::Item item) = 0;
     virtual Akonadi::Item createItemFromTask(Domain::Task::Ptr task) = 0;
 
     virtual bool isTaskChild(Domain::Task::Ptr task, Akonadi::Item item) = 0;
+    virtual QString itemUid(Akonadi::Item item) = 0;
     virtual QString relatedUidFromItem(Akonadi::Item item) = 0;
     virtual void updateItemParent(Akonadi::Item item, Domain::Task::Ptr parent) = 0;
     virtual void updateItemProject(Akonadi::Item item, Domain::Project::Ptr project) = 0;
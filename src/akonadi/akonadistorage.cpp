@@ -135,6 +135,13 @@ public:
     {
         ItemFetchJob::setCollection(collection);
     }
+
+    void setItemsReceivedFunction(const ItemsReceivedFunction &function) Q_DECL_OVERRIDE
+    {
+        // Keep the items around for items() while also emitting them in batches
+        setDeliveryOption(ItemGetter | EmitItemsInBatches);
+        connect(this, &ItemFetchJob::itemsReceived, this, function);
+    }
 };
 
 class TagJob : public TagFetchJob, public TagFetchJobInterface
@@ -23,14 +23,45 @@
 
 #include "akonadistoragesettings.h"
 
+#include <QCoreApplication>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QStandardPaths>
+#include <QTimer>
+
 #include <KConfig>
 #include <KConfigGroup>
 
 using namespace Akonadi;
 
+static const char *defaultNoteCollectionKey = "defaultNoteCollection";
+static const char *defaultTaskCollectionKey = "defaultCollection";
+
 StorageSettings::StorageSettings()
-    : QObject()
+    : QObject(),
+      m_config(KSharedConfig::openConfig()),
+      m_syncTimer(new QTimer(this)),
+      m_watcher(new QFileSystemWatcher(this))
+{
+    m_defaultNoteCollection = readCollection(defaultNoteCollectionKey);
+    m_defaultTaskCollection = readCollection(defaultTaskCollectionKey);
+
+    // Several settings changed in a row only lead to one write on disk
+    m_syncTimer->setSingleShot(true);
+    m_syncTimer->setInterval(500);
+    connect(m_syncTimer, &QTimer::timeout, this, &StorageSettings::syncConfiguration);
+
+    connect(m_watcher, &QFileSystemWatcher::fileChanged, this, &StorageSettings::reloadConfiguration);
+    watchConfigFile();
+
+    if (QCoreApplication::instance())
+        connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, &StorageSettings::syncConfiguration);
+}
+
+StorageSettings::~StorageSettings()
 {
+    if (m_syncTimer->isActive())
+        m_config->sync();
 }
 
 StorageSettings &StorageSettings::instance()
@@ -41,36 +72,85 @@ StorageSettings &StorageSettings::instance()
 
 Collection StorageSettings::defaultNoteCollection()
 {
-    KConfigGroup config(KSharedConfig::openConfig(), "General");
-    Collection::Id id = config.readEntry("defaultNoteCollection", -1);
-    return Collection(id);
+    return m_defaultNoteCollection;
 }
 
 Collection StorageSettings::defaultTaskCollection()
 {
-    KConfigGroup config(KSharedConfig::openConfig(), "General");
-    Collection::Id id = config.readEntry("defaultCollection", -1);
-    return Collection(id);
+    return m_defaultTaskCollection;
 }
 
 void StorageSettings::setDefaultNoteCollection(const Collection &collection)
 {
-    if (defaultNoteCollection() == collection)
+    if (m_defaultNoteCollection == collection)
         return;
 
-    KConfigGroup config(KSharedConfig::openConfig(), "General");
-    config.writeEntry("defaultNoteCollection", QString::number(collection.id()));
-    config.sync();
+    m_defaultNoteCollection = collection;
+    KConfigGroup config(m_config, "General");
+    config.writeEntry(defaultNoteCollectionKey, QString::number(collection.id()));
+    scheduleSync();
     emit defaultNoteCollectionChanged(collection);
 }
 
 void StorageSettings::setDefaultTaskCollection(const Collection &collection)
 {
-    if (defaultTaskCollection() == collection)
+    if (m_defaultTaskCollection == collection)
         return;
 
-    KConfigGroup config(KSharedConfig::openConfig(), "General");
-    config.writeEntry("defaultCollection", QString::number(collection.id()));
-    config.sync();
+    m_defaultTaskCollection = collection;
+    KConfigGroup config(m_config, "General");
+    config.writeEntry(defaultTaskCollectionKey, QString::number(collection.id()));
+    scheduleSync();
     emit defaultTaskCollectionChanged(collection);
 }
+
+void StorageSettings::reloadConfiguration()
+{
+    // Pending changes get written first by KConfig, so they're not lost
+    m_syncTimer->stop();
+    m_config->reparseConfiguration();
+    watchConfigFile();
+
+    const auto noteCollection = readCollection(defaultNoteCollectionKey);
+    if (noteCollection != m_defaultNoteCollection) {
+        m_defaultNoteCollection = noteCollection;
+        emit defaultNoteCollectionChanged(noteCollection);
+    }
+
+    const auto taskCollection = readCollection(defaultTaskCollectionKey);
+    if (taskCollection != m_defaultTaskCollection) {
+        m_defaultTaskCollection = taskCollection;
+        emit defaultTaskCollectionChanged(taskCollection);
+    }
+}
+
+void StorageSettings::syncConfiguration()
+{
+    m_syncTimer->stop();
+    m_config->sync();
+    // The file might have been created or replaced by the write
+    watchConfigFile();
+}
+
+Collection StorageSettings::readCollection(const char *key) const
+{
+    KConfigGroup config(m_config, "General");
+    Collection::Id id = config.readEntry(key, -1);
+    return Collection(id);
+}
+
+void StorageSettings::scheduleSync()
+{
+    if (!m_syncTimer->isActive())
+        m_syncTimer->start();
+}
+
+void StorageSettings::watchConfigFile()
+{
+    const auto name = m_config->name();
+    const auto path = QFileInfo(name).isAbsolute() ? name
+                    : QStandardPaths::writableLocation(QStandardPaths::GenericConfigLocation) + '/' + name;
+
+    if (!m_watcher->files().contains(path) && QFileInfo::exists(path))
+        m_watcher->addPath(path);
+}
@@ -27,6 +27,11 @@
 
 #include <AkonadiCore/Collection>
 
+#include <KSharedConfig>
+
+class QFileSystemWatcher;
+class QTimer;
+
 namespace Akonadi
 {
 
@@ -35,6 +40,7 @@ class StorageSettings : public QObject
     Q_OBJECT
 private:
     StorageSettings();
+    ~StorageSettings();
 
 public:
     static StorageSettings &instance();
@@ -46,9 +52,27 @@ public slots:
     void setDefaultNoteCollection(const Akonadi::Collection &collection);
     void setDefaultTaskCollection(const Akonadi::Collection &collection);
 
+    // Reparses the configuration, emitting the change signals as needed,
+    // this is done automatically when the file is modified behind our back
+    void reloadConfiguration();
+    // Writes pending changes to disk right away instead of waiting
+    // for the coalesced write
+    void syncConfiguration();
+
 signals:
     void defaultNoteCollectionChanged(const Akonadi::Collection &collection);
     void defaultTaskCollectionChanged(const Akonadi::Collection &collection);
+
+private:
+    Akonadi::Collection readCollection(const char *key) const;
+    void scheduleSync();
+    void watchConfigFile();
+
+    KSharedConfig::Ptr m_config;
+    Akonadi::Collection m_defaultNoteCollection;
+    Akonadi::Collection m_defaultTaskCollection;
+    QTimer *m_syncTimer;
+    QFileSystemWatcher *m_watcher;
 };
 
 }
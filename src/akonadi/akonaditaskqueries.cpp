@@ -25,8 +25,7 @@
 #include "akonaditaskqueries.h"
 
 #include "utils/datetime.h"
-
-#include <QTimer>
+#include "utils/daychangenotifier.h"
 
 using namespace Akonadi;
 
@@ -36,26 +35,17 @@ TaskQueries::TaskQueries(const StorageInterface::Ptr &storage,
     : m_serializer(serializer),
       m_helpers(new LiveQueryHelpers(serializer, storage)),
       m_integrator(new LiveQueryIntegrator(serializer, monitor)),
-      m_workdayPollTimer(new QTimer(this))
+      m_dayChangeNotifier(new Utils::DayChangeNotifier(this)),
+      m_today(m_dayChangeNotifier->currentDate())
 {
-    m_workdayPollTimer->setInterval(30000);
-    connect(m_workdayPollTimer, &QTimer::timeout, this, &TaskQueries::onWorkdayPollTimeout);
+    connect(m_dayChangeNotifier, &Utils::DayChangeNotifier::dayChanged, this, &TaskQueries::onDayChanged);
 
     m_integrator->addRemoveHandler([this] (const Item &item) {
         m_findChildren.remove(item.id());
+        m_workdayItems.remove(item.id());
     });
 }
 
-int TaskQueries::workdayPollInterval() const
-{
-    return m_workdayPollTimer->interval();
-}
-
-void TaskQueries::setWorkdayPollInterval(int interval)
-{
-    m_workdayPollTimer->setInterval(interval);
-}
-
 TaskQueries::TaskResult::Ptr TaskQueries::findAll() const
 {
     auto fetch = m_helpers->fetchItems(StorageInterface::Tasks);
@@ -92,10 +82,7 @@ TaskQueries::TaskResult::Ptr TaskQueries::findInboxTopLevel() const
 {
     auto fetch = m_helpers->fetchItems(StorageInterface::Tasks);
     auto predicate = [this] (const Akonadi::Item &item) {
-        const bool excluded = !m_serializer->isTaskItem(item)
-                           || !m_serializer->relatedUidFromItem(item).isEmpty();
-
-        return !excluded;
+        return isInboxTopLevelItem(item);
     };
     m_integrator->bind("TaskQueries::findInboxTopLevel", m_findInboxTopLevel, fetch, predicate);
     return m_findInboxTopLevel->result();
@@ -103,36 +90,26 @@ TaskQueries::TaskResult::Ptr TaskQueries::findInboxTopLevel() const
 
 TaskQueries::TaskResult::Ptr TaskQueries::findWorkdayTopLevel() const
 {
-    if (!m_findWorkdayTopLevel) {
-        m_workdayPollTimer->start();
-        m_today = Utils::DateTime::currentDateTime().date();
-    }
-
     auto fetch = m_helpers->fetchItems(StorageInterface::Tasks);
     auto predicate = [this] (const Akonadi::Item &item) {
-        if (!m_serializer->isTaskItem(item))
-            return false;
-
-        const Domain::Task::Ptr task = m_serializer->createTaskFromItem(item);
-
-        const QDate doneDate = task->doneDate().date();
-        const QDate startDate = task->startDate().date();
-        const QDate dueDate = task->dueDate().date();
-        const QDate today = Utils::DateTime::currentDateTime().date();
-
-        const bool pastStartDate = startDate.isValid() && startDate <= today;
-        const bool pastDueDate = dueDate.isValid() && dueDate <= today;
-        const bool todayDoneDate = doneDate == today;
-
-        if (task->isDone())
-            return todayDoneDate;
-        else
-            return pastStartDate || pastDueDate;
+        return isWorkdayTopLevelItem(item);
     };
     m_integrator->bind("TaskQueries::findWorkdayTopLevel", m_findWorkdayTopLevel, fetch, predicate);
     return m_findWorkdayTopLevel->result();
 }
 
+TaskQueries::TaskResult::Ptr TaskQueries::findRunning() const
+{
+    // Only checks the payload, no task gets created for the items which
+    // aren't running so the query only ever holds the running ones
+    auto fetch = m_helpers->fetchItems(StorageInterface::Tasks);
+    auto predicate = [this] (const Akonadi::Item &item) {
+        return m_serializer->isRunningTaskItem(item);
+    };
+    m_integrator->bind("TaskQueries::findRunning", m_findRunning, fetch, predicate);
+    return m_findRunning->result();
+}
+
 TaskQueries::ContextResult::Ptr TaskQueries::findContexts(Domain::Task::Ptr task) const
 {
     qFatal("Not implemented yet");
@@ -140,11 +117,140 @@ TaskQueries::ContextResult::Ptr TaskQueries::findContexts(Domain::Task::Ptr task
     return ContextResult::Ptr();
 }
 
-void TaskQueries::onWorkdayPollTimeout()
+Domain::Counter::Ptr TaskQueries::countInboxTopLevel() const
 {
-    auto newDate = Utils::DateTime::currentDateTime().date();
-    if (m_findWorkdayTopLevel && m_today != newDate) {
-        m_today = newDate;
-        m_findWorkdayTopLevel->reset();
+    auto fetch = m_helpers->fetchItems(StorageInterface::Tasks);
+    auto predicate = [this] (const Akonadi::Item &item) {
+        return isInboxTopLevelItem(item);
+    };
+    m_integrator->bindCount("TaskQueries::countInboxTopLevel", m_countInboxTopLevel, fetch, predicate);
+    return m_countInboxTopLevel->counter();
+}
+
+Domain::Counter::Ptr TaskQueries::countWorkdayTopLevel() const
+{
+    auto fetch = m_helpers->fetchItems(StorageInterface::Tasks);
+    auto predicate = [this] (const Akonadi::Item &item) {
+        return isWorkdayTopLevelItem(item);
+    };
+    m_integrator->bindCount("TaskQueries::countWorkdayTopLevel", m_countWorkdayTopLevel, fetch, predicate);
+    return m_countWorkdayTopLevel->counter();
+}
+
+bool TaskQueries::isInboxTopLevelItem(const Akonadi::Item &item) const
+{
+    const bool excluded = !m_serializer->isTaskItem(item)
+                       || !m_serializer->relatedUidFromItem(item).isEmpty();
+
+    return !excluded;
+}
+
+bool TaskQueries::isWorkdayTopLevelItem(const Akonadi::Item &item) const
+{
+    if (!m_serializer->isTaskItem(item)) {
+        m_workdayItems.remove(item.id());
+        return false;
+    }
+
+    const Domain::Task::Ptr task = m_serializer->createTaskFromItem(item);
+    scheduleWorkdayChange(item, nextWorkdayChange(task));
+
+    const QDate doneDate = task->doneDate().date();
+    const QDate startDate = task->startDate().date();
+    const QDate dueDate = task->dueDate().date();
+
+    const bool pastStartDate = startDate.isValid() && startDate <= m_today;
+    const bool pastDueDate = dueDate.isValid() && dueDate <= m_today;
+    const bool todayDoneDate = doneDate == m_today;
+
+    if (task->isDone())
+        return todayDoneDate;
+    else
+        return pastStartDate || pastDueDate;
+}
+
+QDate TaskQueries::nextWorkdayChange(const Domain::Task::Ptr &task) const
+{
+    if (task->isDone()) {
+        const QDate doneDate = task->doneDate().date();
+        if (doneDate == m_today)
+            return m_today.addDays(1);
+        else if (doneDate > m_today)
+            return doneDate;
+        else
+            return QDate();
+    }
+
+    QDate result;
+    for (const auto &date : {task->startDate().date(), task->dueDate().date()}) {
+        if (date.isValid() && date > m_today && (!result.isValid() || date < result))
+            result = date;
+    }
+    return result;
+}
+
+void TaskQueries::scheduleWorkdayChange(const Akonadi::Item &item, const QDate &date) const
+{
+    if (!date.isValid()) {
+        m_workdayItems.remove(item.id());
+        return;
+    }
+
+    const auto previous = m_workdayItems.value(item.id()).first;
+    m_workdayItems.insert(item.id(), qMakePair(date, item));
+    if (previous == date)
+        return;
+
+    m_workdayChanges.push(qMakePair(date, item.id()));
+
+    // Outdated entries are skipped when popped, rebuild the queue
+    // before they pile up for items edited over and over
+    if (m_workdayChanges.size() > size_t(2 * m_workdayItems.size() + 64)) {
+        WorkdayChangeQueue changes;
+        for (auto it = m_workdayItems.constBegin(); it != m_workdayItems.constEnd(); ++it)
+            changes.push(qMakePair(it.value().first, it.key()));
+        m_workdayChanges.swap(changes);
+    }
+}
+
+void TaskQueries::onDayChanged(const QDate &today)
+{
+    const auto previous = m_today;
+    m_today = today;
+
+    if (!m_findWorkdayTopLevel && !m_countWorkdayTopLevel)
+        return;
+
+    // Going back in time, just start over
+    if (today < previous) {
+        m_workdayItems.clear();
+        m_workdayChanges = WorkdayChangeQueue();
+        if (m_findWorkdayTopLevel)
+            m_findWorkdayTopLevel->reset();
+        if (m_countWorkdayTopLevel)
+            m_countWorkdayTopLevel->reset();
+        return;
+    }
+
+    QList<ItemInputQuery::Ptr> inputs;
+    if (m_findWorkdayTopLevel)
+        inputs << m_findWorkdayTopLevel.dynamicCast<ItemInputQuery>();
+    if (m_countWorkdayTopLevel)
+        inputs << m_countWorkdayTopLevel.dynamicCast<ItemInputQuery>();
+    Q_ASSERT(!inputs.contains(ItemInputQuery::Ptr()));
+
+    while (!m_workdayChanges.empty() && m_workdayChanges.top().first <= today) {
+        const auto change = m_workdayChanges.top();
+        m_workdayChanges.pop();
+
+        const auto it = m_workdayItems.constFind(change.second);
+        if (it == m_workdayItems.constEnd() || it.value().first != change.first)
+            continue;
+
+        // Evaluating the predicate again schedules the next change if any
+        const auto item = it.value().second;
+        m_workdayItems.erase(m_workdayItems.find(change.second));
+        foreach (const auto &input, inputs)
+            input->onChanged(item);
     }
 }
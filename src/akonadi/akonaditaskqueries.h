@@ -24,12 +24,17 @@
 #ifndef AKONADI_TASKQUERIES_H
 #define AKONADI_TASKQUERIES_H
 
+#include <functional>
+#include <queue>
+
 #include "domain/taskqueries.h"
 
 #include "akonadi/akonadilivequeryhelpers.h"
 #include "akonadi/akonadilivequeryintegrator.h"
 
-class QTimer;
+namespace Utils {
+class DayChangeNotifier;
+}
 
 namespace Akonadi {
 
@@ -43,6 +48,7 @@ public:
     typedef Domain::LiveQueryOutput<Domain::Task::Ptr> TaskQueryOutput;
     typedef Domain::QueryResultProvider<Domain::Task::Ptr> TaskProvider;
     typedef Domain::QueryResult<Domain::Task::Ptr> TaskResult;
+    typedef Domain::LiveCountOutput CountOutput;
 
     typedef Domain::QueryResultProvider<Domain::Context::Ptr> ContextProvider;
     typedef Domain::QueryResult<Domain::Context::Ptr> ContextResult;
@@ -51,31 +57,46 @@ public:
                 const SerializerInterface::Ptr &serializer,
                 const MonitorInterface::Ptr &monitor);
 
-    int workdayPollInterval() const;
-    void setWorkdayPollInterval(int interval);
-
     TaskResult::Ptr findAll() const Q_DECL_OVERRIDE;
     TaskResult::Ptr findChildren(Domain::Task::Ptr task) const Q_DECL_OVERRIDE;
     TaskResult::Ptr findTopLevel() const Q_DECL_OVERRIDE;
     TaskResult::Ptr findInboxTopLevel() const Q_DECL_OVERRIDE;
     TaskResult::Ptr findWorkdayTopLevel() const Q_DECL_OVERRIDE;
+    TaskResult::Ptr findRunning() const Q_DECL_OVERRIDE;
     ContextResult::Ptr findContexts(Domain::Task::Ptr task) const Q_DECL_OVERRIDE;
+    Domain::Counter::Ptr countInboxTopLevel() const Q_DECL_OVERRIDE;
+    Domain::Counter::Ptr countWorkdayTopLevel() const Q_DECL_OVERRIDE;
 
 private slots:
-    void onWorkdayPollTimeout();
+    void onDayChanged(const QDate &today);
 
 private:
+    bool isInboxTopLevelItem(const Akonadi::Item &item) const;
+    bool isWorkdayTopLevelItem(const Akonadi::Item &item) const;
+    QDate nextWorkdayChange(const Domain::Task::Ptr &task) const;
+    void scheduleWorkdayChange(const Akonadi::Item &item, const QDate &date) const;
+
+    typedef QPair<QDate, Akonadi::Item::Id> WorkdayChange;
+    typedef std::priority_queue<WorkdayChange, std::vector<WorkdayChange>, std::greater<WorkdayChange>> WorkdayChangeQueue;
+
     SerializerInterface::Ptr m_serializer;
     LiveQueryHelpers::Ptr m_helpers;
     LiveQueryIntegrator::Ptr m_integrator;
-    QTimer *m_workdayPollTimer;
-    mutable QDate m_today;
+    Utils::DayChangeNotifier *m_dayChangeNotifier;
+    QDate m_today;
+
+    // Items which will enter or leave the workday on a later date
+    mutable QHash<Akonadi::Item::Id, QPair<QDate, Akonadi::Item>> m_workdayItems;
+    mutable WorkdayChangeQueue m_workdayChanges;
 
     mutable TaskQueryOutput::Ptr m_findAll;
     mutable QHash<Akonadi::Item::Id, TaskQueryOutput::Ptr> m_findChildren;
     mutable TaskQueryOutput::Ptr m_findTopLevel;
     mutable TaskQueryOutput::Ptr m_findInboxTopLevel;
     mutable TaskQueryOutput::Ptr m_findWorkdayTopLevel;
+    mutable TaskQueryOutput::Ptr m_findRunning;
+    mutable CountOutput::Ptr m_countInboxTopLevel;
+    mutable CountOutput::Ptr m_countWorkdayTopLevel;
 };
 
 }
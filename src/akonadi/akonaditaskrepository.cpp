@@ -24,11 +24,17 @@
 
 #include "akonaditaskrepository.h"
 
+#include <functional>
+
+#include <QSet>
+#include <QSharedPointer>
+
 #include <KLocalizedString>
 
 #include <AkonadiCore/Item>
 
 #include "akonadicollectionfetchjobinterface.h"
+#include "akonadicollectionitemsfetch.h"
 #include "akonadiitemfetchjobinterface.h"
 
 #include "utils/compositejob.h"
@@ -38,10 +44,12 @@ using namespace Utils;
 
 TaskRepository::TaskRepository(const StorageInterface::Ptr &storage,
                                const SerializerInterface::Ptr &serializer,
-                               const MessagingInterface::Ptr &messaging)
+                               const MessagingInterface::Ptr &messaging,
+                               const Cache::Ptr &cache)
     : m_storage(storage),
       m_serializer(serializer),
-      m_messaging(messaging)
+      m_messaging(messaging),
+      m_cache(cache)
 {
 }
 
@@ -81,6 +89,41 @@ KJob *TaskRepository::createItem(const Item &item)
     }
 }
 
+Item::List TaskRepository::cachedItemsWithDescendants(const Item::List &items) const
+{
+    // Only usable if the cache knows the full content of all the collections involved,
+    // otherwise an empty list is returned and the caller has to go through the storage
+    if (!m_cache)
+        return Item::List();
+
+    auto removedIds = QSet<Item::Id>();
+    auto result = Item::List();
+
+    foreach (const auto &item, items) {
+        if (!m_cache->isCollectionPopulated(item.parentCollection().id()))
+            return Item::List();
+
+        const auto cachedItem = m_cache->item(item.id());
+        if (!cachedItem.isValid())
+            return Item::List();
+
+        if (removedIds.contains(cachedItem.id()))
+            continue;
+
+        auto childItems = m_cache->descendantItems(cachedItem);
+        childItems << cachedItem;
+
+        foreach (const auto &childItem, childItems) {
+            if (removedIds.contains(childItem.id()))
+                continue;
+            removedIds.insert(childItem.id());
+            result << childItem;
+        }
+    }
+
+    return result;
+}
+
 KJob *TaskRepository::create(Domain::Task::Ptr task)
 {
     auto item = m_serializer->createItemFromTask(task);
@@ -140,6 +183,10 @@ KJob *TaskRepository::remove(Domain::Task::Ptr task)
     auto item = m_serializer->createItemFromTask(task);
     Q_ASSERT(item.isValid());
 
+    const auto cachedItems = cachedItemsWithDescendants(Item::List() << item);
+    if (!cachedItems.isEmpty())
+        return m_storage->removeItems(cachedItems);
+
     auto compositeJob = new CompositeJob();
     ItemFetchJobInterface *fetchItemJob = m_storage->fetchItem(item);
     compositeJob->install(fetchItemJob->kjob(), [fetchItemJob, compositeJob, this] {
@@ -166,6 +213,61 @@ KJob *TaskRepository::remove(Domain::Task::Ptr task)
     return compositeJob;
 }
 
+KJob *TaskRepository::updateTasks(const Domain::Task::List &tasks)
+{
+    auto transaction = m_storage->createTransaction();
+    foreach (const auto &task, tasks) {
+        auto item = m_serializer->createItemFromTask(task);
+        Q_ASSERT(item.isValid());
+        m_storage->updateItem(item, transaction);
+    }
+    return transaction;
+}
+
+KJob *TaskRepository::removeTasks(const Domain::Task::List &tasks)
+{
+    auto items = Item::List();
+    foreach (const auto &task, tasks) {
+        auto item = m_serializer->createItemFromTask(task);
+        Q_ASSERT(item.isValid());
+        items << item;
+    }
+
+    const auto cachedItems = cachedItemsWithDescendants(items);
+    if (!cachedItems.isEmpty())
+        return m_storage->removeItems(cachedItems);
+
+    auto compositeJob = new CompositeJob();
+    installCollectionItemsFetch(m_storage, compositeJob, items, [items, compositeJob, this] (const CollectionItems &collectionItems) {
+        auto removedIds = QSet<Item::Id>();
+        auto removedItems = Item::List();
+
+        foreach (const auto &partialItem, items) {
+            const auto siblings = collectionItems.value(partialItem.parentCollection().id());
+            const auto index = siblings.indexOf(partialItem);
+            if (index < 0 || removedIds.contains(partialItem.id()))
+                continue;
+
+            const auto item = siblings.at(index);
+            Item::List childItems = m_serializer->filterDescendantItems(siblings, item);
+            childItems << item;
+
+            foreach (const auto &childItem, childItems) {
+                if (removedIds.contains(childItem.id()))
+                    continue;
+                removedIds.insert(childItem.id());
+                removedItems << childItem;
+            }
+        }
+
+        auto removeJob = m_storage->removeItems(removedItems);
+        compositeJob->addSubjob(removeJob);
+        removeJob->start();
+    });
+
+    return compositeJob;
+}
+
 KJob *TaskRepository::promoteToProject(Domain::Task::Ptr task)
 {
     auto item = m_serializer->createItemFromTask(task);
@@ -210,11 +312,13 @@ KJob *TaskRepository::associate(Domain::Task::Ptr parent, Domain::Task::Ptr chil
 
             const auto items = fetchParentItemJob->items();
             const auto parentIndex = items.indexOf(partialParentItem);
-            Q_ASSERT(parentIndex >= 0);
+            if (parentIndex < 0) {
+                job->emitError(i18n("Could not find the parent task '%1'", parent->title()));
+                return;
+            }
             const auto parentItem = items.at(parentIndex);
 
-            // TODO Qt5: This is a bit wasteful, add an itemUid on the serializer
-            const auto childUid = m_serializer->objectUid(m_serializer->createTaskFromItem(childItem));
+            const auto childUid = m_serializer->itemUid(childItem);
             auto relatedUid = m_serializer->relatedUidFromItem(parentItem);
             while (!relatedUid.isEmpty()) {
                 if (relatedUid == childUid) {
@@ -226,9 +330,7 @@ KJob *TaskRepository::associate(Domain::Task::Ptr parent, Domain::Task::Ptr chil
 
                 auto it = std::find_if(items.constBegin(), items.constEnd(),
                                        [relatedUid, this] (const Akonadi::Item &item) {
-                    // TODO Qt5: This is a bit wasteful, add an itemUid on the serializer
-                    auto task = m_serializer->createTaskFromItem(item);
-                    return task && m_serializer->objectUid(task) == relatedUid;
+                    return m_serializer->itemUid(item) == relatedUid;
                 });
                 if (it == items.end())
                     break;
@@ -265,6 +367,81 @@ KJob *TaskRepository::associate(Domain::Task::Ptr parent, Domain::Task::Ptr chil
     return job;
 }
 
+KJob *TaskRepository::associateTasks(Domain::Task::Ptr parent, const Domain::Task::List &children)
+{
+    auto partialParentItem = m_serializer->createItemFromTask(parent);
+    auto partialChildItems = Item::List();
+    foreach (const auto &child, children)
+        partialChildItems << m_serializer->createItemFromTask(child);
+
+    auto job = new CompositeJob();
+    installCollectionItemsFetch(m_storage, job, Item::List() << partialParentItem << partialChildItems,
+                                [parent, children, partialParentItem, partialChildItems, job, this] (const CollectionItems &collectionItems) {
+        const auto items = collectionItems.value(partialParentItem.parentCollection().id());
+        const auto parentIndex = items.indexOf(partialParentItem);
+        if (parentIndex < 0) {
+            job->emitError(i18n("Could not find the parent task '%1'", parent->title()));
+            return;
+        }
+        const auto parentItem = items.at(parentIndex);
+
+        // Collect the ancestors of the parent once, none of them can become its child
+        auto ancestorUids = QSet<QString>();
+        auto relatedUid = m_serializer->relatedUidFromItem(parentItem);
+        while (!relatedUid.isEmpty() && !ancestorUids.contains(relatedUid)) {
+            ancestorUids.insert(relatedUid);
+
+            auto it = std::find_if(items.constBegin(), items.constEnd(),
+                                   [relatedUid, this] (const Akonadi::Item &item) {
+                return m_serializer->itemUid(item) == relatedUid;
+            });
+            if (it == items.end())
+                break;
+
+            relatedUid = m_serializer->relatedUidFromItem(*it);
+        }
+
+        auto childItems = Item::List();
+        for (int i = 0; i < partialChildItems.size(); i++) {
+            const auto &partialChildItem = partialChildItems.at(i);
+            const auto siblings = collectionItems.value(partialChildItem.parentCollection().id());
+            const auto childIndex = siblings.indexOf(partialChildItem);
+            if (childIndex < 0) {
+                job->emitError(i18n("Could not find the task '%1'", children.at(i)->title()));
+                return;
+            }
+            const auto childItem = siblings.at(childIndex);
+
+            const auto childUid = m_serializer->itemUid(childItem);
+            if (ancestorUids.contains(childUid)) {
+                job->emitError(i18n("Could not associate '%1', it is an ancestor of '%2'",
+                                    children.at(i)->title(),
+                                    parent->title()));
+                return;
+            }
+
+            childItems << childItem;
+        }
+
+        auto transaction = m_storage->createTransaction();
+        foreach (auto childItem, childItems) {
+            m_serializer->updateItemParent(childItem, parent);
+            m_storage->updateItem(childItem, transaction);
+
+            if (childItem.parentCollection().id() != parentItem.parentCollection().id()) {
+                const auto siblings = collectionItems.value(childItem.parentCollection().id());
+                Item::List movedItems = m_serializer->filterDescendantItems(siblings, childItem);
+                movedItems.push_front(childItem);
+                m_storage->moveItems(movedItems, parentItem.parentCollection(), transaction);
+            }
+        }
+        job->addSubjob(transaction);
+        transaction->start();
+    });
+
+    return job;
+}
+
 KJob *TaskRepository::dissociate(Domain::Task::Ptr child)
 {
     auto job = new CompositeJob();
@@ -29,6 +29,7 @@
 #include <AkonadiCore/Collection>
 #include <AkonadiCore/Item>
 
+#include "akonadi/akonadicache.h"
 #include "akonadi/akonadimessaginginterface.h"
 #include "akonadi/akonadiserializerinterface.h"
 #include "akonadi/akonadistorageinterface.h"
@@ -43,7 +44,8 @@ public:
 
     TaskRepository(const StorageInterface::Ptr &storage,
                    const SerializerInterface::Ptr &serializer,
-                   const MessagingInterface::Ptr &messaging);
+                   const MessagingInterface::Ptr &messaging,
+                   const Cache::Ptr &cache = Cache::Ptr());
 
     virtual KJob *create(Domain::Task::Ptr task) Q_DECL_OVERRIDE;
     virtual KJob *createChild(Domain::Task::Ptr task, Domain::Task::Ptr parent) Q_DECL_OVERRIDE;
@@ -53,9 +55,13 @@ public:
     virtual KJob *update(Domain::Task::Ptr task) Q_DECL_OVERRIDE;
     virtual KJob *remove(Domain::Task::Ptr task) Q_DECL_OVERRIDE;
 
+    virtual KJob *updateTasks(const Domain::Task::List &tasks) Q_DECL_OVERRIDE;
+    virtual KJob *removeTasks(const Domain::Task::List &tasks) Q_DECL_OVERRIDE;
+
     virtual KJob *promoteToProject(Domain::Task::Ptr task) Q_DECL_OVERRIDE;
 
     virtual KJob *associate(Domain::Task::Ptr parent, Domain::Task::Ptr child) Q_DECL_OVERRIDE;
+    virtual KJob *associateTasks(Domain::Task::Ptr parent, const Domain::Task::List &children) Q_DECL_OVERRIDE;
     virtual KJob *dissociate(Domain::Task::Ptr child) Q_DECL_OVERRIDE;
     virtual KJob *dissociateAll(Domain::Task::Ptr child) Q_DECL_OVERRIDE;
 
@@ -65,8 +71,10 @@ private:
     StorageInterface::Ptr m_storage;
     SerializerInterface::Ptr m_serializer;
     MessagingInterface::Ptr m_messaging;
+    Cache::Ptr m_cache;
 
     KJob *createItem(const Akonadi::Item &item);
+    Item::List cachedItemsWithDescendants(const Item::List &items) const;
 };
 
 }
@@ -0,0 +1,95 @@
+/* This file is part of Zanshin
+
+   Copyright 2016 Kevin Ottens <ervin@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+#include "akonaditasksearchindexer.h"
+
+#include <QPointer>
+
+#include "akonadi/akonadilivequeryhelpers.h"
+
+using namespace Akonadi;
+
+TaskSearchIndexer::TaskSearchIndexer(const StorageInterface::Ptr &storage,
+                                     const SerializerInterface::Ptr &serializer,
+                                     const MonitorInterface::Ptr &monitor,
+                                     const Domain::TaskSearchIndex::Ptr &index,
+                                     QObject *parent)
+    : QObject(parent),
+      m_serializer(serializer),
+      m_monitor(monitor),
+      m_index(index)
+{
+    connect(m_monitor.data(), &MonitorInterface::itemAdded,
+            this, &TaskSearchIndexer::onItemChanged);
+    connect(m_monitor.data(), &MonitorInterface::itemChanged,
+            this, &TaskSearchIndexer::onItemChanged);
+    connect(m_monitor.data(), &MonitorInterface::itemMoved,
+            this, &TaskSearchIndexer::onItemChanged);
+    connect(m_monitor.data(), &MonitorInterface::itemRemoved,
+            this, &TaskSearchIndexer::onItemRemoved);
+    connect(m_monitor.data(), &MonitorInterface::collectionRemoved,
+            this, &TaskSearchIndexer::onCollectionRemoved);
+
+    QPointer<TaskSearchIndexer> self(this);
+    const auto fetch = LiveQueryHelpers(serializer, storage).fetchItems(StorageInterface::Tasks);
+    fetch([self] (const Item &item) {
+        if (self)
+            self->onItemChanged(item);
+    });
+}
+
+void TaskSearchIndexer::onItemChanged(const Item &item)
+{
+    // Not a task anymore, for instance turned into a project
+    const auto task = m_serializer->createTaskFromItem(item);
+    if (!task) {
+        onItemRemoved(item);
+        return;
+    }
+
+    m_itemCollections.insert(item.id(), item.parentCollection().id());
+
+    if (task->isDone())
+        m_index->remove(item.id());
+    else
+        m_index->insert(item.id(), task->title());
+}
+
+void TaskSearchIndexer::onItemRemoved(const Item &item)
+{
+    m_itemCollections.remove(item.id());
+    m_index->remove(item.id());
+}
+
+void TaskSearchIndexer::onCollectionRemoved(const Collection &collection)
+{
+    for (auto it = m_itemCollections.begin(); it != m_itemCollections.end();) {
+        if (it.value() == collection.id()) {
+            m_index->remove(it.key());
+            it = m_itemCollections.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
@@ -0,0 +1,67 @@
+/* This file is part of Zanshin
+
+   Copyright 2016 Kevin Ottens <ervin@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+#ifndef AKONADI_TASKSEARCHINDEXER_H
+#define AKONADI_TASKSEARCHINDEXER_H
+
+#include <QHash>
+
+#include <AkonadiCore/Collection>
+#include <AkonadiCore/Item>
+
+#include "akonadi/akonadimonitorinterface.h"
+#include "akonadi/akonadiserializerinterface.h"
+#include "akonadi/akonadistorageinterface.h"
+
+#include "domain/tasksearchindex.h"
+
+namespace Akonadi {
+
+// Feeds a search index with the titles of the open tasks, under their item
+// ids. Only those are kept, the tasks themselves are not.
+class TaskSearchIndexer : public QObject
+{
+    Q_OBJECT
+public:
+    TaskSearchIndexer(const StorageInterface::Ptr &storage,
+                      const SerializerInterface::Ptr &serializer,
+                      const MonitorInterface::Ptr &monitor,
+                      const Domain::TaskSearchIndex::Ptr &index,
+                      QObject *parent = Q_NULLPTR);
+
+private slots:
+    void onItemChanged(const Akonadi::Item &item);
+    void onItemRemoved(const Akonadi::Item &item);
+    void onCollectionRemoved(const Akonadi::Collection &collection);
+
+private:
+    SerializerInterface::Ptr m_serializer;
+    MonitorInterface::Ptr m_monitor;
+    Domain::TaskSearchIndex::Ptr m_index;
+    QHash<Item::Id, Collection::Id> m_itemCollections;
+};
+
+}
+
+#endif // AKONADI_TASKSEARCHINDEXER_H
@@ -26,6 +26,7 @@
 #define DOMAIN_CONTEXTQUERIES_H
 
 #include "context.h"
+#include "counter.h"
 #include "queryresult.h"
 #include "task.h"
 
@@ -42,6 +43,8 @@ public:
     virtual QueryResult<Context::Ptr>::Ptr findAll() const = 0;
 
     virtual QueryResult<Task::Ptr>::Ptr findTopLevelTasks(Context::Ptr context) const = 0;
+
+    virtual Counter::Ptr countTopLevelTasks(Context::Ptr context) const = 0;
 };
 
 }
@@ -0,0 +1,63 @@
+/* This file is part of Zanshin
+
+   Copyright 2016 Kevin Ottens <ervin@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+#ifndef DOMAIN_COUNTER_H
+#define DOMAIN_COUNTER_H
+
+#include <QMetaType>
+#include <QObject>
+#include <QSharedPointer>
+
+namespace Domain {
+
+// Number of items matching a query, kept up to date without building
+// the list of those items
+class Counter : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+public:
+    typedef QSharedPointer<Counter> Ptr;
+
+    explicit Counter(QObject *parent = Q_NULLPTR);
+    virtual ~Counter();
+
+    int count() const;
+
+public slots:
+    void setCount(int count);
+
+signals:
+    void countChanged(int count);
+
+private:
+    int m_count;
+};
+
+}
+
+Q_DECLARE_METATYPE(Domain::Counter::Ptr)
+
+#endif // DOMAIN_COUNTER_H
@@ -25,6 +25,12 @@
 #ifndef DOMAIN_LIVEQUERY_H
 #define DOMAIN_LIVEQUERY_H
 
+#include <type_traits>
+
+#include <QSet>
+
+#include "counter.h"
+#include "propertychangerecorder.h"
 #include "queryresult.h"
 
 namespace Domain {
@@ -48,6 +54,15 @@ public:
     virtual void onAdded(const InputType &input) = 0;
     virtual void onChanged(const InputType &input) = 0;
     virtual void onRemoved(const InputType &input) = 0;
+
+    // Only drops the outputs of an input not matching anymore, called on
+    // all the queries before onChanged() so an input moving from a query
+    // to another is seen leaving the first before entering the second
+    virtual void onChangedAway(const InputType &input) = 0;
+
+    // Changes happening in between might be published as a single reset
+    virtual void beginBulkUpdate() = 0;
+    virtual void endBulkUpdate() = 0;
 };
 
 template <typename OutputType>
@@ -63,46 +78,27 @@ public:
     virtual void reset() = 0;
 };
 
-template<typename InputType, typename OutputType>
-class LiveQuery : public LiveQueryInput<InputType>, public LiveQueryOutput<OutputType>
+// Live query whose fetch, predicate, convert, update and represents steps
+// are provided by Functions. It only needs to have members usable as:
+//   fetch(add), predicate(input), convert(input),
+//   update(input, output) and represents(input, output)
+// which lets callers knowing the exact types get them inlined, the type
+// erasure only happens at the LiveQueryInput/LiveQueryOutput boundary.
+template<typename InputType, typename OutputType, typename Functions>
+class LiveQueryImpl : public LiveQueryInput<InputType>, public LiveQueryOutput<OutputType>
 {
 public:
-    typedef QSharedPointer<LiveQuery<InputType, OutputType>> Ptr;
-    typedef QList<Ptr> List;
+    typedef QSharedPointer<LiveQueryImpl<InputType, OutputType, Functions>> Ptr;
 
     typedef QueryResultProvider<OutputType> Provider;
     typedef QueryResult<OutputType> Result;
 
-    typedef typename LiveQueryInput<InputType>::AddFunction AddFunction;
-    typedef typename LiveQueryInput<InputType>::FetchFunction FetchFunction;
-    typedef typename LiveQueryInput<InputType>::PredicateFunction PredicateFunction;
-
-    typedef std::function<OutputType(const InputType &)> ConvertFunction;
-    typedef std::function<void(const InputType &, OutputType &)> UpdateFunction;
-    typedef std::function<bool(const InputType &, const OutputType &)> RepresentsFunction;
-
-    LiveQuery()
-    {
-    }
-
-    LiveQuery(const LiveQuery &other)
-        : m_fetch(other.m_fetch),
-          m_predicate(other.m_predicate),
-          m_convert(other.m_convert),
-          m_update(other.m_update),
-          m_represents(other.m_represents),
-          m_provider(other.m_provider)
+    explicit LiveQueryImpl(const Functions &functions = Functions())
+        : m_functions(functions)
     {
     }
 
-    LiveQuery &operator=(const LiveQuery &other)
-    {
-        LiveQuery tmp(other);
-        std::swap(*this, other);
-        return *this;
-    }
-
-    ~LiveQuery()
+    ~LiveQueryImpl()
     {
         clear();
     }
@@ -115,6 +111,8 @@ public:
             return Result::create(provider);
 
         provider = Provider::Ptr::create();
+        if (m_applySortKey)
+            m_applySortKey(provider);
         m_provider = provider.toWeakRef();
 
         doFetch();
@@ -122,34 +120,20 @@ public:
         return Result::create(provider);
     }
 
-    void setFetchFunction(const FetchFunction &fetch)
-    {
-        m_fetch = fetch;
-    }
-
-    void setPredicateFunction(const PredicateFunction &predicate)
-    {
-        m_predicate = predicate;
-    }
-
-    void setConvertFunction(const ConvertFunction &convert)
-    {
-        m_convert = convert;
-    }
-
-    void setUpdateFunction(const UpdateFunction &update)
-    {
-        m_update = update;
-    }
-
     void setDebugName(const QByteArray &name)
     {
         m_debugName = name;
     }
 
-    void setRepresentsFunction(const RepresentsFunction &represents)
+    // Keeps the results ordered by the given key, an output moving only
+    // when its own key changes
+    template<typename KeyType>
+    void setSortKey(const std::function<KeyType(const OutputType &)> &sortKey)
     {
-        m_represents = represents;
+        Q_ASSERT(!m_provider);
+        m_applySortKey = [sortKey] (const typename Provider::Ptr &provider) {
+            provider->template setSortKey<KeyType>(sortKey);
+        };
     }
 
     void reset() Q_DECL_OVERRIDE
@@ -165,7 +149,7 @@ public:
         if (!provider)
             return;
 
-        if (m_predicate(input))
+        if (m_functions.predicate(input))
             addToProvider(provider, input);
     }
 
@@ -176,24 +160,20 @@ public:
         if (!provider)
             return;
 
-        if (!m_predicate(input)) {
-            for (int i = 0; i < provider->data().size(); i++) {
-                auto output = provider->data().at(i);
-                if (m_represents(input, output)) {
-                    provider->removeAt(i);
-                    i--;
-                }
-            }
+        if (!m_functions.predicate(input)) {
+            removeFromProvider(provider, input);
         } else {
             bool found = false;
 
             for (int i = 0; i < provider->data().size(); i++) {
                 auto output = provider->data().at(i);
-                if (m_represents(input, output)) {
-                    m_update(input, output);
-                    provider->replace(i, output);
-
+                if (m_functions.represents(input, output)) {
                     found = true;
+
+                    // Nothing to tell if the change didn't reach the output
+                    QList<QByteArray> changedFields;
+                    if (updateOutput(input, output, changedFields))
+                        provider->replace(i, output, changedFields);
                 }
             }
 
@@ -209,15 +189,42 @@ public:
         if (!provider)
             return;
 
-        for (int i = 0; i < provider->data().size(); i++) {
-            auto output = provider->data().at(i);
-            if (m_represents(input, output)) {
-                provider->removeAt(i);
-                i--;
-            }
-        }
+        removeFromProvider(provider, input);
+    }
+
+    void onChangedAway(const InputType &input) Q_DECL_OVERRIDE
+    {
+        typename Provider::Ptr provider(m_provider.toStrongRef());
+
+        if (!provider)
+            return;
+
+        if (!m_functions.predicate(input))
+            removeFromProvider(provider, input);
+    }
+
+    void beginBulkUpdate() Q_DECL_OVERRIDE
+    {
+        typename Provider::Ptr provider(m_provider.toStrongRef());
+
+        if (provider)
+            provider->beginBulkUpdate();
+        m_bulkProvider = provider;
+    }
+
+    void endBulkUpdate() Q_DECL_OVERRIDE
+    {
+        // Use the provider we started with, it might have been replaced meanwhile
+        auto provider = m_bulkProvider;
+        m_bulkProvider.clear();
+
+        if (provider)
+            provider->endBulkUpdate();
     }
 
+protected:
+    Functions m_functions;
+
 private:
     template<typename T>
     bool isValidOutput(const T &/*output*/)
@@ -237,13 +244,64 @@ private:
         return output != Q_NULLPTR;
     }
 
+    template<typename T>
+    void trackOutput(const T &/*output*/)
+    {
+    }
+
+    // From there on the changes done in place on the object (for instance
+    // by a model before asking a repository to store it) get recorded too
+    template<typename T>
+    typename std::enable_if<std::is_base_of<QObject, T>::value>::type
+    trackOutput(const QSharedPointer<T> &output)
+    {
+        PropertyChangeRecorder::attachTo(output.data());
+    }
+
+    template<typename T>
+    bool updateOutput(const InputType &input, T &output, QList<QByteArray> &/*changedFields*/)
+    {
+        m_functions.update(input, output);
+        return true;
+    }
+
+    // The fields changed since the output was last published, so a change
+    // already applied in place still gets published once it's confirmed
+    template<typename T>
+    typename std::enable_if<std::is_base_of<QObject, T>::value, bool>::type
+    updateOutput(const InputType &input, QSharedPointer<T> &output, QList<QByteArray> &changedFields)
+    {
+        auto recorder = PropertyChangeRecorder::attachTo(output.data());
+        m_functions.update(input, output);
+        changedFields = recorder->takeChangedProperties();
+        return !changedFields.isEmpty();
+    }
+
     void addToProvider(const typename Provider::Ptr &provider, const InputType &input)
     {
-        auto output = m_convert(input);
-        if (isValidOutput(output))
+        auto output = m_functions.convert(input);
+        if (!isValidOutput(output))
+            return;
+
+        trackOutput(output);
+
+        if (provider->isSorted())
+            provider->insertSorted(output);
+        else
             provider->append(output);
     }
 
+    void removeFromProvider(const typename Provider::Ptr &provider, const InputType &input)
+    {
+        for (int i = 0; i < provider->data().size(); i++) {
+            auto output = provider->data().at(i);
+            if (m_functions.represents(input, output)) {
+                provider->removeAt(i);
+                i--;
+            }
+        }
+    }
+
     void doFetch()
     {
         typename Provider::Ptr provider(m_provider.toStrongRef());
@@ -252,11 +310,11 @@ private:
             return;
 
         auto addFunction = [this, provider] (const InputType &input) {
-            if (m_predicate(input))
+            if (m_functions.predicate(input))
                 addToProvider(provider, input);
         };
 
-        m_fetch(addFunction);
+        m_functions.fetch(addFunction);
     }
 
     void clear()
@@ -270,14 +328,455 @@ private:
             provider->removeFirst();
     }
 
+    QByteArray m_debugName;
+    std::function<void(const typename Provider::Ptr &)> m_applySortKey;
+
+    typename Provider::WeakPtr m_provider;
+    typename Provider::Ptr m_bulkProvider;
+};
+
+class LiveCountOutput
+{
+public:
+    typedef QSharedPointer<LiveCountOutput> Ptr;
+
+    virtual ~LiveCountOutput() {}
+    virtual Counter::Ptr counter() = 0;
+    virtual void reset() = 0;
+};
+
+// Live query only counting the inputs matching its predicate, it goes
+// through the same fetch and deltas as a LiveQuery but keeps nothing
+// more than the keys of the matching inputs
+template<typename InputType, typename KeyType>
+class LiveCount : public LiveQueryInput<InputType>, public LiveCountOutput
+{
+public:
+    typedef QSharedPointer<LiveCount<InputType, KeyType>> Ptr;
+
+    typedef typename LiveQueryInput<InputType>::FetchFunction FetchFunction;
+    typedef typename LiveQueryInput<InputType>::PredicateFunction PredicateFunction;
+    typedef std::function<KeyType(const InputType &)> KeyFunction;
+
+    LiveCount()
+        : m_bulkUpdate(false)
+    {
+    }
+
+    void setDebugName(const QByteArray &name)
+    {
+        m_debugName = name;
+    }
+
+    void setFetchFunction(const FetchFunction &fetch)
+    {
+        m_fetch = fetch;
+    }
+
+    void setPredicateFunction(const PredicateFunction &predicate)
+    {
+        m_predicate = predicate;
+    }
+
+    void setKeyFunction(const KeyFunction &key)
+    {
+        m_key = key;
+    }
+
+    Counter::Ptr counter() Q_DECL_OVERRIDE
+    {
+        Counter::Ptr counter(m_counter.toStrongRef());
+
+        if (counter)
+            return counter;
+
+        counter = Counter::Ptr::create();
+        m_counter = counter.toWeakRef();
+
+        doFetch();
+
+        return counter;
+    }
+
+    void reset() Q_DECL_OVERRIDE
+    {
+        m_keys.clear();
+        publish();
+        doFetch();
+    }
+
+    void onAdded(const InputType &input) Q_DECL_OVERRIDE
+    {
+        if (!m_counter)
+            return;
+
+        if (m_predicate(input))
+            insert(input);
+    }
+
+    void onChanged(const InputType &input) Q_DECL_OVERRIDE
+    {
+        if (!m_counter)
+            return;
+
+        if (m_predicate(input))
+            insert(input);
+        else
+            remove(input);
+    }
+
+    void onRemoved(const InputType &input) Q_DECL_OVERRIDE
+    {
+        if (!m_counter)
+            return;
+
+        remove(input);
+    }
+
+    void onChangedAway(const InputType &input) Q_DECL_OVERRIDE
+    {
+        if (!m_counter)
+            return;
+
+        if (!m_predicate(input))
+            remove(input);
+    }
+
+    void beginBulkUpdate() Q_DECL_OVERRIDE
+    {
+        m_bulkUpdate = true;
+    }
+
+    void endBulkUpdate() Q_DECL_OVERRIDE
+    {
+        m_bulkUpdate = false;
+        publish();
+    }
+
+private:
+    void insert(const InputType &input)
+    {
+        const auto key = m_key(input);
+        if (m_keys.contains(key))
+            return;
+
+        m_keys.insert(key);
+        publish();
+    }
+
+    void remove(const InputType &input)
+    {
+        if (m_keys.remove(m_key(input)))
+            publish();
+    }
+
+    void publish()
+    {
+        Counter::Ptr counter(m_counter.toStrongRef());
+
+        if (counter && !m_bulkUpdate)
+            counter->setCount(m_keys.size());
+    }
+
+    void doFetch()
+    {
+        // The keys are only meaningful while someone holds the counter
+        m_keys.clear();
+
+        Counter::Ptr counter(m_counter.toStrongRef());
+
+        if (!counter)
+            return;
+
+        auto addFunction = [this, counter] (const InputType &input) {
+            // Came back after the counter it was meant for is gone
+            if (m_counter != counter)
+                return;
+
+            if (m_predicate(input))
+                insert(input);
+        };
+
+        m_fetch(addFunction);
+    }
+
+    QByteArray m_debugName;
     FetchFunction m_fetch;
     PredicateFunction m_predicate;
-    ConvertFunction m_convert;
-    UpdateFunction m_update;
-    RepresentsFunction m_represents;
+    KeyFunction m_key;
+
+    QWeakPointer<Counter> m_counter;
+    QSet<KeyType> m_keys;
+    bool m_bulkUpdate;
+};
+
+template<typename GroupType>
+class LiveGroupCountOutput
+{
+public:
+    typedef QSharedPointer<LiveGroupCountOutput<GroupType>> Ptr;
+
+    virtual ~LiveGroupCountOutput() {}
+    virtual Counter::Ptr counter(const GroupType &group) = 0;
+    virtual void reset() = 0;
+};
+
+// Counts the inputs of each group out of a single fetch, the groups of
+// an input are kept so its deltas only touch the counts of the groups
+// it enters or leaves
+template<typename InputType, typename KeyType, typename GroupType>
+class LiveGroupCount : public LiveQueryInput<InputType>, public LiveGroupCountOutput<GroupType>
+{
+public:
+    typedef QSharedPointer<LiveGroupCount<InputType, KeyType, GroupType>> Ptr;
+
+    typedef typename LiveQueryInput<InputType>::FetchFunction FetchFunction;
+    typedef std::function<QList<GroupType>(const InputType &)> GroupsFunction;
+    typedef std::function<KeyType(const InputType &)> KeyFunction;
+
+    LiveGroupCount()
+        : m_fetched(false),
+          m_fetchId(0),
+          m_bulkUpdate(false)
+    {
+    }
+
+    void setDebugName(const QByteArray &name)
+    {
+        m_debugName = name;
+    }
+
+    void setFetchFunction(const FetchFunction &fetch)
+    {
+        m_fetch = fetch;
+    }
+
+    void setGroupsFunction(const GroupsFunction &groups)
+    {
+        m_groups = groups;
+    }
+
+    void setKeyFunction(const KeyFunction &key)
+    {
+        m_key = key;
+    }
+
+    Counter::Ptr counter(const GroupType &group) Q_DECL_OVERRIDE
+    {
+        Counter::Ptr counter(m_counters.value(group).toStrongRef());
+
+        if (counter)
+            return counter;
+
+        counter = Counter::Ptr::create();
+        counter->setCount(m_counts.value(group));
+        m_counters.insert(group, counter.toWeakRef());
+
+        if (!m_fetched)
+            doFetch();
+
+        return counter;
+    }
+
+    void reset() Q_DECL_OVERRIDE
+    {
+        doFetch();
+    }
+
+    void onAdded(const InputType &input) Q_DECL_OVERRIDE
+    {
+        if (m_fetched)
+            setGroups(m_key(input), m_groups(input));
+    }
+
+    void onChanged(const InputType &input) Q_DECL_OVERRIDE
+    {
+        if (m_fetched)
+            setGroups(m_key(input), m_groups(input));
+    }
+
+    void onRemoved(const InputType &input) Q_DECL_OVERRIDE
+    {
+        if (m_fetched)
+            setGroups(m_key(input), QList<GroupType>());
+    }
+
+    void onChangedAway(const InputType &input) Q_DECL_OVERRIDE
+    {
+        if (!m_fetched)
+            return;
+
+        const auto key = m_key(input);
+        const auto groups = m_groups(input);
+
+        auto remaining = m_inputGroups.value(key);
+        for (auto it = remaining.begin(); it != remaining.end();) {
+            if (!groups.contains(*it))
+                it = remaining.erase(it);
+            else
+                ++it;
+        }
+        setGroups(key, remaining);
+    }
+
+    void beginBulkUpdate() Q_DECL_OVERRIDE
+    {
+        m_bulkUpdate = true;
+    }
+
+    void endBulkUpdate() Q_DECL_OVERRIDE
+    {
+        m_bulkUpdate = false;
+        publish();
+    }
+
+private:
+    void setGroups(const KeyType &key, const QList<GroupType> &groups)
+    {
+        const auto oldGroups = groups.isEmpty() ? m_inputGroups.take(key)
+                                                : m_inputGroups.value(key);
+        if (oldGroups == groups)
+            return;
+
+        foreach (const auto &group, oldGroups) {
+            if (!groups.contains(group)) {
+                if (--m_counts[group] == 0)
+                    m_counts.remove(group);
+                m_dirtyGroups.insert(group);
+            }
+        }
+
+        foreach (const auto &group, groups) {
+            if (!oldGroups.contains(group)) {
+                m_counts[group]++;
+                m_dirtyGroups.insert(group);
+            }
+        }
+
+        if (!groups.isEmpty())
+            m_inputGroups.insert(key, groups);
+
+        publish();
+    }
+
+    void publish()
+    {
+        if (m_bulkUpdate)
+            return;
+
+        foreach (const auto &group, m_dirtyGroups) {
+            auto it = m_counters.find(group);
+            if (it == m_counters.end())
+                continue;
+
+            Counter::Ptr counter(it->toStrongRef());
+            if (counter)
+                counter->setCount(m_counts.value(group));
+            else
+                m_counters.erase(it);
+        }
+
+        m_dirtyGroups.clear();
+    }
+
+    void doFetch()
+    {
+        // The groups are known for all the inputs from there on, the
+        // deltas keep them up to date
+        m_fetched = true;
+        const int fetchId = ++m_fetchId;
+
+        foreach (const auto &group, m_counts.keys())
+            m_dirtyGroups.insert(group);
+        m_inputGroups.clear();
+        m_counts.clear();
+        publish();
+
+        auto addFunction = [this, fetchId] (const InputType &input) {
+            // Came back after a reset asked for a new fetch
+            if (fetchId != m_fetchId)
+                return;
+
+            const auto key = m_key(input);
+            if (m_inputGroups.contains(key))
+                return;
+
+            setGroups(key, m_groups(input));
+        };
+
+        m_fetch(addFunction);
+    }
+
     QByteArray m_debugName;
+    FetchFunction m_fetch;
+    GroupsFunction m_groups;
+    KeyFunction m_key;
 
-    typename Provider::WeakPtr m_provider;
+    bool m_fetched;
+    int m_fetchId;
+
+    QHash<KeyType, QList<GroupType>> m_inputGroups;
+    QHash<GroupType, int> m_counts;
+    QHash<GroupType, QWeakPointer<Counter>> m_counters;
+    QSet<GroupType> m_dirtyGroups;
+    bool m_bulkUpdate;
+};
+
+namespace Internal {
+    template<typename InputType, typename OutputType>
+    struct LiveQueryFunctions
+    {
+        typename LiveQueryInput<InputType>::FetchFunction fetch;
+        typename LiveQueryInput<InputType>::PredicateFunction predicate;
+        std::function<OutputType(const InputType &)> convert;
+        std::function<void(const InputType &, OutputType &)> update;
+        std::function<bool(const InputType &, const OutputType &)> represents;
+    };
+}
+
+// Live query with its steps set at runtime
+template<typename InputType, typename OutputType>
+class LiveQuery : public LiveQueryImpl<InputType, OutputType, Internal::LiveQueryFunctions<InputType, OutputType>>
+{
+public:
+    typedef QSharedPointer<LiveQuery<InputType, OutputType>> Ptr;
+    typedef QList<Ptr> List;
+
+    typedef QueryResultProvider<OutputType> Provider;
+    typedef QueryResult<OutputType> Result;
+
+    typedef typename LiveQueryInput<InputType>::AddFunction AddFunction;
+    typedef typename LiveQueryInput<InputType>::FetchFunction FetchFunction;
+    typedef typename LiveQueryInput<InputType>::PredicateFunction PredicateFunction;
+
+    typedef std::function<OutputType(const InputType &)> ConvertFunction;
+    typedef std::function<void(const InputType &, OutputType &)> UpdateFunction;
+    typedef std::function<bool(const InputType &, const OutputType &)> RepresentsFunction;
+
+    void setFetchFunction(const FetchFunction &fetch)
+    {
+        this->m_functions.fetch = fetch;
+    }
+
+    void setPredicateFunction(const PredicateFunction &predicate)
+    {
+        this->m_functions.predicate = predicate;
+    }
+
+    void setConvertFunction(const ConvertFunction &convert)
+    {
+        this->m_functions.convert = convert;
+    }
+
+    void setUpdateFunction(const UpdateFunction &update)
+    {
+        this->m_functions.update = update;
+    }
+
+    void setRepresentsFunction(const RepresentsFunction &represents)
+    {
+        this->m_functions.represents = represents;
+    }
 };
 
 
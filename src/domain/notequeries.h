@@ -24,6 +24,7 @@
 #ifndef DOMAIN_NOTEQUERIES_H
 #define DOMAIN_NOTEQUERIES_H
 
+#include "counter.h"
 #include "note.h"
 #include "project.h"
 #include "queryresult.h"
@@ -40,6 +41,7 @@ public:
 
     virtual QueryResult<Note::Ptr>::Ptr findAll() const = 0;
     virtual QueryResult<Note::Ptr>::Ptr findInbox() const = 0;
+    virtual Counter::Ptr countInbox() const = 0;
 };
 
 }
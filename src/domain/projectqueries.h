@@ -24,6 +24,7 @@
 #ifndef DOMAIN_PROJECTQUERIES_H
 #define DOMAIN_PROJECTQUERIES_H
 
+#include "counter.h"
 #include "project.h"
 #include "queryresult.h"
 #include "task.h"
@@ -40,6 +41,7 @@ public:
 
     virtual QueryResult<Project::Ptr>::Ptr findAll() const = 0;
     virtual QueryResult<Task::Ptr>::Ptr findTopLevel(Project::Ptr project) const = 0;
+    virtual Counter::Ptr countTopLevel(Project::Ptr project) const = 0;
 };
 
 }
@@ -45,6 +45,8 @@ public:
     virtual KJob *remove(Project::Ptr project) = 0;
 
     virtual KJob *associate(Project::Ptr parent, Artifact::Ptr child) = 0;
+    // Batch variant, all the changes are grouped in a single transaction
+    virtual KJob *associateArtifacts(Project::Ptr parent, const Artifact::List &children) = 0;
     virtual KJob *dissociate(Artifact::Ptr child) = 0;
 };
 
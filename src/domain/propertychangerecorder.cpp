@@ -0,0 +1,101 @@
+/* This file is part of Zanshin
+
+   Copyright 2016 Kevin Ottens <ervin@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+#include "propertychangerecorder.h"
+
+#include <QDynamicPropertyChangeEvent>
+#include <QMetaProperty>
+
+using namespace Domain;
+
+PropertyChangeRecorder::PropertyChangeRecorder(QObject *object)
+    : m_object(object)
+{
+    const auto slot = metaObject()->method(metaObject()->indexOfSlot("onPropertyNotified()"));
+    const auto objectMetaObject = object->metaObject();
+    for (int i = 0; i < objectMetaObject->propertyCount(); i++) {
+        const auto property = objectMetaObject->property(i);
+        if (property.hasNotifySignal())
+            connect(object, property.notifySignal(), this, slot, Qt::DirectConnection);
+    }
+
+    // Setting a dynamic property always notifies, we need the old values
+    foreach (const auto &name, object->dynamicPropertyNames())
+        m_dynamicProperties.insert(name, object->property(name.constData()));
+    object->installEventFilter(this);
+}
+
+PropertyChangeRecorder *PropertyChangeRecorder::attachTo(QObject *object)
+{
+    auto recorder = object->findChild<PropertyChangeRecorder*>(QString(), Qt::FindDirectChildrenOnly);
+    if (!recorder) {
+        recorder = new PropertyChangeRecorder(object);
+        recorder->setParent(object);
+    }
+    return recorder;
+}
+
+QList<QByteArray> PropertyChangeRecorder::changedProperties() const
+{
+    return m_changedProperties;
+}
+
+QList<QByteArray> PropertyChangeRecorder::takeChangedProperties()
+{
+    QList<QByteArray> result;
+    result.swap(m_changedProperties);
+    return result;
+}
+
+bool PropertyChangeRecorder::eventFilter(QObject *object, QEvent *event)
+{
+    if (object == m_object && event->type() == QEvent::DynamicPropertyChange) {
+        const auto name = static_cast<QDynamicPropertyChangeEvent*>(event)->propertyName();
+        const auto value = object->property(name.constData());
+        if (value != m_dynamicProperties.value(name)) {
+            m_dynamicProperties.insert(name, value);
+            record(name);
+        }
+    }
+    return false;
+}
+
+void PropertyChangeRecorder::onPropertyNotified()
+{
+    const int signalIndex = senderSignalIndex();
+    const auto objectMetaObject = m_object->metaObject();
+    for (int i = 0; i < objectMetaObject->propertyCount(); i++) {
+        const auto property = objectMetaObject->property(i);
+        if (property.notifySignalIndex() != signalIndex)
+            continue;
+
+        record(property.name());
+    }
+}
+
+void PropertyChangeRecorder::record(const QByteArray &name)
+{
+    if (!m_changedProperties.contains(name))
+        m_changedProperties << name;
+}
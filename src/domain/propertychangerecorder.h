@@ -0,0 +1,66 @@
+/* This file is part of Zanshin
+
+   Copyright 2016 Kevin Ottens <ervin@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+#ifndef DOMAIN_PROPERTYCHANGERECORDER_H
+#define DOMAIN_PROPERTYCHANGERECORDER_H
+
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QVariant>
+
+namespace Domain {
+
+// Records the properties of an object which notify a change and the
+// dynamic properties set on it while the recorder is alive, setters not
+// changing anything don't notify
+class PropertyChangeRecorder : public QObject
+{
+    Q_OBJECT
+public:
+    explicit PropertyChangeRecorder(QObject *object);
+
+    // Recorder living as long as the object, shared by all the callers,
+    // so changes done in place by anyone are seen
+    static PropertyChangeRecorder *attachTo(QObject *object);
+
+    QList<QByteArray> changedProperties() const;
+    QList<QByteArray> takeChangedProperties();
+
+    bool eventFilter(QObject *object, QEvent *event) Q_DECL_OVERRIDE;
+
+private slots:
+    void onPropertyNotified();
+
+private:
+    void record(const QByteArray &name);
+
+    const QObject *m_object;
+    QList<QByteArray> m_changedProperties;
+    QHash<QByteArray, QVariant> m_dynamicProperties;
+};
+
+}
+
+#endif // DOMAIN_PROPERTYCHANGERECORDER_H
@@ -40,6 +40,7 @@ public:
     typedef QSharedPointer<QueryResult<InputType, OutputType>> Ptr;
     typedef QWeakPointer<QueryResult<InputType, OutputType>> WeakPtr;
     typedef std::function<void(OutputType, int)> ChangeHandler;
+    typedef std::function<void()> ResetHandler;
 
     static Ptr create(const typename QueryResultProvider<InputType>::Ptr &provider)
     {
@@ -62,6 +63,12 @@ public:
         return dataImpl<OutputType>();
     }
 
+    QList<QByteArray> changedFields() const
+    {
+        auto provider = QueryResultInputImpl<InputType>::m_provider;
+        return provider->changedFields();
+    }
+
     void addPreInsertHandler(const ChangeHandler &handler)
     {
         QueryResultInputImpl<InputType>::m_preInsertHandlers << handler;
@@ -92,6 +99,16 @@ public:
         QueryResultInputImpl<InputType>::m_postReplaceHandlers << handler;
     }
 
+    void addPreResetHandler(const ResetHandler &handler)
+    {
+        QueryResultInputImpl<InputType>::m_preResetHandlers << handler;
+    }
+
+    void addPostResetHandler(const ResetHandler &handler)
+    {
+        QueryResultInputImpl<InputType>::m_postResetHandlers << handler;
+    }
+
 private:
     explicit QueryResult(const typename QueryResultProvider<InputType>::Ptr &provider)
         : QueryResultInputImpl<InputType>(provider)
@@ -27,6 +27,7 @@
 
 #include <functional>
 
+#include <QByteArray>
 #include <QSharedPointer>
 
 namespace Domain {
@@ -38,17 +39,27 @@ public:
     typedef QSharedPointer<QueryResultInterface<OutputType>> Ptr;
     typedef QWeakPointer<QueryResultInterface<OutputType>> WeakPtr;
     typedef std::function<void(OutputType, int)> ChangeHandler;
+    typedef std::function<void()> ResetHandler;
 
     virtual ~QueryResultInterface() {}
 
     virtual QList<OutputType> data() const = 0;
 
+    // From a replace handler, the fields of the item the change touched,
+    // empty if they are not known
+    virtual QList<QByteArray> changedFields() const = 0;
+
     virtual void addPreInsertHandler(const ChangeHandler &handler) = 0;
     virtual void addPostInsertHandler(const ChangeHandler &handler) = 0;
     virtual void addPreRemoveHandler(const ChangeHandler &handler) = 0;
     virtual void addPostRemoveHandler(const ChangeHandler &handler) = 0;
     virtual void addPreReplaceHandler(const ChangeHandler &handler) = 0;
     virtual void addPostReplaceHandler(const ChangeHandler &handler) = 0;
+
+    // Results having reset handlers get notified of bulk updates on their
+    // provider as one reset instead of one change per item
+    virtual void addPreResetHandler(const ResetHandler &handler) = 0;
+    virtual void addPostResetHandler(const ResetHandler &handler) = 0;
 };
 
 }
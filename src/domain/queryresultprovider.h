@@ -28,6 +28,7 @@
 #include <algorithm>
 #include <functional>
 
+#include <QByteArray>
 #include <QList>
 #include <QSharedPointer>
 
@@ -38,6 +39,65 @@ namespace Domain {
 template<typename ItemType>
 class QueryResultProvider;
 
+namespace Internal {
+    // Keys of the items of a sorted provider, in the order of the items
+    template<typename ItemType>
+    class SortKeys
+    {
+    public:
+        typedef QSharedPointer<SortKeys<ItemType>> Ptr;
+
+        virtual ~SortKeys() {}
+
+        // Binary search for the position, after the items with the same key
+        virtual int insert(const ItemType &item) = 0;
+        // False if the item doesn't fit at index anymore
+        virtual bool replace(int index, const ItemType &item) = 0;
+        virtual void removeAt(int index) = 0;
+    };
+
+    template<typename ItemType, typename KeyType>
+    class SortKeysImpl : public SortKeys<ItemType>
+    {
+    public:
+        typedef std::function<KeyType(const ItemType &)> KeyFunction;
+
+        explicit SortKeysImpl(const KeyFunction &key)
+            : m_key(key)
+        {
+        }
+
+        int insert(const ItemType &item) Q_DECL_OVERRIDE
+        {
+            const auto key = m_key(item);
+            const int index = std::upper_bound(m_keys.constBegin(), m_keys.constEnd(), key) - m_keys.constBegin();
+            m_keys.insert(index, key);
+            return index;
+        }
+
+        bool replace(int index, const ItemType &item) Q_DECL_OVERRIDE
+        {
+            const auto key = m_key(item);
+            const bool fitsBefore = index == 0 || !(key < m_keys.at(index - 1));
+            const bool fitsAfter = index == m_keys.size() - 1 || !(m_keys.at(index + 1) < key);
+            if (!fitsBefore || !fitsAfter)
+                return false;
+
+            m_keys.replace(index, key);
+            return true;
+        }
+
+        void removeAt(int index) Q_DECL_OVERRIDE
+        {
+            m_keys.removeAt(index);
+        }
+
+    private:
+        KeyFunction m_key;
+        QList<KeyType> m_keys;
+    };
+}
+
 template<typename InputType>
 class QueryResultInputImpl
 {
@@ -47,12 +107,15 @@ public:
     typedef QWeakPointer<QueryResultInputImpl<InputType>> WeakPtr;
     typedef std::function<void(InputType, int)> ChangeHandler;
     typedef QList<ChangeHandler> ChangeHandlerList;
+    typedef std::function<void()> ResetHandler;
+    typedef QList<ResetHandler> ResetHandlerList;
 
     virtual ~QueryResultInputImpl() {}
 
 protected:
     explicit QueryResultInputImpl(const ProviderPtr &provider)
-        : m_provider(provider)
+        : m_provider(provider),
+          m_resetting(false)
     {
     }
 
@@ -108,6 +171,13 @@ protected:
         return m_postReplaceHandlers;
     }
 
+    // cppcheck can't figure out the friend class
+    // cppcheck-suppress unusedPrivateFunction
+    bool handlesReset() const
+    {
+        return !m_preResetHandlers.isEmpty() || !m_postResetHandlers.isEmpty();
+    }
+
     friend class QueryResultProvider<InputType>;
     ProviderPtr m_provider;
     ChangeHandlerList m_preInsertHandlers;
@@ -116,6 +186,9 @@ protected:
     ChangeHandlerList m_postRemoveHandlers;
     ChangeHandlerList m_preReplaceHandlers;
     ChangeHandlerList m_postReplaceHandlers;
+    ResetHandlerList m_preResetHandlers;
+    ResetHandlerList m_postResetHandlers;
+    bool m_resetting;
 };
 
 template<typename ItemType>
@@ -132,6 +205,7 @@ public:
 
 
     QueryResultProvider()
+        : m_bulkUpdateDepth(0)
     {
     }
 
@@ -140,34 +214,72 @@ public:
         return m_list;
     }
 
-    void append(const ItemType &item)
+    // In sorted mode items are kept ordered by their key, which is computed
+    // only once when they get in or are replaced, the order must be
+    // chosen before anything gets in
+    template<typename KeyType>
+    void setSortKey(const std::function<KeyType(const ItemType &)> &function)
     {
+        Q_ASSERT(m_list.isEmpty());
+        m_sortKeys.reset(new Internal::SortKeysImpl<ItemType, KeyType>(function));
+    }
+
+    bool isSorted() const
+    {
+        return !m_sortKeys.isNull();
+    }
+
+    // Between those calls, the results able to handle resets don't see the
+    // individual changes anymore, they get a single reset instead at the end
+    // (and only if something changed), the other results are still notified
+    // of each change
+    void beginBulkUpdate()
+    {
+        m_bulkUpdateDepth++;
+    }
+
+    void endBulkUpdate()
+    {
+        Q_ASSERT(m_bulkUpdateDepth > 0);
+        if (--m_bulkUpdateDepth > 0)
+            return;
+
         cleanupResults();
-        callChangeHandlers(item, m_list.size(),
-                           Utils::mem_fn(&QueryResultInputImpl<ItemType>::preInsertHandlers));
-        m_list.append(item);
-        callChangeHandlers(item, m_list.size()-1,
-                           Utils::mem_fn(&QueryResultInputImpl<ItemType>::postInsertHandlers));
+        for (auto weakResult : m_results) {
+            auto result = weakResult.toStrongRef();
+            if (!result || !result->m_resetting)
+                continue;
+
+            result->m_resetting = false;
+            for (auto handler : result->m_postResetHandlers)
+                handler();
+        }
+    }
+
+    void append(const ItemType &item)
+    {
+        Q_ASSERT(!isSorted());
+        doInsert(m_list.size(), item);
     }
 
     void prepend(const ItemType &item)
     {
-        cleanupResults();
-        callChangeHandlers(item, 0,
-                           Utils::mem_fn(&QueryResultInputImpl<ItemType>::preInsertHandlers));
-        m_list.prepend(item);
-        callChangeHandlers(item, 0,
-                           Utils::mem_fn(&QueryResultInputImpl<ItemType>::postInsertHandlers));
+        Q_ASSERT(!isSorted());
+        doInsert(0, item);
     }
 
     void insert(int index, const ItemType &item)
     {
-        cleanupResults();
-        callChangeHandlers(item, index,
-                           Utils::mem_fn(&QueryResultInputImpl<ItemType>::preInsertHandlers));
-        m_list.insert(index, item);
-        callChangeHandlers(item, index,
-                           Utils::mem_fn(&QueryResultInputImpl<ItemType>::postInsertHandlers));
+        Q_ASSERT(!isSorted());
+        doInsert(index, item);
+    }
+
+    int insertSorted(const ItemType &item)
+    {
+        Q_ASSERT(isSorted());
+        const int index = m_sortKeys->insert(item);
+        doInsert(index, item);
+        return index;
     }
 
     ItemType takeFirst()
@@ -177,6 +289,8 @@ public:
         callChangeHandlers(item, 0,
                            Utils::mem_fn(&QueryResultInputImpl<ItemType>::preRemoveHandlers));
         m_list.removeFirst();
+        if (isSorted())
+            m_sortKeys->removeAt(0);
         callChangeHandlers(item, 0,
                            Utils::mem_fn(&QueryResultInputImpl<ItemType>::postRemoveHandlers));
         return item;
@@ -194,6 +308,8 @@ public:
         callChangeHandlers(item, m_list.size()-1,
                            Utils::mem_fn(&QueryResultInputImpl<ItemType>::preRemoveHandlers));
         m_list.removeLast();
+        if (isSorted())
+            m_sortKeys->removeAt(m_list.size());
         callChangeHandlers(item, m_list.size(),
                            Utils::mem_fn(&QueryResultInputImpl<ItemType>::postRemoveHandlers));
         return item;
@@ -211,6 +327,8 @@ public:
         callChangeHandlers(item, index,
                            Utils::mem_fn(&QueryResultInputImpl<ItemType>::preRemoveHandlers));
         m_list.removeAt(index);
+        if (isSorted())
+            m_sortKeys->removeAt(index);
         callChangeHandlers(item, index,
                            Utils::mem_fn(&QueryResultInputImpl<ItemType>::postRemoveHandlers));
         return item;
@@ -221,14 +339,31 @@ public:
         takeAt(index);
     }
 
-    void replace(int index, const ItemType &item)
+    // In sorted mode an item which doesn't fit its position anymore is
+    // taken out and inserted again, otherwise it's replaced in place and
+    // the replace handlers can tell which fields changed if those are given
+    void replace(int index, const ItemType &item, const QList<QByteArray> &changedFields = QList<QByteArray>())
     {
+        if (isSorted() && !m_sortKeys->replace(index, item)) {
+            takeAt(index);
+            insertSorted(item);
+            return;
+        }
+
         cleanupResults();
+        m_changedFields = changedFields;
         callChangeHandlers(m_list.at(index), index,
                            Utils::mem_fn(&QueryResultInputImpl<ItemType>::preReplaceHandlers));
         m_list.replace(index, item);
         callChangeHandlers(item, index,
                            Utils::mem_fn(&QueryResultInputImpl<ItemType>::postReplaceHandlers));
+        m_changedFields.clear();
+    }
+
+    // Empty outside of replace handlers or if the fields are unknown
+    QList<QByteArray> changedFields() const
+    {
+        return m_changedFields;
     }
 
     QueryResultProvider &operator<< (const ItemType &item)
@@ -238,6 +373,16 @@ public:
     }
 
 private:
+    void doInsert(int index, const ItemType &item)
+    {
+        cleanupResults();
+        callChangeHandlers(item, index,
+                           Utils::mem_fn(&QueryResultInputImpl<ItemType>::preInsertHandlers));
+        m_list.insert(index, item);
+        callChangeHandlers(item, index,
+                           Utils::mem_fn(&QueryResultInputImpl<ItemType>::postInsertHandlers));
+    }
+
     void cleanupResults()
     {
         m_results.erase(std::remove_if(m_results.begin(),
@@ -254,6 +399,16 @@ private:
         {
             auto result = weakResult.toStrongRef();
             if (!result) continue;
+
+            if (m_bulkUpdateDepth > 0 && result->handlesReset()) {
+                if (!result->m_resetting) {
+                    result->m_resetting = true;
+                    for (auto handler : result->m_preResetHandlers)
+                        handler();
+                }
+                continue;
+            }
+
             for (auto handler : handlerGetter(result))
             {
                 handler(item, index);
@@ -263,7 +418,10 @@ private:
 
     friend class QueryResultInputImpl<ItemType>;
     QList<ItemType> m_list;
+    typename Internal::SortKeys<ItemType>::Ptr m_sortKeys;
     QList<ResultWeakPtr> m_results;
+    QList<QByteArray> m_changedFields;
+    int m_bulkUpdateDepth;
 };
 
 }
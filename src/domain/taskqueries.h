@@ -25,6 +25,7 @@
 #define DOMAIN_TASKQUERIES_H
 
 #include "context.h"
+#include "counter.h"
 #include "queryresult.h"
 #include "task.h"
 
@@ -48,6 +49,12 @@ public:
 
     virtual QueryResult<Task::Ptr>::Ptr findWorkdayTopLevel() const = 0;
 
+    virtual QueryResult<Task::Ptr>::Ptr findRunning() const = 0;
+
+    virtual Counter::Ptr countInboxTopLevel() const = 0;
+
+    virtual Counter::Ptr countWorkdayTopLevel() const = 0;
+
     virtual QueryResult<Context::Ptr>::Ptr findContexts(Task::Ptr task) const = 0;
 };
 
@@ -49,9 +49,14 @@ public:
     virtual KJob *update(Task::Ptr task) = 0;
     virtual KJob *remove(Task::Ptr task) = 0;
 
+    // Batch variants, all the changes are grouped in a single transaction
+    virtual KJob *updateTasks(const Task::List &tasks) = 0;
+    virtual KJob *removeTasks(const Task::List &tasks) = 0;
+
     virtual KJob *promoteToProject(Task::Ptr task) = 0;
 
     virtual KJob *associate(Task::Ptr parent, Task::Ptr child) = 0;
+    virtual KJob *associateTasks(Task::Ptr parent, const Task::List &children) = 0;
     virtual KJob *dissociate(Task::Ptr child) = 0;
     virtual KJob *dissociateAll(Task::Ptr child) = 0;
 
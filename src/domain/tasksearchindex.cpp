@@ -0,0 +1,144 @@
+/* This file is part of Zanshin
+
+   Copyright 2016 Kevin Ottens <ervin@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+#include "tasksearchindex.h"
+
+#include <algorithm>
+
+#include <QSet>
+
+using namespace Domain;
+
+int TaskSearchIndex::count() const
+{
+    QReadLocker locker(&m_lock);
+    return m_entries.size();
+}
+
+void TaskSearchIndex::insert(qint64 id, const QString &title)
+{
+    const auto tokens = tokenize(title);
+
+    QWriteLocker locker(&m_lock);
+    removeLocked(id);
+    m_entries.insert(id, {title, tokens});
+
+    foreach (const auto &token, tokens)
+        m_postings.insert(token, id);
+}
+
+void TaskSearchIndex::remove(qint64 id)
+{
+    QWriteLocker locker(&m_lock);
+    removeLocked(id);
+}
+
+void TaskSearchIndex::clear()
+{
+    QWriteLocker locker(&m_lock);
+    m_entries.clear();
+    m_postings.clear();
+}
+
+QVector<TaskSearchIndex::Hit> TaskSearchIndex::search(const QString &query, int limit) const
+{
+    auto tokens = tokenize(query);
+    if (tokens.isEmpty())
+        return {};
+
+    // Walk the postings of the longest word, it is the most selective one
+    std::sort(tokens.begin(), tokens.end(),
+              [] (const QString &lhs, const QString &rhs) { return lhs.size() > rhs.size(); });
+    const auto key = tokens.takeFirst();
+
+    QReadLocker locker(&m_lock);
+
+    auto hits = QVector<Hit>();
+    auto seen = QSet<qint64>();
+    for (auto it = m_postings.lowerBound(key); it != m_postings.constEnd() && it.key().startsWith(key); ++it) {
+        if (seen.contains(it.value()))
+            continue;
+        seen.insert(it.value());
+
+        const auto &entry = *m_entries.constFind(it.value());
+        const auto matchesAll = std::all_of(tokens.constBegin(), tokens.constEnd(),
+                                            [&entry] (const QString &token) {
+                                                return std::any_of(entry.tokens.constBegin(), entry.tokens.constEnd(),
+                                                                   [&token] (const QString &word) { return word.startsWith(token); });
+                                            });
+        if (matchesAll)
+            hits.append({it.value(), entry.title});
+    }
+
+    locker.unlock();
+
+    // Titles starting like the query come first
+    const auto prefix = query.trimmed();
+    std::sort(hits.begin(), hits.end(),
+              [&prefix] (const Hit &lhs, const Hit &rhs) {
+                  const auto lhsPrefix = lhs.title.startsWith(prefix, Qt::CaseInsensitive);
+                  const auto rhsPrefix = rhs.title.startsWith(prefix, Qt::CaseInsensitive);
+                  if (lhsPrefix != rhsPrefix)
+                      return lhsPrefix;
+                  return lhs.title.compare(rhs.title, Qt::CaseInsensitive) < 0;
+              });
+
+    if (limit >= 0 && hits.size() > limit)
+        hits.resize(limit);
+
+    return hits;
+}
+
+QStringList TaskSearchIndex::tokenize(const QString &text)
+{
+    auto tokens = QStringList();
+    auto token = QString();
+
+    foreach (const auto &c, text.toCaseFolded()) {
+        if (c.isLetterOrNumber()) {
+            token.append(c);
+        } else if (!token.isEmpty()) {
+            tokens.append(token);
+            token.clear();
+        }
+    }
+
+    if (!token.isEmpty())
+        tokens.append(token);
+
+    tokens.removeDuplicates();
+    return tokens;
+}
+
+void TaskSearchIndex::removeLocked(qint64 id)
+{
+    const auto it = m_entries.find(id);
+    if (it == m_entries.end())
+        return;
+
+    foreach (const auto &token, it->tokens)
+        m_postings.remove(token, id);
+
+    m_entries.erase(it);
+}
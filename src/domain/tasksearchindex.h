@@ -0,0 +1,79 @@
+/* This file is part of Zanshin
+
+   Copyright 2016 Kevin Ottens <ervin@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+#ifndef DOMAIN_TASKSEARCHINDEX_H
+#define DOMAIN_TASKSEARCHINDEX_H
+
+#include <QHash>
+#include <QMultiMap>
+#include <QReadWriteLock>
+#include <QStringList>
+#include <QVector>
+
+#include <QSharedPointer>
+
+namespace Domain {
+
+// Prefix index on the words of task titles, only the titles and the ids
+// given by whoever feeds it are kept. It can be searched from other threads
+// while it gets updated.
+class TaskSearchIndex
+{
+public:
+    typedef QSharedPointer<TaskSearchIndex> Ptr;
+
+    struct Hit
+    {
+        qint64 id;
+        QString title;
+    };
+
+    int count() const;
+
+    // Inserting an id again replaces its title
+    void insert(qint64 id, const QString &title);
+    void remove(qint64 id);
+    void clear();
+
+    // Tasks having, for each word of the query, a word of the title starting with it
+    QVector<Hit> search(const QString &query, int limit = -1) const;
+
+    static QStringList tokenize(const QString &text);
+
+private:
+    struct Entry
+    {
+        QString title;
+        QStringList tokens;
+    };
+    void removeLocked(qint64 id);
+
+    mutable QReadWriteLock m_lock;
+    QHash<qint64, Entry> m_entries;
+    QMultiMap<QString, qint64> m_postings; // ids by token
+};
+
+}
+
+#endif // DOMAIN_TASKSEARCHINDEX_H
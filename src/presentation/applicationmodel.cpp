@@ -93,14 +93,16 @@ void ApplicationModel::setCurrentPage(QObject *page)
     if (page == m_currentPage)
         return;
 
-    m_currentPage = QObjectPtr(page);
+    // Reuse the reference of a page already shared, by a page cache for instance
+    auto pageModel = qobject_cast<PageModel*>(page);
+    const auto sharedPage = pageModel ? pageModel->sharedFromThis() : QSharedPointer<PageModel>();
+    m_currentPage = sharedPage ? sharedPage.staticCast<QObject>() : QObjectPtr(page);
 
     if (m_currentPage) {
         m_currentPage->setParent(Q_NULLPTR);
 
-        auto pageModel = m_currentPage.staticCast<PageModel>();
-        Q_ASSERT(pageModel);
-        pageModel->setErrorHandler(errorHandler());
+        if (pageModel)
+            pageModel->setErrorHandler(errorHandler());
     }
 
     emit currentPageChanged(page);
@@ -115,6 +117,6 @@ void ApplicationModel::setErrorHandler(ErrorHandler *errorHandler)
         m_availablePages.staticCast<AvailablePagesModelInterface>()->setErrorHandler(errorHandler);
     if (m_editor)
         m_editor.staticCast<ArtifactEditorModel>()->setErrorHandler(errorHandler);
-    if (m_currentPage)
-        m_currentPage.staticCast<PageModel>()->setErrorHandler(errorHandler);
+    if (auto pageModel = qobject_cast<PageModel*>(m_currentPage.data()))
+        pageModel->setErrorHandler(errorHandler);
 }
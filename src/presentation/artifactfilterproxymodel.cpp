@@ -26,7 +26,8 @@
 
 #include <limits>
 
-#include "domain/artifact.h"
+#include <QtEndian>
+
 #include "domain/task.h"
 
 #include "presentation/querytreemodelbase.h"
@@ -36,11 +37,19 @@ using namespace Presentation;
 ArtifactFilterProxyModel::ArtifactFilterProxyModel(QObject *parent)
     : QSortFilterProxyModel(parent),
       m_sortType(TitleSort),
-      m_showFuture(false)
+      m_sortOrder(Qt::AscendingOrder),
+      m_showFuture(false),
+      m_textIndexRevision(0),
+      m_matchesValid(false),
+      m_matchedShowFuture(false)
 {
-    setDynamicSortFilter(true);
+    // Changed rows are sorted and filtered again only
+    // if their key or their visibility changed, new rows
+    // are sorted again only if they're out of place
+    setDynamicSortFilter(false);
     setSortCaseSensitivity(Qt::CaseInsensitive);
-    setSortOrder(Qt::AscendingOrder);
+    m_collator.setCaseSensitivity(Qt::CaseInsensitive);
+    updateSorting();
 }
 
 ArtifactFilterProxyModel::SortType ArtifactFilterProxyModel::sortType() const
@@ -51,12 +60,14 @@ ArtifactFilterProxyModel::SortType ArtifactFilterProxyModel::sortType() const
 void ArtifactFilterProxyModel::setSortType(ArtifactFilterProxyModel::SortType type)
 {
     m_sortType = type;
-    invalidate();
+    m_sortKeys.clear();
+    updateSorting();
 }
 
 void ArtifactFilterProxyModel::setSortOrder(Qt::SortOrder order)
 {
-    sort(0, order);
+    m_sortOrder = order;
+    updateSorting();
 }
 
 bool ArtifactFilterProxyModel::showFutureTasks() const
@@ -73,6 +84,45 @@ void ArtifactFilterProxyModel::setShowFutureTasks(bool show)
     invalidate();
 }
 
+void ArtifactFilterProxyModel::setSourceModel(QAbstractItemModel *model)
+{
+    if (sourceModel())
+        disconnect(sourceModel(), Q_NULLPTR, this, Q_NULLPTR);
+
+    // Connected before the base class so that the keys and the text index
+    // are up to date by the time the changed rows get filtered and sorted
+    if (model) {
+        connect(model, &QAbstractItemModel::rowsInserted, this, &ArtifactFilterProxyModel::onSourceRowsInserted);
+        connect(model, &QAbstractItemModel::rowsAboutToBeRemoved, this, &ArtifactFilterProxyModel::onSourceRowsAboutToBeRemoved);
+        connect(model, &QAbstractItemModel::rowsMoved, this, &ArtifactFilterProxyModel::onSourceRowsMoved);
+        connect(model, &QAbstractItemModel::dataChanged, this, &ArtifactFilterProxyModel::onSourceDataChanged);
+        connect(model, &QAbstractItemModel::modelReset, this, &ArtifactFilterProxyModel::onSourceReset);
+        connect(model, &QAbstractItemModel::layoutChanged, this, &ArtifactFilterProxyModel::onSourceReset);
+    }
+
+    QSortFilterProxyModel::setSourceModel(model);
+
+    // Connected after the base class so that the new rows are already mapped
+    if (model)
+        connect(model, &QAbstractItemModel::rowsInserted, this, &ArtifactFilterProxyModel::sortInsertedRows);
+
+    onSourceReset();
+    updateSorting();
+}
+
+void ArtifactFilterProxyModel::updateSorting()
+{
+    // A source already ordered by title is shown in its own order, a row
+    // then moves by itself when its title changes instead of sorting again
+    const auto queryModel = qobject_cast<QueryTreeModelBase*>(sourceModel());
+    if (m_sortType == TitleSort && m_sortOrder == Qt::AscendingOrder
+     && queryModel && queryModel->isSortedByTitle()) {
+        sort(-1, m_sortOrder);
+    } else {
+        sort(0, m_sortOrder);
+    }
+}
+
 static bool isFutureTask(const Domain::Artifact::Ptr &artifact)
 {
     auto task = artifact.objectCast<Domain::Task>();
@@ -85,10 +135,312 @@ static bool isFutureTask(const Domain::Artifact::Ptr &artifact)
     return task->startDate() > QDateTime::currentDateTime();
 }
 
+ArtifactTextIndex ArtifactFilterProxyModel::textIndex() const
+{
+    return m_textIndex;
+}
+
+int ArtifactFilterProxyModel::textIndexRevision() const
+{
+    return m_textIndexRevision;
+}
+
+void ArtifactFilterProxyModel::setFilterMatches(const QString &text, const QList<Domain::Artifact::Ptr> &matches, int revision)
+{
+    // Outdated, the matches have to be found again
+    if (revision != m_textIndexRevision) {
+        setFilterFixedString(text);
+        return;
+    }
+
+    m_matchedPattern = text;
+    m_matchedShowFuture = m_showFuture;
+    m_acceptedArtifacts.clear();
+
+    for (const auto &artifact : matches) {
+        if (m_matchedShowFuture || !isFutureTask(artifact))
+            acceptWithAncestors(artifact);
+    }
+
+    m_matchesValid = true;
+    setFilterFixedString(text);
+}
+
+void ArtifactFilterProxyModel::onSourceRowsInserted(const QModelIndex &parent, int first, int last)
+{
+    m_textIndexRevision++;
+    indexRows(parent, first, last);
+}
+
+void ArtifactFilterProxyModel::sortInsertedRows(const QModelIndex &parent, int first, int last)
+{
+    if (sortColumn() < 0)
+        return;
+
+    // Without dynamic sorting new rows get placed following the source order,
+    // the rows are sorted again only if some of them ended up out of place
+    for (int row = first; row <= last; row++) {
+        if (!isInPlace(sourceModel()->index(row, sortColumn(), parent))) {
+            sort(sortColumn(), sortOrder());
+            return;
+        }
+    }
+}
+
+void ArtifactFilterProxyModel::onSourceRowsAboutToBeRemoved(const QModelIndex &parent, int first, int last)
+{
+    m_textIndexRevision++;
+    unindexRows(parent, first, last);
+}
+
+void ArtifactFilterProxyModel::onSourceRowsMoved(const QModelIndex &parent, int start, int end,
+                                                 const QModelIndex &destination, int row)
+{
+    // Rows moving within their parent come from a source sorted by title,
+    // their title changed so their keys are outdated
+    const int count = end - start + 1;
+    if (destination == parent) {
+        const int first = row > end ? row - count : row;
+        for (int i = first; i < first + count; i++) {
+            const auto artifact = artifactForIndex(sourceModel()->index(i, 0, destination));
+            if (artifact)
+                m_sortKeys.remove(artifact.data());
+        }
+        return;
+    }
+
+    m_textIndexRevision++;
+
+    // Only the moved rows got a new parent, their children follow them
+    const auto destinationArtifact = nearestArtifact(destination);
+    for (int i = row; i < row + count; i++) {
+        const auto artifact = artifactForIndex(sourceModel()->index(i, 0, destination));
+        if (artifact) {
+            m_sortKeys.remove(artifact.data());
+            m_parentArtifacts.insert(artifact.data(), destinationArtifact);
+        }
+    }
+
+    m_matchesValid = false;
+}
+
+void ArtifactFilterProxyModel::onSourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles)
+{
+    // Keys, text and dates all come from the object
+    if (!roles.isEmpty() && !roles.contains(QueryTreeModelBase::ObjectRole))
+        return;
+
+    // Following the source order, nothing to sort
+    const bool sorting = sortColumn() >= 0;
+
+    bool sortChanged = false;
+    const bool matchesWereValid = m_matchesValid;
+    const int acceptedCount = m_acceptedArtifacts.size();
+
+    for (int row = topLeft.row(); row <= bottomRight.row(); row++) {
+        const auto artifact = artifactForIndex(topLeft.sibling(row, 0));
+        if (!artifact) {
+            sortChanged = sorting;
+            continue;
+        }
+
+        // Without a cached key the row wasn't compared to any other yet
+        const auto it = m_sortKeys.constFind(artifact.data());
+        if (sorting && it != m_sortKeys.constEnd() && it->artifact == artifact) {
+            const SortKey oldKey = *it;
+            m_sortKeys.remove(artifact.data());
+            const SortKey newKey = sortKey(artifact);
+            if (isSortKeyLess(oldKey, newKey) || isSortKeyLess(newKey, oldKey))
+                sortChanged = true;
+        } else {
+            m_sortKeys.remove(artifact.data());
+            if (sorting && sourceModel()->rowCount(topLeft.parent()) > 1)
+                sortChanged = true;
+        }
+
+        m_textIndex.insert(artifact);
+        m_textIndexRevision++;
+
+        if (!m_matchesValid)
+            continue;
+
+        if (isVisibleMatch(artifact))
+            acceptWithAncestors(artifact);
+        else if (m_acceptedArtifacts.contains(artifact.data()))
+            m_matchesValid = false;
+    }
+
+    bool filterChanged = (matchesWereValid && !m_matchesValid)
+                      || m_acceptedArtifacts.size() != acceptedCount;
+    for (int row = topLeft.row(); !filterChanged && row <= bottomRight.row(); row++)
+        filterChanged = hasFilterChanged(topLeft.sibling(row, 0));
+
+    if (filterChanged)
+        invalidateFilter();
+
+    // Sorted again only if a changed row ended up out of place
+    for (int row = topLeft.row(); sortChanged && row <= bottomRight.row(); row++) {
+        if (!isInPlace(topLeft.sibling(row, sortColumn()))) {
+            sort(sortColumn(), sortOrder());
+            return;
+        }
+    }
+}
+
+void ArtifactFilterProxyModel::onSourceReset()
+{
+    m_sortKeys.clear();
+    m_textIndex.clear();
+    m_parentArtifacts.clear();
+    m_matchesValid = false;
+    m_textIndexRevision++;
+
+    if (sourceModel())
+        indexRows(QModelIndex(), 0, sourceModel()->rowCount() - 1);
+}
+
+bool ArtifactFilterProxyModel::hasFilterChanged(const QModelIndex &index) const
+{
+    // A row changing can show or hide its ancestors as well
+    for (auto current = index; current.isValid(); current = current.parent()) {
+        const bool accepted = filterAcceptsRow(current.row(), current.parent());
+        const bool shown = mapFromSource(current).isValid();
+        if (accepted != shown)
+            return true;
+    }
+    return false;
+}
+
+bool ArtifactFilterProxyModel::isInPlace(const QModelIndex &sourceIndex) const
+{
+    const auto proxyIndex = mapFromSource(sourceIndex);
+    if (!proxyIndex.isValid())
+        return true;
+
+    const auto previous = proxyIndex.sibling(proxyIndex.row() - 1, proxyIndex.column());
+    const auto next = proxyIndex.sibling(proxyIndex.row() + 1, proxyIndex.column());
+    return (!previous.isValid() || isInOrder(previous, proxyIndex))
+        && (!next.isValid() || isInOrder(proxyIndex, next));
+}
+
+bool ArtifactFilterProxyModel::isInOrder(const QModelIndex &first, const QModelIndex &second) const
+{
+    const auto sourceFirst = mapToSource(first);
+    const auto sourceSecond = mapToSource(second);
+    return sortOrder() == Qt::AscendingOrder ? !lessThan(sourceSecond, sourceFirst)
+                                             : !lessThan(sourceFirst, sourceSecond);
+}
+
+Domain::Artifact::Ptr ArtifactFilterProxyModel::artifactForIndex(const QModelIndex &index) const
+{
+    return index.data(QueryTreeModelBase::ObjectRole).value<Domain::Artifact::Ptr>();
+}
+
+const Domain::Artifact *ArtifactFilterProxyModel::nearestArtifact(const QModelIndex &index) const
+{
+    for (auto current = index; current.isValid(); current = current.parent()) {
+        const auto artifact = artifactForIndex(current);
+        if (artifact)
+            return artifact.data();
+    }
+    return Q_NULLPTR;
+}
+
+void ArtifactFilterProxyModel::indexRows(const QModelIndex &parent, int first, int last)
+{
+    for (int row = first; row <= last; row++) {
+        const auto index = sourceModel()->index(row, 0, parent);
+        const auto artifact = artifactForIndex(index);
+        if (artifact) {
+            m_textIndex.insert(artifact);
+            m_parentArtifacts.insert(artifact.data(), nearestArtifact(parent));
+
+            if (m_matchesValid && isVisibleMatch(artifact))
+                acceptWithAncestors(artifact);
+        }
+
+        const int childCount = sourceModel()->rowCount(index);
+        if (childCount > 0)
+            indexRows(index, 0, childCount - 1);
+    }
+}
+
+void ArtifactFilterProxyModel::unindexRows(const QModelIndex &parent, int first, int last)
+{
+    for (int row = first; row <= last; row++) {
+        const auto index = sourceModel()->index(row, 0, parent);
+
+        const int childCount = sourceModel()->rowCount(index);
+        if (childCount > 0)
+            unindexRows(index, 0, childCount - 1);
+
+        const auto artifact = artifactForIndex(index);
+        if (!artifact)
+            continue;
+
+        m_sortKeys.remove(artifact.data());
+        m_textIndex.remove(artifact);
+        m_parentArtifacts.remove(artifact.data());
+        if (m_acceptedArtifacts.remove(artifact.data()))
+            m_matchesValid = false;
+    }
+}
+
+bool ArtifactFilterProxyModel::isVisibleMatch(const Domain::Artifact::Ptr &artifact) const
+{
+    return m_textIndex.matches(artifact, m_matchedPattern)
+        && (m_matchedShowFuture || !isFutureTask(artifact));
+}
+
+void ArtifactFilterProxyModel::acceptWithAncestors(const Domain::Artifact::Ptr &artifact) const
+{
+    m_acceptedArtifacts.insert(artifact.data());
+
+    // A matching ancestor hidden because it is in the future
+    // hides everything below it
+    auto ancestor = m_parentArtifacts.value(artifact.data());
+    while (ancestor && !m_acceptedArtifacts.contains(ancestor)) {
+        const auto ancestorPtr = m_textIndex.artifact(ancestor);
+        if (m_textIndex.matches(ancestorPtr, m_matchedPattern) && !isVisibleMatch(ancestorPtr))
+            break;
+
+        m_acceptedArtifacts.insert(ancestor);
+        ancestor = m_parentArtifacts.value(ancestor);
+    }
+}
+
+void ArtifactFilterProxyModel::updateMatches() const
+{
+    const auto pattern = filterRegExp().pattern();
+    if (m_matchesValid && m_matchedPattern == pattern && m_matchedShowFuture == m_showFuture)
+        return;
+
+    m_matchedPattern = pattern;
+    m_matchedShowFuture = m_showFuture;
+    m_acceptedArtifacts.clear();
+
+    for (const auto &artifact : m_textIndex.find(pattern)) {
+        if (m_matchedShowFuture || !isFutureTask(artifact))
+            acceptWithAncestors(artifact);
+    }
+
+    m_matchesValid = true;
+}
+
 bool ArtifactFilterProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const
 {
     const QModelIndex index = sourceModel()->index(sourceRow, 0, sourceParent);
-    const auto artifact = index.data(QueryTreeModelBase::ObjectRole).value<Domain::Artifact::Ptr>();
+    const auto artifact = artifactForIndex(index);
+
+    if (artifact && filterRegExp().patternSyntax() == QRegExp::FixedString
+     && m_textIndex.contains(artifact)) {
+        if (filterRegExp().isEmpty())
+            return m_showFuture || !isFutureTask(artifact);
+
+        updateMatches();
+        return m_acceptedArtifacts.contains(artifact.data());
+    }
+
     if (artifact) {
         QRegExp regexp = filterRegExp();
         regexp.setCaseSensitivity(Qt::CaseInsensitive);
@@ -107,31 +459,78 @@ bool ArtifactFilterProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex
     return QSortFilterProxyModel::filterAcceptsRow(sourceRow, sourceParent);
 }
 
-static QDateTime validDt(const QDateTime &date = QDateTime())
+static void appendSortValue(QByteArray &key, quint64 value)
 {
+    const quint64 bigEndian = qToBigEndian(value);
+    key.append(reinterpret_cast<const char*>(&bigEndian), sizeof(bigEndian));
+}
+
+static quint64 dateSortValue(const QDateTime &date)
+{
+    // Flipping the sign bit keeps dates before the epoch in order,
+    // dates not set go after any valid one
     if (date.isValid())
-        return date;
+        return quint64(date.toMSecsSinceEpoch()) ^ (Q_UINT64_C(1) << 63);
+    else
+        return std::numeric_limits<quint64>::max() - 1;
+}
 
-    return QDateTime::fromTime_t(std::numeric_limits<uint>::max() - 1);
+ArtifactFilterProxyModel::SortKey ArtifactFilterProxyModel::sortKey(const Domain::Artifact::Ptr &artifact) const
+{
+    auto it = m_sortKeys.find(artifact.data());
+    if (it != m_sortKeys.end() && it->artifact == artifact)
+        return *it;
+
+    QByteArray dates;
+    if (m_sortType == DateSort) {
+        // Earliest date first, then due date over start date,
+        // anything which is not a task goes last
+        const auto task = artifact.objectCast<Domain::Task>();
+        const quint64 due = task ? dateSortValue(task->dueDate()) : std::numeric_limits<quint64>::max();
+        const quint64 start = task ? dateSortValue(task->startDate()) : std::numeric_limits<quint64>::max();
+        dates.reserve(3 * sizeof(quint64));
+        appendSortValue(dates, qMin(due, start));
+        appendSortValue(dates, due);
+        appendSortValue(dates, start);
+    }
+
+    // Don't let keys of artifacts gone for good pile up
+    if (it == m_sortKeys.end() && m_sortKeys.size() > 2 * sourceModel()->rowCount() + 1024) {
+        for (auto keyIt = m_sortKeys.begin(); keyIt != m_sortKeys.end();) {
+            if (keyIt->artifact.isNull())
+                keyIt = m_sortKeys.erase(keyIt);
+            else
+                ++keyIt;
+        }
+    }
+
+    const SortKey key = {artifact.toWeakRef(), dates, m_collator.sortKey(artifact->title())};
+    m_sortKeys.insert(artifact.data(), key);
+    return key;
 }
 
-bool ArtifactFilterProxyModel::lessThan(const QModelIndex &left, const QModelIndex &right) const
+bool ArtifactFilterProxyModel::isSortKeyLess(const SortKey &left, const SortKey &right) const
 {
-    if (m_sortType != DateSort)
-        return QSortFilterProxyModel::lessThan(left, right);
+    if (m_sortType == DateSort)
+        return left.dates < right.dates;
+    else
+        return left.title.compare(right.title) < 0;
+}
 
+bool ArtifactFilterProxyModel::lessThan(const QModelIndex &left, const QModelIndex &right) const
+{
     const auto leftArtifact = left.data(QueryTreeModelBase::ObjectRole).value<Domain::Artifact::Ptr>();
     const auto rightArtifact = right.data(QueryTreeModelBase::ObjectRole).value<Domain::Artifact::Ptr>();
 
-    const auto leftTask = leftArtifact.objectCast<Domain::Task>();
-    const auto rightTask = rightArtifact.objectCast<Domain::Task>();
-
-    const QDateTime leftDue = leftTask ? validDt(leftTask->dueDate()) : validDt().addSecs(1);
-    const QDateTime rightDue = rightTask ? validDt(rightTask->dueDate()) : validDt().addSecs(1);
+    if (m_sortType != DateSort && (!leftArtifact || !rightArtifact))
+        return QSortFilterProxyModel::lessThan(left, right);
 
-    const QDateTime leftStart = leftTask ? validDt(leftTask->startDate()) : validDt().addSecs(1);
-    const QDateTime rightStart = rightTask ? validDt(rightTask->startDate()) : validDt().addSecs(1);
+    if (leftArtifact && rightArtifact)
+        return isSortKeyLess(sortKey(leftArtifact), sortKey(rightArtifact));
 
-    return leftDue < rightDue
-        || leftStart < rightStart;
+    // Rows without artifact go last, like anything which is not a task
+    const QByteArray noArtifactDates(3 * sizeof(quint64), char(0xff));
+    const QByteArray leftDates = leftArtifact ? sortKey(leftArtifact).dates : noArtifactDates;
+    const QByteArray rightDates = rightArtifact ? sortKey(rightArtifact).dates : noArtifactDates;
+    return leftDates < rightDates;
 }
@@ -25,8 +25,15 @@
 #ifndef PRESENTATION_ARTIFACTFILTERPROXYMODEL_H
 #define PRESENTATION_ARTIFACTFILTERPROXYMODEL_H
 
+#include <QCollator>
+#include <QHash>
+#include <QSet>
 #include <QSortFilterProxyModel>
 
+#include "domain/artifact.h"
+
+#include "presentation/artifacttextindex.h"
+
 namespace Presentation {
 
 class ArtifactFilterProxyModel : public QSortFilterProxyModel
@@ -49,13 +56,67 @@ public:
     bool showFutureTasks() const;
     void setShowFutureTasks(bool show);
 
+    void setSourceModel(QAbstractItemModel *model) Q_DECL_OVERRIDE;
+
+    // Allows to search somewhere else, the matches found can then be applied
+    // as long as the index didn't change since the snapshot got taken
+    ArtifactTextIndex textIndex() const;
+    int textIndexRevision() const;
+    void setFilterMatches(const QString &text, const QList<Domain::Artifact::Ptr> &matches, int revision);
+
 protected:
     bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const Q_DECL_OVERRIDE;
     bool lessThan(const QModelIndex &left, const QModelIndex &right) const Q_DECL_OVERRIDE;
 
+private slots:
+    void onSourceRowsInserted(const QModelIndex &parent, int first, int last);
+    void sortInsertedRows(const QModelIndex &parent, int first, int last);
+    void onSourceRowsAboutToBeRemoved(const QModelIndex &parent, int first, int last);
+    void onSourceRowsMoved(const QModelIndex &parent, int start, int end,
+                           const QModelIndex &destination, int row);
+    void onSourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles);
+    void onSourceReset();
+
 private:
+    // Keys are computed once per artifact instead of for each comparison,
+    // the weak pointer tells if the address got reused by another artifact
+    struct SortKey {
+        QWeakPointer<Domain::Artifact> artifact;
+        QByteArray dates;
+        QCollatorSortKey title;
+    };
+
+    SortKey sortKey(const Domain::Artifact::Ptr &artifact) const;
+    bool isSortKeyLess(const SortKey &left, const SortKey &right) const;
+
+    void updateSorting();
+    bool hasFilterChanged(const QModelIndex &index) const;
+    bool isInPlace(const QModelIndex &sourceIndex) const;
+    bool isInOrder(const QModelIndex &first, const QModelIndex &second) const;
+    Domain::Artifact::Ptr artifactForIndex(const QModelIndex &index) const;
+    const Domain::Artifact *nearestArtifact(const QModelIndex &index) const;
+    void indexRows(const QModelIndex &parent, int first, int last);
+    void unindexRows(const QModelIndex &parent, int first, int last);
+    bool isVisibleMatch(const Domain::Artifact::Ptr &artifact) const;
+    void acceptWithAncestors(const Domain::Artifact::Ptr &artifact) const;
+    void updateMatches() const;
+
     SortType m_sortType;
+    Qt::SortOrder m_sortOrder;
     bool m_showFuture;
+
+    QCollator m_collator;
+    mutable QHash<const Domain::Artifact*, SortKey> m_sortKeys;
+
+    // Filtering is a lookup in the text index, the rows to keep being the
+    // matches and their ancestors, kept up to date as the source changes
+    ArtifactTextIndex m_textIndex;
+    int m_textIndexRevision;
+    QHash<const Domain::Artifact*, const Domain::Artifact*> m_parentArtifacts;
+    mutable bool m_matchesValid;
+    mutable QString m_matchedPattern;
+    mutable bool m_matchedShowFuture;
+    mutable QSet<const Domain::Artifact*> m_acceptedArtifacts;
 };
 
 }
@@ -0,0 +1,160 @@
+/* This file is part of Zanshin
+
+   Copyright 2016 Kevin Ottens <ervin@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+#include "artifactsearch.h"
+
+#include <QRunnable>
+#include <QScopedPointer>
+#include <QThreadPool>
+
+namespace Presentation {
+
+class ArtifactSearchRunnable : public QRunnable
+{
+public:
+    explicit ArtifactSearchRunnable(const QSharedPointer<ArtifactSearchState> &state)
+        : m_state(state)
+    {
+        // Owned by the state, which can outlive the pool's use of us
+        setAutoDelete(false);
+    }
+
+    void run() Q_DECL_OVERRIDE;
+
+    // When taken out of the pool before running, otherwise
+    // we'd keep the state alive forever
+    void release()
+    {
+        m_state.clear();
+    }
+
+private:
+    QSharedPointer<ArtifactSearchState> m_state;
+};
+
+// What the worker works on, shared with the search which can go away
+// without waiting for the worker, the last one done with it frees it
+// with deleteLater() so that it's always deleted in the search's thread
+class ArtifactSearchState : public QObject
+{
+    Q_OBJECT
+public:
+    ArtifactSearchState(const ArtifactTextIndex &index, const QString &text)
+        : index(index),
+          text(text),
+          canceled(0)
+    {
+    }
+
+    const ArtifactTextIndex index;
+    const QString text;
+    QAtomicInt canceled;
+    QList<Domain::Artifact::Ptr> matches;
+    QScopedPointer<ArtifactSearchRunnable> runnable;
+
+signals:
+    void done();
+};
+
+void ArtifactSearchRunnable::run()
+{
+    // Our reference is dropped once we're done, which frees
+    // the state and us along with it if the search is gone
+    QSharedPointer<ArtifactSearchState> state;
+    state.swap(m_state);
+
+    state->matches = state->index.find(state->text,
+                                       ArtifactTextIndex::Title | ArtifactTextIndex::Text,
+                                       &state->canceled);
+
+    // Delivered before the state gets deleted, and only
+    // if the search is still connected to it
+    QMetaObject::invokeMethod(state.data(), "done", Qt::QueuedConnection);
+}
+
+}
+
+using namespace Presentation;
+
+ArtifactSearch::ArtifactSearch(const ArtifactTextIndex &index, const QString &text, QObject *parent)
+    : QObject(parent),
+      m_state(new ArtifactSearchState(index, text), &QObject::deleteLater),
+      m_started(false),
+      m_finished(false)
+{
+    connect(m_state.data(), &ArtifactSearchState::done, this, &ArtifactSearch::onWorkerDone);
+}
+
+ArtifactSearch::~ArtifactSearch()
+{
+    cancel();
+
+    // A worker still waiting in the pool is dropped, a running one
+    // stops early and frees the state on its own, we never wait for it
+    if (m_started && QThreadPool::globalInstance()->tryTake(m_state->runnable.data()))
+        m_state->runnable->release();
+}
+
+QString ArtifactSearch::text() const
+{
+    return m_state->text;
+}
+
+bool ArtifactSearch::isFinished() const
+{
+    return m_finished;
+}
+
+bool ArtifactSearch::isCanceled() const
+{
+    return m_state->canceled.loadAcquire();
+}
+
+QList<Domain::Artifact::Ptr> ArtifactSearch::matches() const
+{
+    return m_finished ? m_state->matches : QList<Domain::Artifact::Ptr>();
+}
+
+void ArtifactSearch::start()
+{
+    Q_ASSERT(!m_started);
+    m_started = true;
+    m_state->runnable.reset(new ArtifactSearchRunnable(m_state));
+    QThreadPool::globalInstance()->start(m_state->runnable.data());
+}
+
+void ArtifactSearch::cancel()
+{
+    m_state->canceled.storeRelease(1);
+}
+
+void ArtifactSearch::onWorkerDone()
+{
+    if (isCanceled())
+        return;
+
+    m_finished = true;
+    emit finished();
+}
+
+#include "artifactsearch.moc"
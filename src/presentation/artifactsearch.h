@@ -0,0 +1,67 @@
+/* This file is part of Zanshin
+
+   Copyright 2016 Kevin Ottens <ervin@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+#ifndef PRESENTATION_ARTIFACTSEARCH_H
+#define PRESENTATION_ARTIFACTSEARCH_H
+
+#include <QObject>
+#include <QSharedPointer>
+
+#include "presentation/artifacttextindex.h"
+
+namespace Presentation {
+
+class ArtifactSearchState;
+
+// Looks for the artifacts matching a text in a snapshot of a text index
+// on a worker thread, so that the caller's thread never waits on it
+class ArtifactSearch : public QObject
+{
+    Q_OBJECT
+public:
+    ArtifactSearch(const ArtifactTextIndex &index, const QString &text, QObject *parent = Q_NULLPTR);
+    ~ArtifactSearch();
+
+    QString text() const;
+    bool isFinished() const;
+    bool isCanceled() const;
+    QList<Domain::Artifact::Ptr> matches() const;
+
+    void start();
+    void cancel();
+
+signals:
+    void finished();
+
+private slots:
+    void onWorkerDone();
+
+private:
+    QSharedPointer<ArtifactSearchState> m_state;
+    bool m_started;
+    bool m_finished;
+};
+
+}
+
+#endif // PRESENTATION_ARTIFACTSEARCH_H
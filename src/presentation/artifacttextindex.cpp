@@ -0,0 +1,192 @@
+/* This file is part of Zanshin
+
+   Copyright 2016 Kevin Ottens <ervin@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+#include "artifacttextindex.h"
+
+#include <algorithm>
+
+using namespace Presentation;
+
+int ArtifactTextIndex::size() const
+{
+    return m_documents.size();
+}
+
+bool ArtifactTextIndex::contains(const Domain::Artifact::Ptr &artifact) const
+{
+    return m_documents.contains(artifact.data());
+}
+
+Domain::Artifact::Ptr ArtifactTextIndex::artifact(const Domain::Artifact *artifact) const
+{
+    const auto it = m_documents.constFind(artifact);
+    return it != m_documents.constEnd() ? it->artifact : Domain::Artifact::Ptr();
+}
+
+void ArtifactTextIndex::insert(const Domain::Artifact::Ptr &artifact)
+{
+    remove(artifact);
+
+    Document document;
+    document.artifact = artifact;
+    document.title = artifact->title().toCaseFolded();
+    document.text = artifact->text().toCaseFolded();
+    document.trigrams = trigrams(document.title, Title) + trigrams(document.text, Text);
+    std::sort(document.trigrams.begin(), document.trigrams.end());
+    document.trigrams.erase(std::unique(document.trigrams.begin(), document.trigrams.end()),
+                            document.trigrams.end());
+
+    for (const auto trigram : document.trigrams)
+        m_postings[trigram].insert(artifact.data());
+
+    m_documents.insert(artifact.data(), document);
+}
+
+void ArtifactTextIndex::remove(const Domain::Artifact::Ptr &artifact)
+{
+    const auto it = m_documents.find(artifact.data());
+    if (it == m_documents.end())
+        return;
+
+    for (const auto trigram : it->trigrams) {
+        auto posting = m_postings.find(trigram);
+        posting->remove(artifact.data());
+        if (posting->isEmpty())
+            m_postings.erase(posting);
+    }
+
+    m_documents.erase(it);
+}
+
+void ArtifactTextIndex::clear()
+{
+    m_documents.clear();
+    m_postings.clear();
+}
+
+static bool isCanceled(const QAtomicInt *canceled, int iteration)
+{
+    return canceled && (iteration % 256) == 0 && canceled->loadAcquire();
+}
+
+QList<Domain::Artifact::Ptr> ArtifactTextIndex::find(const QString &text, Fields fields,
+                                                     const QAtomicInt *canceled) const
+{
+    const auto foldedText = text.toCaseFolded();
+    QList<Domain::Artifact::Ptr> result;
+    int iteration = 0;
+
+    // Too short to have trigrams, only a scan can tell
+    if (foldedText.size() < 3) {
+        for (const auto &document : m_documents) {
+            if (isCanceled(canceled, iteration++))
+                return QList<Domain::Artifact::Ptr>();
+
+            if (matches(document, foldedText, fields))
+                result << document.artifact;
+        }
+        return result;
+    }
+
+    QSet<const Domain::Artifact*> candidates;
+    for (const auto field : {Title, Text}) {
+        if (!fields.testFlag(field))
+            continue;
+
+        // Walk the shortest posting list and check the others for each entry
+        QVector<const QSet<const Domain::Artifact*>*> postings;
+        bool missingTrigram = false;
+        for (const auto trigram : trigrams(foldedText, field)) {
+            const auto it = m_postings.constFind(trigram);
+            if (it == m_postings.constEnd()) {
+                missingTrigram = true;
+                break;
+            }
+            postings << &it.value();
+        }
+
+        if (missingTrigram)
+            continue;
+
+        std::sort(postings.begin(), postings.end(),
+                  [] (const QSet<const Domain::Artifact*> *left, const QSet<const Domain::Artifact*> *right) {
+                      return left->size() < right->size();
+                  });
+
+        for (const auto artifact : *postings.first()) {
+            if (isCanceled(canceled, iteration++))
+                return QList<Domain::Artifact::Ptr>();
+
+            if (candidates.contains(artifact))
+                continue;
+
+            const bool inAllPostings = std::all_of(postings.constBegin() + 1, postings.constEnd(),
+                                                   [artifact] (const QSet<const Domain::Artifact*> *posting) {
+                                                       return posting->contains(artifact);
+                                                   });
+            if (!inAllPostings)
+                continue;
+
+            // Trigrams can be spread around, check the actual substring
+            const auto &document = *m_documents.constFind(artifact);
+            if (matches(document, foldedText, field)) {
+                candidates.insert(artifact);
+                result << document.artifact;
+            }
+        }
+    }
+
+    return result;
+}
+
+bool ArtifactTextIndex::matches(const Domain::Artifact::Ptr &artifact, const QString &text, Fields fields) const
+{
+    const auto it = m_documents.constFind(artifact.data());
+    if (it == m_documents.constEnd())
+        return false;
+
+    return matches(*it, text.toCaseFolded(), fields);
+}
+
+QVector<quint64> ArtifactTextIndex::trigrams(const QString &foldedText, Field field)
+{
+    QVector<quint64> result;
+    if (foldedText.size() < 3)
+        return result;
+
+    result.reserve(foldedText.size() - 2);
+    const auto data = foldedText.constData();
+    for (int i = 0; i + 2 < foldedText.size(); i++) {
+        result << ((quint64(field) << 48)
+                 | (quint64(data[i].unicode()) << 32)
+                 | (quint64(data[i + 1].unicode()) << 16)
+                 | quint64(data[i + 2].unicode()));
+    }
+    return result;
+}
+
+bool ArtifactTextIndex::matches(const Document &document, const QString &foldedText, Fields fields)
+{
+    return (fields.testFlag(Title) && document.title.contains(foldedText))
+        || (fields.testFlag(Text) && document.text.contains(foldedText));
+}
@@ -0,0 +1,82 @@
+/* This file is part of Zanshin
+
+   Copyright 2016 Kevin Ottens <ervin@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+#ifndef PRESENTATION_ARTIFACTTEXTINDEX_H
+#define PRESENTATION_ARTIFACTTEXTINDEX_H
+
+#include <QAtomicInt>
+#include <QHash>
+#include <QSet>
+#include <QVector>
+
+#include "domain/artifact.h"
+
+namespace Presentation {
+
+// Trigram index over the title and text of artifacts, answers case
+// insensitive substring searches without scanning every artifact.
+// Copies are cheap and can be searched from another thread.
+class ArtifactTextIndex
+{
+public:
+    enum Field {
+        Title = 0x1,
+        Text = 0x2
+    };
+    Q_DECLARE_FLAGS(Fields, Field)
+
+    int size() const;
+    bool contains(const Domain::Artifact::Ptr &artifact) const;
+    Domain::Artifact::Ptr artifact(const Domain::Artifact *artifact) const;
+
+    // Also used to index again an artifact which changed
+    void insert(const Domain::Artifact::Ptr &artifact);
+    void remove(const Domain::Artifact::Ptr &artifact);
+    void clear();
+
+    // Gives up and returns nothing as soon as canceled is set
+    QList<Domain::Artifact::Ptr> find(const QString &text, Fields fields = Fields(Title | Text),
+                                      const QAtomicInt *canceled = Q_NULLPTR) const;
+    bool matches(const Domain::Artifact::Ptr &artifact, const QString &text, Fields fields = Fields(Title | Text)) const;
+
+private:
+    struct Document
+    {
+        Domain::Artifact::Ptr artifact;
+        QString title;
+        QString text;
+        QVector<quint64> trigrams;
+    };
+
+    static QVector<quint64> trigrams(const QString &foldedText, Field field);
+    static bool matches(const Document &document, const QString &foldedText, Fields fields);
+
+    QHash<const Domain::Artifact*, Document> m_documents;
+    QHash<quint64, QSet<const Domain::Artifact*>> m_postings;
+};
+
+}
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(Presentation::ArtifactTextIndex::Fields)
+
+#endif // PRESENTATION_ARTIFACTTEXTINDEX_H
@@ -85,23 +85,25 @@ QObject *AvailableNotePagesModel::createPageForIndex(const QModelIndex &index)
 {
     QObjectPtr object = index.data(QueryTreeModelBase::ObjectRole).value<QObjectPtr>();
 
-    if (object == m_inboxObject) {
-        auto inboxPageModel = new NoteInboxPageModel(m_noteQueries,
-                                                     m_noteRepository,
-                                                     this);
-        inboxPageModel->setErrorHandler(errorHandler());
-        return inboxPageModel;
-    } else if (auto tag = object.objectCast<Domain::Tag>()) {
-        auto tagPageModel = new TagPageModel(tag,
-                                             m_tagQueries,
-                                             m_tagRepository,
-                                             m_noteRepository,
-                                             this);
-        tagPageModel->setErrorHandler(errorHandler());
-        return tagPageModel;
-    }
+    auto page = m_pageCache.page(object, [this, object]() -> PageModel* {
+        if (object == m_inboxObject) {
+            return new NoteInboxPageModel(m_noteQueries,
+                                          m_noteRepository,
+                                          this);
+        } else if (auto tag = object.objectCast<Domain::Tag>()) {
+            return new TagPageModel(tag,
+                                    m_tagQueries,
+                                    m_tagRepository,
+                                    m_noteRepository,
+                                    this);
+        }
+
+        return Q_NULLPTR;
+    });
 
-    return Q_NULLPTR;
+    if (page)
+        page->setErrorHandler(errorHandler());
+    return page;
 }
 
 void AvailableNotePagesModel::addProject(const QString &, const Domain::DataSource::Ptr &)
@@ -172,10 +174,20 @@ QAbstractItemModel *AvailableNotePagesModel::createPageListModel()
         if (role != Qt::DisplayRole
          && role != Qt::EditRole
          && role != Qt::DecorationRole
-         && role != QueryTreeModelBase::IconNameRole) {
+         && role != QueryTreeModelBase::IconNameRole
+         && role != QueryTreeModelBase::CountRole) {
             return QVariant();
         }
 
+        if (role == QueryTreeModelBase::CountRole) {
+            return m_pageCounters.count(m_pageListModel, object, [this, object] {
+                if (object == m_inboxObject)
+                    return m_noteQueries->countInbox();
+                else
+                    return Domain::Counter::Ptr();
+            });
+        }
+
         if (role == Qt::EditRole
          && (object == m_inboxObject
           || object == m_tagsObject)) {
@@ -33,6 +33,8 @@
 #include "domain/tagrepository.h"
 
 #include "presentation/metatypes.h"
+#include "presentation/pagecounters.h"
+#include "presentation/pagemodelcache.h"
 
 namespace Presentation {
 
@@ -76,6 +78,9 @@ private:
     Domain::QueryResultProvider<QObjectPtr>::Ptr m_rootsProvider;
     QObjectPtr m_inboxObject;
     QObjectPtr m_tagsObject;
+
+    PageModelCache m_pageCache;
+    PageCounters m_pageCounters;
 };
 
 }
@@ -99,39 +99,37 @@ QObject *AvailableTaskPagesModel::createPageForIndex(const QModelIndex &index)
 {
     QObjectPtr object = index.data(QueryTreeModelBase::ObjectRole).value<QObjectPtr>();
 
-    if (object == m_inboxObject) {
-        auto inboxPageModel = new TaskInboxPageModel(m_taskQueries,
-                                                     m_taskRepository,
-                                                     this);
-        inboxPageModel->setErrorHandler(errorHandler());
-        return inboxPageModel;
-    } else if (object == m_workdayObject) {
-        auto workdayPageModel = new WorkdayPageModel(m_taskQueries,
-                                                     m_taskRepository,
-                                                     this);
-        workdayPageModel->setErrorHandler(errorHandler());
-        return workdayPageModel;
-    } else if (auto project = object.objectCast<Domain::Project>()) {
-        auto projectPageModel = new ProjectPageModel(project,
-                                                     m_projectQueries,
-                                                     m_projectRepository,
-                                                     m_taskQueries,
-                                                     m_taskRepository,
-                                                     this);
-        projectPageModel->setErrorHandler(errorHandler());
-        return projectPageModel;
-    } else if (auto context = object.objectCast<Domain::Context>()) {
-        auto contextPageModel = new ContextPageModel(context,
-                                                     m_contextQueries,
-                                                     m_contextRepository,
-                                                     m_taskQueries,
-                                                     m_taskRepository,
-                                                     this);
-        contextPageModel->setErrorHandler(errorHandler());
-        return contextPageModel;
-    }
+    auto page = m_pageCache.page(object, [this, object]() -> PageModel* {
+        if (object == m_inboxObject) {
+            return new TaskInboxPageModel(m_taskQueries,
+                                          m_taskRepository,
+                                          this);
+        } else if (object == m_workdayObject) {
+            return new WorkdayPageModel(m_taskQueries,
+                                        m_taskRepository,
+                                        this);
+        } else if (auto project = object.objectCast<Domain::Project>()) {
+            return new ProjectPageModel(project,
+                                        m_projectQueries,
+                                        m_projectRepository,
+                                        m_taskQueries,
+                                        m_taskRepository,
+                                        this);
+        } else if (auto context = object.objectCast<Domain::Context>()) {
+            return new ContextPageModel(context,
+                                        m_contextQueries,
+                                        m_contextRepository,
+                                        m_taskQueries,
+                                        m_taskRepository,
+                                        this);
+        }
+
+        return Q_NULLPTR;
+    });
 
-    return Q_NULLPTR;
+    if (page)
+        page->setErrorHandler(errorHandler());
+    return page;
 }
 
 void AvailableTaskPagesModel::addProject(const QString &name, const Domain::DataSource::Ptr &source)
@@ -218,10 +216,26 @@ QAbstractItemModel *AvailableTaskPagesModel::createPageListModel()
         if (role != Qt::DisplayRole
          && role != Qt::EditRole
          && role != Qt::DecorationRole
-         && role != QueryTreeModelBase::IconNameRole) {
+         && role != QueryTreeModelBase::IconNameRole
+         && role != QueryTreeModelBase::CountRole) {
             return QVariant();
         }
 
+        if (role == QueryTreeModelBase::CountRole) {
+            return m_pageCounters.count(m_pageListModel, object, [this, object] {
+                if (object == m_inboxObject)
+                    return m_taskQueries->countInboxTopLevel();
+                else if (object == m_workdayObject)
+                    return m_taskQueries->countWorkdayTopLevel();
+                else if (auto project = object.objectCast<Domain::Project>())
+                    return m_projectQueries->countTopLevel(project);
+                else if (auto context = object.objectCast<Domain::Context>())
+                    return m_contextQueries->countTopLevelTasks(context);
+                else
+                    return Domain::Counter::Ptr();
+            });
+        }
+
         if (role == Qt::EditRole
          && (object == m_inboxObject
           || object == m_workdayObject
@@ -287,10 +301,16 @@ QAbstractItemModel *AvailableTaskPagesModel::createPageListModel()
             return false;
 
         if (auto project = object.objectCast<Domain::Project>()) {
-            foreach (const auto &droppedArtifact, droppedArtifacts) {
-                const auto job = m_projectRepository->associate(project, droppedArtifact);
-                installHandler(job, i18n("Cannot add %1 to project %2", droppedArtifact->title(), project->name()));
+            // Several artifacts get their project in a single job
+            if (droppedArtifacts.size() > 1) {
+                const auto job = m_projectRepository->associateArtifacts(project, droppedArtifacts);
+                installHandler(job, i18n("Cannot add items to project %1", project->name()));
+                return true;
             }
+
+            const auto droppedArtifact = droppedArtifacts.first();
+            const auto job = m_projectRepository->associate(project, droppedArtifact);
+            installHandler(job, i18n("Cannot add %1 to project %2", droppedArtifact->title(), project->name()));
             return true;
         } else if (auto context = object.objectCast<Domain::Context>()) {
             if (std::any_of(droppedArtifacts.begin(), droppedArtifacts.end(),
@@ -319,16 +339,22 @@ QAbstractItemModel *AvailableTaskPagesModel::createPageListModel()
             }
             return true;
         } else if (object == m_workdayObject) {
+            auto tasks = Domain::Task::List();
             foreach (const auto &droppedArtifact, droppedArtifacts) {
-
                 if (auto task = droppedArtifact.objectCast<Domain::Task>()) {
-
                     task->setStartDate(Utils::DateTime::currentDateTime());
-                    const auto job = m_taskRepository->update(task);
-
-                    installHandler(job, i18n("Cannot update task %1 to Workday", task->title()));
+                    tasks << task;
                 }
             }
+
+            // Several tasks are updated in a single job
+            if (tasks.size() == 1) {
+                const auto job = m_taskRepository->update(tasks.first());
+                installHandler(job, i18n("Cannot update task %1 to Workday", tasks.first()->title()));
+            } else if (!tasks.isEmpty()) {
+                const auto job = m_taskRepository->updateTasks(tasks);
+                installHandler(job, i18n("Cannot update tasks to Workday"));
+            }
             return true;
         }
 
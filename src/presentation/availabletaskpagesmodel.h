@@ -35,6 +35,8 @@
 #include "domain/taskrepository.h"
 
 #include "presentation/metatypes.h"
+#include "presentation/pagecounters.h"
+#include "presentation/pagemodelcache.h"
 
 class QModelIndex;
 
@@ -86,6 +88,9 @@ private:
     QObjectPtr m_workdayObject;
     QObjectPtr m_projectsObject;
     QObjectPtr m_contextsObject;
+
+    PageModelCache m_pageCache;
+    PageCounters m_pageCounters;
 };
 
 }
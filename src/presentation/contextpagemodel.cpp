@@ -160,6 +160,17 @@ QAbstractItemModel *ContextPageModel::createCentralListModel()
             return false;
         }
 
+        // Several tasks get their new parent in a single job
+        if (parentTask && droppedArtifacts.size() > 1) {
+            auto childTasks = Domain::Task::List();
+            foreach (const auto &droppedArtifact, droppedArtifacts)
+                childTasks << droppedArtifact.staticCast<Domain::Task>();
+
+            const auto job = m_taskRepository->associateTasks(parentTask, childTasks);
+            installHandler(job, i18n("Cannot move tasks as sub-tasks of %1", parentTask->title()));
+            return true;
+        }
+
         using namespace std::placeholders;
         auto associate = std::function<KJob*(Domain::Task::Ptr)>();
         auto dissociate = std::function<KJob*(Domain::Task::Ptr)>();
@@ -203,5 +214,9 @@ QAbstractItemModel *ContextPageModel::createCentralListModel()
         return data;
     };
 
-    return new QueryTreeModel<Domain::Task::Ptr>(query, flags, data, setData, drop, drag, this);
+    auto model = new QueryTreeModel<Domain::Task::Ptr>(query, flags, data, setData, drop, drag, this);
+    model->setIdentityFunction([](const Domain::Task::Ptr &task) { return artifactIdentity(task); });
+    model->setChangedRolesFunction(&PageModel::artifactRoles);
+    model->setSortedByTitle(true);
+    return model;
 }
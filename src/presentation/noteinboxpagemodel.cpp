@@ -121,5 +121,7 @@ QAbstractItemModel *NoteInboxPageModel::createCentralListModel()
         return data;
     };
 
-    return new QueryTreeModel<Domain::Note::Ptr>(query, flags, data, setData, drop, drag, this);
+    auto model = new QueryTreeModel<Domain::Note::Ptr>(query, flags, data, setData, drop, drag, this);
+    model->setSortedByTitle(true);
+    return model;
 }
@@ -0,0 +1,133 @@
+/* This file is part of Zanshin
+
+   Copyright 2016 Kevin Ottens <ervin@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+#include "pagecounters.h"
+
+#include <QAbstractItemModel>
+
+#include "presentation/querytreemodelbase.h"
+
+using namespace Presentation;
+
+QVariant PageCounters::count(QAbstractItemModel *model, const QObjectPtr &object, const CreateFunction &create)
+{
+    watchModel(model);
+
+    auto it = m_entries.find(object.data());
+    if (it != m_entries.end() && it->object == object)
+        return it->counter ? QVariant(it->counter->count()) : QVariant();
+
+    // Counters of objects gone for good can't be asked for anymore
+    for (it = m_entries.begin(); it != m_entries.end();) {
+        if (it->object.isNull())
+            it = m_entries.erase(it);
+        else
+            ++it;
+    }
+
+    for (auto index = m_indexes.begin(); index != m_indexes.end();) {
+        if (!index->isValid())
+            index = m_indexes.erase(index);
+        else
+            ++index;
+    }
+
+    Entry entry;
+    entry.object = object;
+    entry.counter = create();
+    m_entries.insert(object.data(), entry);
+
+    if (!entry.counter)
+        return QVariant();
+
+    // The counter might outlive us, only the model is known for sure
+    // to be around when it notifies
+    QWeakPointer<QObject> weakObject = object;
+    QObject::connect(entry.counter.data(), &Domain::Counter::countChanged, model, [this, model, weakObject] {
+        const auto object = weakObject.toStrongRef();
+        if (!object)
+            return;
+
+        const auto index = indexForObject(object);
+        if (index.isValid())
+            emit model->dataChanged(index, index, {QueryTreeModelBase::CountRole});
+    });
+
+    return entry.counter->count();
+}
+
+void PageCounters::clear()
+{
+    m_entries.clear();
+}
+
+void PageCounters::watchModel(QAbstractItemModel *model)
+{
+    if (m_model == model)
+        return;
+
+    foreach (const auto &connection, m_modelConnections)
+        QObject::disconnect(connection);
+    m_modelConnections.clear();
+    m_indexes.clear();
+
+    m_model = model;
+    if (!model)
+        return;
+
+    m_modelConnections << QObject::connect(model, &QAbstractItemModel::rowsInserted, model,
+                                           [this] (const QModelIndex &parent, int first, int last) {
+                                               addIndexes(parent, first, last);
+                                           });
+    m_modelConnections << QObject::connect(model, &QAbstractItemModel::modelReset, model, [this] {
+        m_indexes.clear();
+        addIndexes(QModelIndex(), 0, m_model->rowCount() - 1);
+    });
+
+    addIndexes(QModelIndex(), 0, model->rowCount() - 1);
+}
+
+void PageCounters::addIndexes(const QModelIndex &parent, int first, int last)
+{
+    // The inserted rows might come with their children already there
+    for (int row = first; row <= last; row++) {
+        const auto index = m_model->index(row, 0, parent);
+        const auto object = index.data(QueryTreeModelBase::ObjectRole).value<QObjectPtr>();
+        if (object)
+            m_indexes.insert(object.data(), index);
+
+        addIndexes(index, 0, m_model->rowCount(index) - 1);
+    }
+}
+
+QModelIndex PageCounters::indexForObject(const QObjectPtr &object) const
+{
+    const QModelIndex index = m_indexes.value(object.data());
+
+    // The row might be gone and another object be at the same address
+    if (!index.isValid() || index.data(QueryTreeModelBase::ObjectRole).value<QObjectPtr>() != object)
+        return QModelIndex();
+
+    return index;
+}
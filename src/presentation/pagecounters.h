@@ -0,0 +1,79 @@
+/* This file is part of Zanshin
+
+   Copyright 2016 Kevin Ottens <ervin@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+#ifndef PRESENTATION_PAGECOUNTERS_H
+#define PRESENTATION_PAGECOUNTERS_H
+
+#include <functional>
+
+#include <QHash>
+#include <QMetaObject>
+#include <QPersistentModelIndex>
+#include <QPointer>
+#include <QVariant>
+
+#include "domain/counter.h"
+
+#include "presentation/metatypes.h"
+
+class QAbstractItemModel;
+class QModelIndex;
+
+namespace Presentation {
+
+// Keeps the counters of the pages listed in a page list model, the
+// model then tells about their changes through CountRole
+class PageCounters
+{
+public:
+    typedef std::function<Domain::Counter::Ptr()> CreateFunction;
+
+    // Returns the count for object, create is used the first time
+    // and might give a null counter for pages without count
+    QVariant count(QAbstractItemModel *model, const QObjectPtr &object, const CreateFunction &create);
+    void clear();
+
+private:
+    struct Entry
+    {
+        QWeakPointer<QObject> object;
+        Domain::Counter::Ptr counter;
+    };
+
+    void watchModel(QAbstractItemModel *model);
+    void addIndexes(const QModelIndex &parent, int first, int last);
+    QModelIndex indexForObject(const QObjectPtr &object) const;
+
+    QHash<QObject*, Entry> m_entries;
+
+    // Where the objects are in the model, learned as rows get inserted
+    // so a count change doesn't need to look for its row
+    QPointer<QAbstractItemModel> m_model;
+    QList<QMetaObject::Connection> m_modelConnections;
+    QHash<QObject*, QPersistentModelIndex> m_indexes;
+};
+
+}
+
+#endif // PRESENTATION_PAGECOUNTERS_H
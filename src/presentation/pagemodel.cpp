@@ -24,6 +24,10 @@
 
 #include "pagemodel.h"
 
+#include "domain/task.h"
+
+#include "presentation/querytreemodelbase.h"
+
 using namespace Presentation;
 
 PageModel::PageModel(QObject *parent)
@@ -38,3 +42,43 @@ QAbstractItemModel *PageModel::centralListModel()
         m_centralListModel = createCentralListModel();
     return m_centralListModel;
 }
+
+void PageModel::removeItems(const QModelIndexList &indexes)
+{
+    foreach (const auto &index, indexes)
+        removeItem(index);
+}
+
+QVariant PageModel::artifactIdentity(const Domain::Artifact::Ptr &artifact)
+{
+    return artifact ? artifact->property("itemId") : QVariant();
+}
+
+void PageModel::removeTasks(const QModelIndexList &indexes,
+                            const Domain::TaskRepository::Ptr &taskRepository,
+                            const std::function<QString(int)> &errorMessage)
+{
+    auto tasks = Domain::Task::List();
+    foreach (const auto &index, indexes) {
+        QVariant data = index.data(QueryTreeModelBase::ObjectRole);
+        auto task = data.value<Domain::Artifact::Ptr>().objectCast<Domain::Task>();
+        if (task)
+            tasks << task;
+    }
+
+    if (tasks.isEmpty())
+        return;
+
+    const auto job = taskRepository->removeTasks(tasks);
+    installHandler(job, errorMessage(tasks.size()));
+}
+
+QVector<int> PageModel::artifactRoles(const QList<QByteArray> &fields)
+{
+    QVector<int> roles;
+    if (fields.contains("title"))
+        roles << Qt::DisplayRole << Qt::EditRole;
+    if (fields.contains("done"))
+        roles << Qt::CheckStateRole;
+    return roles;
+}
@@ -28,15 +28,22 @@
 #include <QObject>
 
 #include <QModelIndex>
+#include <QSharedPointer>
+#include <QVector>
+
+#include <functional>
 
 #include "domain/artifact.h"
+#include "domain/taskrepository.h"
 
 #include "presentation/metatypes.h"
 #include "presentation/errorhandlingmodelbase.h"
 
 namespace Presentation {
 
-class PageModel : public QObject, public ErrorHandlingModelBase
+// Pages cached by their pages model are shared with the current page
+// holder, which finds the existing reference through sharedFromThis()
+class PageModel : public QObject, public ErrorHandlingModelBase, public QEnableSharedFromThis<PageModel>
 {
     Q_OBJECT
     Q_PROPERTY(QAbstractItemModel* centralListModel READ centralListModel)
@@ -48,8 +55,23 @@ public:
 public slots:
     virtual Domain::Artifact::Ptr addItem(const QString &title, const QModelIndex &parentIndex = QModelIndex()) = 0;
     virtual void removeItem(const QModelIndex &index) = 0;
+    virtual void removeItems(const QModelIndexList &indexes);
     virtual void promoteItem(const QModelIndex &index) = 0;
 
+protected:
+    // The same artifact reaches the model through different queries
+    // as distinct objects, the storage id they carry matches them
+    static QVariant artifactIdentity(const Domain::Artifact::Ptr &artifact);
+
+    // Roles of the central list models showing the given artifact fields
+    static QVector<int> artifactRoles(const QList<QByteArray> &fields);
+
+    // Removes the tasks found at the given indexes in a single job,
+    // the error message gets the number of tasks for its plural form
+    void removeTasks(const QModelIndexList &indexes,
+                     const Domain::TaskRepository::Ptr &taskRepository,
+                     const std::function<QString(int)> &errorMessage);
+
 private:
     virtual QAbstractItemModel *createCentralListModel() = 0;
 
@@ -0,0 +1,89 @@
+/* This file is part of Zanshin
+
+   Copyright 2016 Kevin Ottens <ervin@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+#include "pagemodelcache.h"
+
+#include "presentation/pagemodel.h"
+
+using namespace Presentation;
+
+PageModelCache::PageModelCache(int capacity)
+    : m_capacity(capacity)
+{
+    Q_ASSERT(m_capacity > 0);
+}
+
+int PageModelCache::capacity() const
+{
+    return m_capacity;
+}
+
+int PageModelCache::size() const
+{
+    return m_entries.size();
+}
+
+PageModel *PageModelCache::page(const QObjectPtr &object, const CreateFunction &create)
+{
+    for (int i = 0; i < m_entries.size(); i++) {
+        if (m_entries.at(i).object != object)
+            continue;
+
+        m_entries.move(i, 0);
+        return m_entries.first().page.data();
+    }
+
+    auto page = create();
+    if (!page)
+        return page;
+
+    // Shared with whoever makes it the current page,
+    // a page evicted while current stays alive
+    Entry entry;
+    entry.object = object;
+    entry.page = QSharedPointer<PageModel>(page);
+    m_entries.prepend(entry);
+    evict();
+
+    return page;
+}
+
+void PageModelCache::clear()
+{
+    m_entries.clear();
+}
+
+void PageModelCache::evict()
+{
+    // Pages of objects gone for good can't be asked for anymore
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (it->object.isNull())
+            it = m_entries.erase(it);
+        else
+            ++it;
+    }
+
+    while (m_entries.size() > m_capacity)
+        m_entries.removeLast();
+}
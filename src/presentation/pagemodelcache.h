@@ -0,0 +1,72 @@
+/* This file is part of Zanshin
+
+   Copyright 2016 Kevin Ottens <ervin@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+#ifndef PRESENTATION_PAGEMODELCACHE_H
+#define PRESENTATION_PAGEMODELCACHE_H
+
+#include <functional>
+
+#include <QList>
+#include <QSharedPointer>
+
+#include "presentation/metatypes.h"
+
+namespace Presentation {
+
+class PageModel;
+
+// Keeps the most recently used page models around, switching back to
+// one of them then doesn't build its model and queries again
+class PageModelCache
+{
+public:
+    typedef std::function<PageModel*()> CreateFunction;
+
+    explicit PageModelCache(int capacity = 8);
+
+    int capacity() const;
+    int size() const;
+
+    // Returns the page cached for object, or the one built by create
+    // which then goes in the cache
+    PageModel *page(const QObjectPtr &object, const CreateFunction &create);
+    void clear();
+
+private:
+    void evict();
+
+    struct Entry
+    {
+        QWeakPointer<QObject> object;
+        QSharedPointer<PageModel> page;
+    };
+
+    int m_capacity;
+    // Most recently used first
+    QList<Entry> m_entries;
+};
+
+}
+
+#endif // PRESENTATION_PAGEMODELCACHE_H
@@ -78,6 +78,13 @@ void ProjectPageModel::removeItem(const QModelIndex &index)
     installHandler(job, i18n("Cannot remove task %1 from project %2", task->title(), m_project->name()));
 }
 
+void ProjectPageModel::removeItems(const QModelIndexList &indexes)
+{
+    removeTasks(indexes, m_taskRepository, [this](int count) {
+        return i18np("Cannot remove %1 task from project %2", "Cannot remove %1 tasks from project %2", count, m_project->name());
+    });
+}
+
 void ProjectPageModel::promoteItem(const QModelIndex &index)
 {
     QVariant data = index.data(QueryTreeModel<Domain::Task::Ptr>::ObjectRole);
@@ -151,6 +158,22 @@ QAbstractItemModel *ProjectPageModel::createCentralListModel()
             return false;
         }
 
+        // Several tasks get their new parent in a single job
+        if (droppedArtifacts.size() > 1) {
+            if (parentTask) {
+                auto childTasks = Domain::Task::List();
+                foreach (const auto &droppedArtifact, droppedArtifacts)
+                    childTasks << droppedArtifact.staticCast<Domain::Task>();
+
+                const auto job = m_taskRepository->associateTasks(parentTask, childTasks);
+                installHandler(job, i18n("Cannot move tasks as sub-tasks of %1", parentTask->title()));
+            } else {
+                const auto job = m_projectRepository->associateArtifacts(m_project, droppedArtifacts);
+                installHandler(job, i18n("Cannot move tasks to project %1", m_project->name()));
+            }
+            return true;
+        }
+
         using namespace std::placeholders;
         auto associate = std::function<KJob*(Domain::Task::Ptr)>();
         auto parentTitle = QString();
@@ -188,5 +211,9 @@ QAbstractItemModel *ProjectPageModel::createCentralListModel()
         return data;
     };
 
-    return new QueryTreeModel<Domain::Task::Ptr>(query, flags, data, setData, drop, drag, this);
+    auto model = new QueryTreeModel<Domain::Task::Ptr>(query, flags, data, setData, drop, drag, this);
+    model->setIdentityFunction([](const Domain::Task::Ptr &task) { return artifactIdentity(task); });
+    model->setChangedRolesFunction(&PageModel::artifactRoles);
+    model->setSortedByTitle(true);
+    return model;
 }
@@ -43,6 +43,8 @@ public:
     typedef typename QueryTreeNode<ItemType>::SetDataFunction SetDataFunction;
     typedef typename QueryTreeNode<ItemType>::DropFunction DropFunction;
     typedef std::function<QMimeData*(const QList<ItemType> &)> DragFunction;
+    typedef std::function<QVariant(const ItemType &)> IdentityFunction;
+    typedef std::function<QVector<int>(const QList<QByteArray> &)> ChangedRolesFunction;
 
     explicit QueryTreeModel(const QueryGenerator &queryGenerator,
                             const FlagsFunction &flagsFunction,
@@ -72,6 +74,37 @@ public:
     {
     }
 
+    // Items with the same valid identity stand for the same entity, one
+    // removed from a query and then inserted in another is moved along
+    // with its subtree instead of being built again
+    void setIdentityFunction(const IdentityFunction &identityFunction)
+    {
+        m_identityFunction = identityFunction;
+    }
+
+    QVariant identity(const ItemType &item) const
+    {
+        return m_identityFunction ? m_identityFunction(item) : QVariant();
+    }
+
+    // Tells which roles depend on the fields an item change touched, the
+    // dataChanged() signals are then limited to those roles
+    void setChangedRolesFunction(const ChangedRolesFunction &changedRolesFunction)
+    {
+        m_changedRolesFunction = changedRolesFunction;
+    }
+
+    // The object itself always counts as changed
+    QVector<int> changedRoles(const QList<QByteArray> &fields) const
+    {
+        if (fields.isEmpty() || !m_changedRolesFunction)
+            return QVector<int>();
+
+        auto roles = m_changedRolesFunction(fields);
+        roles << ObjectRole;
+        return roles;
+    }
+
 protected:
     QMimeData *createMimeData(const QModelIndexList &indexes) const Q_DECL_OVERRIDE
     {
@@ -90,6 +123,8 @@ protected:
 
 private:
     DragFunction m_dragFunction;
+    IdentityFunction m_identityFunction;
+    ChangedRolesFunction m_changedRolesFunction;
 };
 
 }
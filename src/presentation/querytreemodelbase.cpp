@@ -27,25 +27,40 @@
 
 #include <QMimeData>
 #include <QStringList>
+#include <QTimer>
 
 #include <algorithm>
+#include <limits>
 
 using namespace Presentation;
 
 QueryTreeNodeBase::QueryTreeNodeBase(QueryTreeNodeBase *parent, QueryTreeModelBase *model)
     : m_parent(parent),
-      m_model(model)
+      m_model(model),
+      m_row(-1),
+      m_firstStaleChildRow(std::numeric_limits<int>::max()),
+      m_leaving(false),
+      m_leavingChildCount(0)
 {
 }
 
 QueryTreeNodeBase::~QueryTreeNodeBase()
 {
+    if (m_leaving)
+        m_model->m_leavingNodes.removeOne(this);
     qDeleteAll(m_childNode);
 }
 
 int QueryTreeNodeBase::row()
 {
-    return m_parent ? m_parent->m_childNode.indexOf(this) : -1;
+    if (!m_parent)
+        return -1;
+
+    if (m_row >= m_parent->m_firstStaleChildRow)
+        m_parent->updateChildRows();
+
+    Q_ASSERT(m_parent->m_childNode.at(m_row) == this);
+    return m_row;
 }
 
 QueryTreeNodeBase *QueryTreeNodeBase::parent() const
@@ -64,16 +79,23 @@ QueryTreeNodeBase *QueryTreeNodeBase::child(int row) const
 void QueryTreeNodeBase::insertChild(int row, QueryTreeNodeBase *node)
 {
     m_childNode.insert(row, node);
+    node->m_row = row;
+    markRowsStale(row);
 }
 
 void QueryTreeNodeBase::appendChild(QueryTreeNodeBase *node)
 {
+    node->m_row = m_childNode.size();
     m_childNode.append(node);
 }
 
 void QueryTreeNodeBase::removeChildAt(int row)
 {
-    delete m_childNode.takeAt(row);
+    auto node = m_childNode.takeAt(row);
+    if (node->m_leaving)
+        m_leavingChildCount--;
+    delete node;
+    markRowsStale(row);
 }
 
 int QueryTreeNodeBase::childCount() const
@@ -81,6 +103,116 @@ int QueryTreeNodeBase::childCount() const
     return m_childNode.size();
 }
 
+bool QueryTreeNodeBase::isLeaving() const
+{
+    return m_leaving;
+}
+
+QueryTreeModelBase *QueryTreeNodeBase::model() const
+{
+    return m_model;
+}
+
+int QueryTreeNodeBase::rowForIndex(int index) const
+{
+    // Leaving children aren't in the query anymore, skip them
+    // to find where the query index lands
+    if (m_leavingChildCount == 0)
+        return index;
+
+    int row = 0;
+    for (; row < m_childNode.size(); row++) {
+        if (m_childNode.at(row)->m_leaving)
+            continue;
+        if (index == 0)
+            break;
+        index--;
+    }
+    return row;
+}
+
+void QueryTreeNodeBase::markChildLeaving(int row)
+{
+    auto node = m_childNode.at(row);
+    Q_ASSERT(!node->m_leaving);
+    node->m_leaving = true;
+    m_leavingChildCount++;
+
+    m_model->m_leavingNodes.append(node);
+    m_model->scheduleLeavingNodesRemoval();
+}
+
+QList<QueryTreeNodeBase*> QueryTreeNodeBase::leavingNodes() const
+{
+    return m_model->m_leavingNodes;
+}
+
+void QueryTreeNodeBase::adoptLeavingNode(QueryTreeNodeBase *node, int row)
+{
+    Q_ASSERT(node->m_leaving);
+    Q_ASSERT(node->m_model == m_model);
+
+    auto source = node->m_parent;
+    const int sourceRow = node->row();
+
+    node->m_leaving = false;
+    source->m_leavingChildCount--;
+    m_model->m_leavingNodes.removeOne(node);
+
+    // Taken back right where it was
+    if (source == this && (row == sourceRow || row == sourceRow + 1))
+        return;
+
+    const QModelIndex sourceIndex = source->parent() ? createIndex(source->row(), 0, source) : QModelIndex();
+    const QModelIndex parentIndex = parent() ? createIndex(this->row(), 0, this) : QModelIndex();
+    const bool canMove = m_model->beginMoveRows(sourceIndex, sourceRow, sourceRow, parentIndex, row);
+    Q_ASSERT(canMove);
+    Q_UNUSED(canMove);
+
+    source->m_childNode.removeAt(sourceRow);
+    source->markRowsStale(sourceRow);
+    if (source == this && row > sourceRow)
+        row--;
+
+    node->m_parent = this;
+    insertChild(row, node);
+
+    m_model->endMoveRows();
+}
+
+void QueryTreeNodeBase::moveChild(int sourceRow, int row)
+{
+    if (row == sourceRow || row == sourceRow + 1)
+        return;
+
+    const QModelIndex parentIndex = parent() ? createIndex(this->row(), 0, this) : QModelIndex();
+    const bool canMove = m_model->beginMoveRows(parentIndex, sourceRow, sourceRow, parentIndex, row);
+    Q_ASSERT(canMove);
+    Q_UNUSED(canMove);
+
+    auto node = m_childNode.takeAt(sourceRow);
+    if (row > sourceRow)
+        row--;
+    m_childNode.insert(row, node);
+    markRowsStale(qMin(sourceRow, row));
+
+    m_model->endMoveRows();
+}
+
+void QueryTreeNodeBase::markRowsStale(int row)
+{
+    // Children before the change didn't move, their cached row
+    // is still below the mark
+    m_firstStaleChildRow = qMin(m_firstStaleChildRow, row);
+}
+
+void QueryTreeNodeBase::updateChildRows()
+{
+    for (int row = m_firstStaleChildRow; row < m_childNode.size(); row++)
+        m_childNode.at(row)->m_row = row;
+    m_firstStaleChildRow = std::numeric_limits<int>::max();
+}
+
 QModelIndex QueryTreeNodeBase::index(int row, int column, const QModelIndex &parent) const
 {
     return m_model->index(row, column, parent);
@@ -111,20 +243,23 @@ void QueryTreeNodeBase::endRemoveRows()
     m_model->endRemoveRows();
 }
 
-void QueryTreeNodeBase::emitDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight)
+void QueryTreeNodeBase::emitDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles)
 {
-    emit m_model->dataChanged(topLeft, bottomRight);
+    emit m_model->dataChanged(topLeft, bottomRight, roles);
 }
 
 QueryTreeModelBase::QueryTreeModelBase(QueryTreeNodeBase *rootNode, QObject *parent)
     : QAbstractItemModel(parent),
       m_rootIndexFlag(Qt::ItemIsDropEnabled),
-      m_rootNode(rootNode)
+      m_rootNode(rootNode),
+      m_leavingNodesRemovalScheduled(false),
+      m_sortedByTitle(false)
 {
     auto roles = roleNames();
     roles.insert(ObjectRole, "object");
     roles.insert(IconNameRole, "icon");
     roles.insert(IsDefaultRole, "default");
+    roles.insert(CountRole, "count");
     setRoleNames(roles);
 }
 
@@ -190,7 +325,13 @@ bool QueryTreeModelBase::setData(const QModelIndex &index, const QVariant &value
         return false;
     }
 
-    return nodeFromIndex(index)->setData(value, role);
+    if (!nodeFromIndex(index)->setData(value, role))
+        return false;
+
+    // The object got changed in place, the proxies on top of us need to
+    // sort and filter it again right away
+    emit dataChanged(index, index);
+    return true;
 }
 
 bool QueryTreeModelBase::dropMimeData(const QMimeData *data, Qt::DropAction action, int row, int column, const QModelIndex &parent)
@@ -247,6 +388,16 @@ QueryTreeNodeBase *QueryTreeModelBase::nodeFromIndex(const QModelIndex &index) c
     return index.isValid() ? static_cast<QueryTreeNodeBase*>(index.internalPointer()) : m_rootNode;
 }
 
+void QueryTreeModelBase::setSortedByTitle(bool sorted)
+{
+    m_sortedByTitle = sorted;
+}
+
+bool QueryTreeModelBase::isSortedByTitle() const
+{
+    return m_sortedByTitle;
+}
+
 void QueryTreeModelBase::setRootIndexFlag(Qt::ItemFlags flags)
 {
     m_rootIndexFlag = flags;
@@ -265,3 +416,29 @@ bool QueryTreeModelBase::isModelIndexValid(const QModelIndex &index) const
     const int count = parentNode->childCount();
     return index.row() < count;
 }
+
+void QueryTreeModelBase::scheduleLeavingNodesRemoval()
+{
+    if (m_leavingNodesRemovalScheduled)
+        return;
+
+    m_leavingNodesRemovalScheduled = true;
+    QTimer::singleShot(0, this, &QueryTreeModelBase::removeLeavingNodes);
+}
+
+void QueryTreeModelBase::removeLeavingNodes()
+{
+    m_leavingNodesRemovalScheduled = false;
+
+    // Removing a node also drops the leaving nodes in its subtree
+    while (!m_leavingNodes.isEmpty()) {
+        auto node = m_leavingNodes.first();
+        auto parentNode = node->parent();
+        const int row = node->row();
+
+        const QModelIndex parentIndex = parentNode->parent() ? createIndex(parentNode->row(), 0, parentNode) : QModelIndex();
+        beginRemoveRows(parentIndex, row, row);
+        parentNode->removeChildAt(row);
+        endRemoveRows();
+    }
+}
@@ -50,20 +50,41 @@ public:
     void appendChild(QueryTreeNodeBase *node);
     void removeChildAt(int row);
     int childCount() const;
+    bool isLeaving() const;
 
 protected:
+    QueryTreeModelBase *model() const;
+    int rowForIndex(int index) const;
+    void markChildLeaving(int row);
+    QList<QueryTreeNodeBase*> leavingNodes() const;
+    void adoptLeavingNode(QueryTreeNodeBase *node, int row);
+    void moveChild(int sourceRow, int row);
+
     QModelIndex index(int row, int column, const QModelIndex &parent) const;
     QModelIndex createIndex(int row, int column, void *data) const;
     void beginInsertRows(const QModelIndex &parent, int first, int last);
     void endInsertRows();
     void beginRemoveRows(const QModelIndex &parent, int first, int last);
     void endRemoveRows();
-    void emitDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight);
+    void emitDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles = QVector<int>());
 
 private:
+    void markRowsStale(int row);
+    void updateChildRows();
+
     QueryTreeNodeBase *m_parent;
     QList<QueryTreeNodeBase*> m_childNode;
     QueryTreeModelBase *m_model;
+
+    // Leaving children are gone from their query but still shown until
+    // the event loop is reached, another query might pick them up meanwhile
+    bool m_leaving;
+    int m_leavingChildCount;
+
+    // Rows are cached in the children, an insert or a remove only
+    // flags the rows after it, they get renumbered when next asked for
+    int m_row;
+    int m_firstStaleChildRow;
 };
 
 class QueryTreeModelBase : public QAbstractItemModel
@@ -74,6 +95,7 @@ public:
         ObjectRole = Qt::UserRole + 1,
         IconNameRole,
         IsDefaultRole,
+        CountRole,
         UserRole
     };
 
@@ -96,6 +118,11 @@ public:
     // TODO Qt5: Remove but needed in Qt4, so that we can trigger it from the outside
     using QAbstractItemModel::dataChanged;
 
+    // Tells that the rows of each level come ordered by title from the
+    // queries, a row moving by itself when its title changes
+    void setSortedByTitle(bool sorted);
+    bool isSortedByTitle() const;
+
 protected:
     explicit QueryTreeModelBase(QueryTreeNodeBase *rootNode,
                                 QObject *parent = Q_NULLPTR);
@@ -106,8 +133,14 @@ protected:
 private:
     friend class QueryTreeNodeBase;
     bool isModelIndexValid(const QModelIndex &index) const;
+    void scheduleLeavingNodesRemoval();
+    void removeLeavingNodes();
+
     Qt::ItemFlags m_rootIndexFlag;
     QueryTreeNodeBase *m_rootNode;
+    QList<QueryTreeNodeBase*> m_leavingNodes;
+    bool m_leavingNodesRemovalScheduled;
+    bool m_sortedByTitle;
 };
 
 }
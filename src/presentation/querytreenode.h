@@ -38,6 +38,9 @@
 
 namespace Presentation {
 
+template<typename ItemType>
+class QueryTreeModel;
+
 // Qt5 TODO, shouldn't be needed anymore, QVariant will do the right thing
 namespace Internal {
     template<typename T>
@@ -132,42 +135,231 @@ private:
         if (!m_children)
             return;
 
-        for (auto child : m_children->data()) {
-            QueryTreeNodeBase *node = new QueryTreeNode<ItemType>(child, this,
-                                                                  model, queryGenerator,
-                                                                  m_flagsFunction,
-                                                                  m_dataFunction, m_setDataFunction,
-                                                                  m_dropFunction);
-            appendChild(node);
-        }
+        for (auto child : m_children->data())
+            appendChild(createChild(child, model, queryGenerator));
+
+        m_children->addPreInsertHandler([this](const ItemType &item, int index) {
+            if (findLeavingNode(item))
+                return;
 
-        m_children->addPreInsertHandler([this](const ItemType &, int index) {
             QModelIndex parentIndex = parent() ? createIndex(row(), 0, this) : QModelIndex();
-            beginInsertRows(parentIndex, index, index);
+            const int row = rowForIndex(index);
+            beginInsertRows(parentIndex, row, row);
         });
-        m_children->addPostInsertHandler([this, model, queryGenerator](const ItemType &item, int index) {
-            QueryTreeNodeBase *node = new QueryTreeNode<ItemType>(item, this,
-                                                                  model, queryGenerator,
-                                                                  m_flagsFunction,
-                                                                  m_dataFunction, m_setDataFunction,
-                                                                  m_dropFunction);
-            insertChild(index, node);
+        m_children->addPostInsertHandler([this, model, queryGenerator](const ItemType &item, int idx) {
+            const int row = rowForIndex(idx);
+
+            // Same item coming back from another query, move its
+            // subtree over instead of building it again
+            if (auto node = findLeavingNode(item)) {
+                adoptLeavingNode(node, row);
+                node->m_item = item;
+                QModelIndex parentIndex = parent() ? createIndex(this->row(), 0, this) : QModelIndex();
+                emitDataChanged(index(row, 0, parentIndex), index(row, 0, parentIndex));
+                return;
+            }
+
+            insertChild(row, createChild(item, model, queryGenerator));
             endInsertRows();
         });
-        m_children->addPreRemoveHandler([this](const ItemType &, int index) {
+        m_children->addPreRemoveHandler([this](const ItemType &item, int index) {
+            if (identity(item).isValid())
+                return;
+
             QModelIndex parentIndex = parent() ? createIndex(row(), 0, this) : QModelIndex();
-            beginRemoveRows(parentIndex, index, index);
+            const int row = rowForIndex(index);
+            beginRemoveRows(parentIndex, row, row);
         });
-        m_children->addPostRemoveHandler([this](const ItemType &, int index) {
-            removeChildAt(index);
+        m_children->addPostRemoveHandler([this](const ItemType &item, int index) {
+            const int row = rowForIndex(index);
+
+            // Might be moving to another query, in which case
+            // the insert will follow before we reach the event loop
+            if (identity(item).isValid()) {
+                markChildLeaving(row);
+                return;
+            }
+
+            removeChildAt(row);
             endRemoveRows();
         });
         m_children->addPostReplaceHandler([this](const ItemType &, int idx) {
             QModelIndex parentIndex = parent() ? createIndex(row(), 0, this) : QModelIndex();
-            emitDataChanged(index(idx, 0, parentIndex), index(idx, 0, parentIndex));
+            const int row = rowForIndex(idx);
+            const auto roles = changedRoles(m_children->changedFields());
+            emitDataChanged(index(row, 0, parentIndex), index(row, 0, parentIndex), roles);
+        });
+        // Bulk updates are applied as the difference between the children
+        // and the new results, the nodes of the items still there are kept
+        // along with their subtree, so expansion and selection survive
+        m_children->addPostResetHandler([this, model, queryGenerator] {
+            applyReset(model, queryGenerator);
         });
     }
 
+    QueryTreeNode<ItemType> *childNode(int row) const
+    {
+        return static_cast<QueryTreeNode<ItemType>*>(child(row));
+    }
+
+    void applyReset(QueryTreeModelBase *model, const QueryGenerator &queryGenerator)
+    {
+        const auto items = m_children->data();
+        const auto newItems = items.toSet();
+        const QModelIndex parentIndex = parent() ? createIndex(row(), 0, this) : QModelIndex();
+
+        // Drop the nodes of the items gone, a run of rows at a time
+        int lastGoneRow = -1;
+        for (int row = childCount() - 1; row >= -1; row--) {
+            auto node = row >= 0 ? childNode(row) : Q_NULLPTR;
+            const bool isGone = node && !node->isLeaving() && !newItems.contains(node->m_item);
+
+            if (isGone && !identity(node->m_item).isValid()) {
+                if (lastGoneRow < 0)
+                    lastGoneRow = row;
+                continue;
+            }
+
+            if (lastGoneRow >= 0) {
+                beginRemoveRows(parentIndex, row + 1, lastGoneRow);
+                for (int goneRow = lastGoneRow; goneRow > row; goneRow--)
+                    removeChildAt(goneRow);
+                endRemoveRows();
+                lastGoneRow = -1;
+            }
+
+            // Might be moving to another query, like in the remove handler
+            if (isGone)
+                markChildLeaving(row);
+        }
+
+        QHash<ItemType, QueryTreeNode<ItemType>*> nodes;
+        for (int row = 0; row < childCount(); row++) {
+            auto node = childNode(row);
+            if (!node->isLeaving())
+                nodes.insert(node->m_item, node);
+        }
+
+        // The kept nodes might have changed, they're told about by runs of rows
+        int firstChangedRow = -1;
+        int lastChangedRow = -1;
+        auto flushChangedRows = [&] {
+            if (firstChangedRow < 0)
+                return;
+
+            emitDataChanged(index(firstChangedRow, 0, parentIndex), index(lastChangedRow, 0, parentIndex));
+            firstChangedRow = lastChangedRow = -1;
+        };
+        auto addChangedRow = [&] (int row) {
+            if (firstChangedRow >= 0 && row != lastChangedRow + 1)
+                flushChangedRows();
+            if (firstChangedRow < 0)
+                firstChangedRow = row;
+            lastChangedRow = row;
+        };
+
+        // The rows before the one of items[i] are in their final place,
+        // the kept nodes only have to move if the order changed
+        for (int i = 0; i < items.size();) {
+            const auto item = items.at(i);
+            const int row = rowForIndex(i);
+
+            if (auto node = nodes.take(item)) {
+                moveChild(node->row(), row);
+                node->m_item = item;
+                addChangedRow(node->row());
+                i++;
+                continue;
+            }
+
+            // Same item coming back from another query
+            if (auto node = findLeavingNode(item)) {
+                flushChangedRows();
+                adoptLeavingNode(node, row);
+                node->m_item = item;
+                addChangedRow(node->row());
+                i++;
+                continue;
+            }
+
+            int end = i + 1;
+            while (end < items.size()
+                && !nodes.contains(items.at(end))
+                && !findLeavingNode(items.at(end))) {
+                end++;
+            }
+
+            beginInsertRows(parentIndex, row, row + end - i - 1);
+            for (int j = i; j < end; j++)
+                insertChild(row + j - i, createChild(items.at(j), model, queryGenerator));
+            endInsertRows();
+            i = end;
+        }
+
+        flushChangedRows();
+
+        // Only the nodes of items listed twice can be left over
+        const int endRow = rowForIndex(items.size());
+        for (int row = childCount() - 1; row >= endRow; row--) {
+            if (childNode(row)->isLeaving())
+                continue;
+
+            beginRemoveRows(parentIndex, row, row);
+            removeChildAt(row);
+            endRemoveRows();
+        }
+    }
+
+    QVariant identity(const ItemType &item) const
+    {
+        return static_cast<QueryTreeModel<ItemType>*>(model())->identity(item);
+    }
+
+    QVector<int> changedRoles(const QList<QByteArray> &fields) const
+    {
+        return static_cast<QueryTreeModel<ItemType>*>(model())->changedRoles(fields);
+    }
+
+    QueryTreeNode<ItemType> *findLeavingNode(const ItemType &item) const
+    {
+        const auto nodes = leavingNodes();
+        if (nodes.isEmpty())
+            return Q_NULLPTR;
+
+        const auto id = identity(item);
+        if (!id.isValid())
+            return Q_NULLPTR;
+
+        foreach (auto node, nodes) {
+            auto candidate = static_cast<QueryTreeNode<ItemType>*>(node);
+            if (identity(candidate->m_item) != id)
+                continue;
+
+            // Can't move a node under itself
+            bool isAncestor = false;
+            for (auto p = static_cast<const QueryTreeNodeBase*>(this); p; p = p->parent()) {
+                if (p == candidate) {
+                    isAncestor = true;
+                    break;
+                }
+            }
+
+            if (!isAncestor)
+                return candidate;
+        }
+
+        return Q_NULLPTR;
+    }
+
+    QueryTreeNodeBase *createChild(const ItemType &item, QueryTreeModelBase *model, const QueryGenerator &queryGenerator)
+    {
+        return new QueryTreeNode<ItemType>(item, this,
+                                           model, queryGenerator,
+                                           m_flagsFunction,
+                                           m_dataFunction, m_setDataFunction,
+                                           m_dropFunction);
+    }
+
     ItemType m_item;
     ItemQueryPtr m_children;
 
@@ -34,16 +34,16 @@ RunningTaskModel::RunningTaskModel(const Domain::TaskQueries::Ptr &taskQueries,
       m_queries(taskQueries),
       m_taskRepository(taskRepository)
 {
-    // List all tasks to find if any one is already set to "running"
+    // Find if a task is already set to "running", the query also reports
+    // the tasks we start ourselves, those are already known
     if (m_queries) {
-        m_taskList = m_queries->findAll();
-        Q_ASSERT(m_taskList);
-        m_taskList->addPostInsertHandler([this](const Domain::Task::Ptr &task, int) {
-            if (task->isRunning()) {
+        m_runningTaskList = m_queries->findRunning();
+        Q_ASSERT(m_runningTaskList);
+        m_runningTaskList->addPostInsertHandler([this](const Domain::Task::Ptr &task, int) {
+            if (!m_runningTask && task->isRunning()) {
                 setRunningTask(task);
             }
         });
-        // if there was a addFinishedHandler, we could reset m_queries and m_taskList to nullptr there to free memory.
     }
 }
 
@@ -54,7 +54,7 @@ public slots:
 private:
     Domain::Task::Ptr m_runningTask;
 
-    Domain::QueryResult<Domain::Task::Ptr>::Ptr m_taskList;
+    Domain::QueryResult<Domain::Task::Ptr>::Ptr m_runningTaskList;
     Domain::TaskQueries::Ptr m_queries;
     Domain::TaskRepository::Ptr m_taskRepository;
 };
@@ -141,5 +141,7 @@ QAbstractItemModel *TagPageModel::createCentralListModel()
         return data;
     };
 
-    return new QueryTreeModel<Domain::Note::Ptr>(query, flags, data, setData, drop, drag, this);
+    auto model = new QueryTreeModel<Domain::Note::Ptr>(query, flags, data, setData, drop, drag, this);
+    model->setSortedByTitle(true);
+    return model;
 }
@@ -66,6 +66,13 @@ void TaskInboxPageModel::removeItem(const QModelIndex &index)
     installHandler(job, i18n("Cannot remove task %1 from Inbox", task->title()));
 }
 
+void TaskInboxPageModel::removeItems(const QModelIndexList &indexes)
+{
+    removeTasks(indexes, m_taskRepository, [](int count) {
+        return i18np("Cannot remove %1 task from Inbox", "Cannot remove %1 tasks from Inbox", count);
+    });
+}
+
 void TaskInboxPageModel::promoteItem(const QModelIndex &index)
 {
     QVariant data = index.data(QueryTreeModel<Domain::Task::Ptr>::ObjectRole);
@@ -141,6 +148,17 @@ QAbstractItemModel *TaskInboxPageModel::createCentralListModel()
             return false;
         }
 
+        // Several tasks get their new parent in a single job
+        if (parentTask && droppedArtifacts.size() > 1) {
+            auto childTasks = Domain::Task::List();
+            foreach (const auto &droppedArtifact, droppedArtifacts)
+                childTasks << droppedArtifact.staticCast<Domain::Task>();
+
+            const auto job = m_taskRepository->associateTasks(parentTask, childTasks);
+            installHandler(job, i18n("Cannot move tasks as sub-tasks of %1", parentTask->title()));
+            return true;
+        }
+
         foreach(const auto &droppedArtifact, droppedArtifacts) {
             auto childTask = droppedArtifact.objectCast<Domain::Task>();
 
@@ -172,5 +190,9 @@ QAbstractItemModel *TaskInboxPageModel::createCentralListModel()
         return data;
     };
 
-    return new QueryTreeModel<Domain::Task::Ptr>(query, flags, data, setData, drop, drag, this);
+    auto model = new QueryTreeModel<Domain::Task::Ptr>(query, flags, data, setData, drop, drag, this);
+    model->setIdentityFunction([](const Domain::Task::Ptr &task) { return artifactIdentity(task); });
+    model->setChangedRolesFunction(&PageModel::artifactRoles);
+    model->setSortedByTitle(true);
+    return model;
 }
@@ -42,6 +42,7 @@ public:
 
     Domain::Artifact::Ptr addItem(const QString &title, const QModelIndex &parentIndex = QModelIndex()) Q_DECL_OVERRIDE;
     void removeItem(const QModelIndex &index) Q_DECL_OVERRIDE;
+    void removeItems(const QModelIndexList &indexes) Q_DECL_OVERRIDE;
     void promoteItem(const QModelIndex &index) Q_DECL_OVERRIDE;
 
 private:
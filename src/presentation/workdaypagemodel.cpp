@@ -75,6 +75,13 @@ void WorkdayPageModel::removeItem(const QModelIndex &index)
     }
 }
 
+void WorkdayPageModel::removeItems(const QModelIndexList &indexes)
+{
+    removeTasks(indexes, m_taskRepository, [](int count) {
+        return i18np("Cannot remove %1 task from Workday", "Cannot remove %1 tasks from Workday", count);
+    });
+}
+
 void WorkdayPageModel::promoteItem(const QModelIndex &index)
 {
     QVariant data = index.data(QueryTreeModel<Domain::Task::Ptr>::ObjectRole);
@@ -158,6 +165,17 @@ QAbstractItemModel *WorkdayPageModel::createCentralListModel()
             return false;
         }
 
+        // Several tasks get their new parent in a single job
+        if (parentTask && droppedArtifacts.size() > 1) {
+            auto childTasks = Domain::Task::List();
+            foreach (const auto &droppedArtifact, droppedArtifacts)
+                childTasks << droppedArtifact.staticCast<Domain::Task>();
+
+            const auto job = m_taskRepository->associateTasks(parentTask, childTasks);
+            installHandler(job, i18n("Cannot move tasks as sub-tasks of %1", parentTask->title()));
+            return true;
+        }
+
         foreach(const auto &droppedArtifact, droppedArtifacts) {
             auto childTask = droppedArtifact.objectCast<Domain::Task>();
 
@@ -188,5 +206,9 @@ QAbstractItemModel *WorkdayPageModel::createCentralListModel()
         return data;
     };
 
-    return new QueryTreeModel<Domain::Artifact::Ptr>(query, flags, data, setData, drop, drag, this);
+    auto model = new QueryTreeModel<Domain::Artifact::Ptr>(query, flags, data, setData, drop, drag, this);
+    model->setIdentityFunction([](const Domain::Artifact::Ptr &artifact) { return artifactIdentity(artifact); });
+    model->setChangedRolesFunction(&PageModel::artifactRoles);
+    model->setSortedByTitle(true);
+    return model;
 }
@@ -29,8 +29,16 @@ using namespace Utils;
 
 QDateTime DateTime::currentDateTime()
 {
-    QByteArray overrideDatetime = qgetenv("ZANSHIN_OVERRIDE_DATETIME");
-    QDateTime customDateTime = QDateTime::fromString(QString::fromLocal8Bit(overrideDatetime), Qt::ISODate);
-
-    return customDateTime.isValid() ? customDateTime : QDateTime::currentDateTime();
+    // Parsing is by far the most expensive part, so only do it
+    // when the override changes
+    static thread_local QByteArray cachedOverride;
+    static thread_local QDateTime cachedDateTime;
+
+    const QByteArray overrideDatetime = qgetenv("ZANSHIN_OVERRIDE_DATETIME");
+    if (overrideDatetime != cachedOverride) {
+        cachedOverride = overrideDatetime;
+        cachedDateTime = QDateTime::fromString(QString::fromLocal8Bit(overrideDatetime), Qt::ISODate);
+    }
+
+    return cachedDateTime.isValid() ? cachedDateTime : QDateTime::currentDateTime();
 }
@@ -0,0 +1,72 @@
+/* This file is part of Zanshin
+
+   Copyright 2016 Kevin Ottens <ervin@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+#include "daychangenotifier.h"
+
+#include <QDateTime>
+#include <QTimer>
+
+#include "datetime.h"
+
+using namespace Utils;
+
+namespace {
+    // Timers drift when the machine sleeps or the clock gets adjusted,
+    // so don't trust one for too long
+    const qint64 MaxCheckInterval = 60 * 60 * 1000;
+}
+
+DayChangeNotifier::DayChangeNotifier(QObject *parent)
+    : QObject(parent),
+      m_timer(new QTimer(this)),
+      m_currentDate(DateTime::currentDateTime().date())
+{
+    m_timer->setSingleShot(true);
+    m_timer->setTimerType(Qt::PreciseTimer);
+    connect(m_timer, &QTimer::timeout, this, &DayChangeNotifier::onTimeout);
+    scheduleNextCheck();
+}
+
+QDate DayChangeNotifier::currentDate() const
+{
+    return m_currentDate;
+}
+
+void DayChangeNotifier::onTimeout()
+{
+    const auto date = DateTime::currentDateTime().date();
+    if (date != m_currentDate) {
+        m_currentDate = date;
+        emit dayChanged(date);
+    }
+
+    scheduleNextCheck();
+}
+
+void DayChangeNotifier::scheduleNextCheck()
+{
+    const auto now = DateTime::currentDateTime();
+    const auto nextDay = QDateTime(now.date().addDays(1), QTime(0, 0), now.timeSpec());
+    const auto interval = qBound(qint64(1), now.msecsTo(nextDay), MaxCheckInterval);
+    m_timer->start(int(interval));
+}
@@ -0,0 +1,88 @@
+/* This file is part of Zanshin
+
+   Copyright 2016 Kevin Ottens <ervin@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+#include "future.h"
+
+using namespace Utils;
+
+static int s_pendingFutureCount = 0;
+
+void Internal::registerPendingFuture()
+{
+    s_pendingFutureCount++;
+}
+
+void Internal::unregisterPendingFuture()
+{
+    Q_ASSERT(s_pendingFutureCount > 0);
+    s_pendingFutureCount--;
+}
+
+int Utils::pendingFutureCount()
+{
+    return s_pendingFutureCount;
+}
+
+FutureJob::FutureJob(QObject *parent)
+    : KJob(parent),
+      m_started(false),
+      m_finished(false),
+      m_killed(false)
+{
+}
+
+void FutureJob::setCanceler(const std::function<void()> &canceler)
+{
+    m_canceler = canceler;
+}
+
+void FutureJob::setFinished(int error, const QString &errorText)
+{
+    // When killed KJob takes care of the result itself
+    if (m_killed || m_finished)
+        return;
+
+    m_finished = true;
+    setError(error);
+    setErrorText(errorText);
+    if (m_started)
+        emitResult();
+}
+
+void FutureJob::start()
+{
+    if (m_started)
+        return;
+
+    m_started = true;
+    if (m_finished)
+        emitResult();
+}
+
+bool FutureJob::doKill()
+{
+    m_killed = true;
+    if (m_canceler)
+        m_canceler();
+    return true;
+}
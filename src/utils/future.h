@@ -0,0 +1,382 @@
+/* This file is part of Zanshin
+
+   Copyright 2016 Kevin Ottens <ervin@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+#ifndef UTILS_FUTURE_H
+#define UTILS_FUTURE_H
+
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+#include <QPointer>
+#include <QSharedPointer>
+#include <QVector>
+
+#include <KJob>
+
+namespace Utils {
+
+template<typename T>
+class Future;
+
+namespace Internal {
+    void registerPendingFuture();
+    void unregisterPendingFuture();
+
+    template<typename T>
+    struct FutureState
+    {
+        enum Status {
+            Running,
+            Succeeded,
+            Failed,
+            Canceled
+        };
+
+        FutureState()
+            : status(Running),
+              error(KJob::NoError)
+        {
+        }
+
+        void finish(Status newStatus)
+        {
+            if (status != Running)
+                return;
+
+            status = newStatus;
+            // Dropping those breaks the reference cycles between chained states
+            canceler = nullptr;
+            auto handlers = std::move(continuations);
+            continuations.clear();
+            for (const auto &handler : handlers)
+                handler();
+        }
+
+        Status status;
+        T value;
+        int error;
+        QString errorText;
+        std::function<void()> canceler;
+        std::vector<std::function<void()>> continuations;
+    };
+
+    template<typename R>
+    struct Continuation;
+}
+
+// Handle on a value which will be available later, typically once a job is done.
+// Copies share the same state, continuations are called in the order they got
+// registered and only once, no global bookkeeping is involved.
+template<typename T>
+class Future
+{
+    typedef Internal::FutureState<T> State;
+
+public:
+    typedef T ValueType;
+
+    Future()
+        : m_state(QSharedPointer<State>::create())
+    {
+    }
+
+    bool isFinished() const { return m_state->status != State::Running; }
+    bool isCanceled() const { return m_state->status == State::Canceled; }
+    int error() const { return m_state->error; }
+    QString errorText() const { return m_state->errorText; }
+    T result() const { return m_state->value; }
+
+    void setResult(const T &value)
+    {
+        if (isFinished())
+            return;
+
+        m_state->value = value;
+        m_state->finish(State::Succeeded);
+    }
+
+    void setError(int error, const QString &errorText = QString())
+    {
+        if (isFinished())
+            return;
+
+        m_state->error = error;
+        m_state->errorText = errorText;
+        m_state->finish(State::Failed);
+    }
+
+    // Called when the future gets canceled while still running,
+    // usually to stop the work producing the value
+    void setCanceler(const std::function<void()> &canceler)
+    {
+        if (!isFinished())
+            m_state->canceler = canceler;
+    }
+
+    void cancel()
+    {
+        if (isFinished())
+            return;
+
+        auto canceler = m_state->canceler;
+        m_state->finish(State::Canceled);
+        if (canceler)
+            canceler();
+    }
+
+    // Called whatever the outcome, right away if the future is already finished
+    void onFinished(const std::function<void()> &handler) const
+    {
+        if (isFinished())
+            handler();
+        else
+            m_state->continuations.push_back(handler);
+    }
+
+    // Chains function on the value, errors and cancellation are forwarded
+    // untouched. If function returns a future the returned future follows it,
+    // if it returns nothing the returned future only tells about completion.
+    template<typename Function>
+    typename Internal::Continuation<typename std::decay<typename std::result_of<Function(const T &)>::type>::type>::FutureType
+    then(Function function) const
+    {
+        typedef typename std::decay<typename std::result_of<Function(const T &)>::type>::type ReturnType;
+        return Internal::Continuation<ReturnType>::chain(*this, function);
+    }
+
+private:
+    QSharedPointer<State> m_state;
+};
+
+namespace Internal {
+    template<typename T, typename U>
+    void forwardFailure(const Future<T> &source, Future<U> &target)
+    {
+        if (source.isCanceled())
+            target.cancel();
+        else
+            target.setError(source.error(), source.errorText());
+    }
+
+    template<typename R>
+    struct Continuation
+    {
+        typedef Future<R> FutureType;
+
+        template<typename T, typename Function>
+        static FutureType chain(const Future<T> &source, Function function)
+        {
+            FutureType target;
+            target.setCanceler([source] () mutable { source.cancel(); });
+            source.onFinished([source, target, function] () mutable {
+                if (source.isCanceled() || source.error() != KJob::NoError)
+                    forwardFailure(source, target);
+                else
+                    target.setResult(function(source.result()));
+            });
+            return target;
+        }
+    };
+
+    template<>
+    struct Continuation<void>
+    {
+        typedef Future<bool> FutureType;
+
+        template<typename T, typename Function>
+        static FutureType chain(const Future<T> &source, Function function)
+        {
+            FutureType target;
+            target.setCanceler([source] () mutable { source.cancel(); });
+            source.onFinished([source, target, function] () mutable {
+                if (source.isCanceled() || source.error() != KJob::NoError) {
+                    forwardFailure(source, target);
+                } else {
+                    function(source.result());
+                    target.setResult(true);
+                }
+            });
+            return target;
+        }
+    };
+
+    template<typename U>
+    struct Continuation<Future<U>>
+    {
+        typedef Future<U> FutureType;
+
+        template<typename T, typename Function>
+        static FutureType chain(const Future<T> &source, Function function)
+        {
+            FutureType target;
+            target.setCanceler([source] () mutable { source.cancel(); });
+            source.onFinished([source, target, function] () mutable {
+                if (source.isCanceled() || source.error() != KJob::NoError) {
+                    forwardFailure(source, target);
+                    return;
+                }
+
+                auto next = function(source.result());
+                target.setCanceler([next] () mutable { next.cancel(); });
+                next.onFinished([next, target] () mutable {
+                    if (next.isCanceled() || next.error() != KJob::NoError)
+                        forwardFailure(next, target);
+                    else
+                        target.setResult(next.result());
+                });
+            });
+            return target;
+        }
+    };
+}
+
+// Starts job and gives a future on the value extracted from it once done,
+// canceling the future kills the job
+template<typename Extractor>
+Future<typename std::decay<typename std::result_of<Extractor()>::type>::type> fromJob(KJob *job, Extractor extractor)
+{
+    Future<typename std::decay<typename std::result_of<Extractor()>::type>::type> future;
+
+    Internal::registerPendingFuture();
+    future.onFinished(&Internal::unregisterPendingFuture);
+
+    QPointer<KJob> guard(job);
+    future.setCanceler([guard] {
+        if (guard)
+            guard->kill(KJob::Quietly);
+    });
+
+    QObject::connect(job, &KJob::result, [future, extractor] (KJob *job) mutable {
+        if (job->error() != KJob::NoError)
+            future.setError(job->error(), job->errorText());
+        else
+            future.setResult(extractor());
+    });
+    // A job deleted without emitting its result won't produce anything anymore
+    QObject::connect(job, &QObject::destroyed, [future] () mutable {
+        future.cancel();
+    });
+
+    job->start();
+    return future;
+}
+
+// Same as above when only the completion of the job matters
+inline Future<bool> fromJob(KJob *job)
+{
+    return fromJob(job, [] { return true; });
+}
+
+// Combines futures into one giving all the values in the same order, it fails
+// as soon as one of them fails, canceling the others
+template<typename T>
+Future<QVector<T>> whenAll(const QVector<Future<T>> &futures)
+{
+    Future<QVector<T>> all;
+    if (futures.isEmpty()) {
+        all.setResult(QVector<T>());
+        return all;
+    }
+
+    all.setCanceler([futures] {
+        for (auto future : futures)
+            future.cancel();
+    });
+
+    auto remaining = QSharedPointer<int>::create(futures.size());
+    for (const auto &future : futures) {
+        future.onFinished([futures, future, all, remaining] () mutable {
+            if (all.isFinished())
+                return;
+
+            if (future.isCanceled() || future.error() != KJob::NoError) {
+                Internal::forwardFailure(future, all);
+                for (auto other : futures)
+                    other.cancel();
+                return;
+            }
+
+            if (--(*remaining) == 0) {
+                auto results = QVector<T>();
+                results.reserve(futures.size());
+                for (const auto &f : futures)
+                    results << f.result();
+                all.setResult(results);
+            }
+        });
+    }
+
+    return all;
+}
+
+// Job emitting its result once the future it wraps is finished,
+// it is meant as a bridge for the interfaces still exposing jobs
+class FutureJob : public KJob
+{
+    Q_OBJECT
+public:
+    explicit FutureJob(QObject *parent = Q_NULLPTR);
+
+    void setCanceler(const std::function<void()> &canceler);
+    void setFinished(int error, const QString &errorText);
+
+    void start() Q_DECL_OVERRIDE;
+
+protected:
+    bool doKill() Q_DECL_OVERRIDE;
+
+private:
+    std::function<void()> m_canceler;
+    bool m_started;
+    bool m_finished;
+    bool m_killed;
+};
+
+// The job has to be started like any other job
+template<typename T>
+KJob *toJob(const Future<T> &future)
+{
+    auto job = new FutureJob;
+    auto source = future;
+    job->setCanceler([source] () mutable { source.cancel(); });
+
+    QPointer<FutureJob> guard(job);
+    future.onFinished([guard, source] {
+        if (!guard)
+            return;
+
+        if (source.isCanceled())
+            guard->setFinished(KJob::KilledJobError, source.errorText());
+        else
+            guard->setFinished(source.error(), source.errorText());
+    });
+    return job;
+}
+
+// Number of job based futures not finished yet
+int pendingFutureCount();
+
+}
+
+#endif // UTILS_FUTURE_H
@@ -0,0 +1,46 @@
+/* This file is part of Zanshin
+
+   Copyright 2016 Kevin Ottens <ervin@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+#include "availablepagesdelegate.h"
+
+#include <KLocalizedString>
+
+#include "presentation/querytreemodelbase.h"
+
+using namespace Widgets;
+
+AvailablePagesDelegate::AvailablePagesDelegate(QObject *parent)
+    : QStyledItemDelegate(parent)
+{
+}
+
+void AvailablePagesDelegate::initStyleOption(QStyleOptionViewItem *option, const QModelIndex &index) const
+{
+    QStyledItemDelegate::initStyleOption(option, index);
+
+    // Pages without count or without items keep their plain name
+    const auto count = index.data(Presentation::QueryTreeModelBase::CountRole).toInt();
+    if (count > 0)
+        option->text = i18nc("page name followed by its number of items", "%1 (%2)", option->text, count);
+}
@@ -37,6 +37,7 @@
 #include "presentation/metatypes.h"
 #include "presentation/querytreemodelbase.h"
 
+#include "widgets/availablepagesdelegate.h"
 #include "widgets/messagebox.h"
 #include "widgets/newprojectdialog.h"
 #include "widgets/quickselectdialog.h"
@@ -61,6 +62,7 @@ AvailablePagesView::AvailablePagesView(QWidget *parent)
     m_pagesView->setObjectName(QStringLiteral("pagesView"));
     m_pagesView->header()->hide();
     m_pagesView->setDragDropMode(QTreeView::DropOnly);
+    m_pagesView->setItemDelegate(new AvailablePagesDelegate(m_pagesView));
 
     auto actionBar = new QToolBar(this);
     actionBar->setObjectName(QStringLiteral("actionBar"));
@@ -27,20 +27,30 @@
 #include <QBoxLayout>
 #include <QComboBox>
 #include <QLineEdit>
+#include <QTimer>
 #include <QToolButton>
 
 #include <KLocalizedString>
 
 #include "presentation/artifactfilterproxymodel.h"
+#include "presentation/artifactsearch.h"
 
 #include "ui_filterwidget.h"
 
 using namespace Widgets;
 
+namespace {
+    const int FilterDelay = 150;
+}
+
 FilterWidget::FilterWidget(QWidget *parent)
     : QWidget(parent),
       ui(new Ui::FilterWidget),
-      m_model(new Presentation::ArtifactFilterProxyModel(this))
+      m_model(new Presentation::ArtifactFilterProxyModel(this)),
+      m_asynchronous(true),
+      m_filterTimer(new QTimer(this)),
+      m_search(Q_NULLPTR),
+      m_searchRevision(0)
 {
     ui->setupUi(this);
     ui->extension->hide();
@@ -48,6 +58,10 @@ FilterWidget::FilterWidget(QWidget *parent)
     ui->sortTypeCombo->addItem(i18n("Sort by date"), Presentation::ArtifactFilterProxyModel::DateSort);
     setFocusProxy(ui->filterEdit);
 
+    m_filterTimer->setSingleShot(true);
+    m_filterTimer->setInterval(FilterDelay);
+    connect(m_filterTimer, &QTimer::timeout, this, &FilterWidget::onFilterTimeout);
+
     connect(ui->filterEdit, &QLineEdit::textChanged, this, &FilterWidget::onTextChanged);
     connect(ui->sortTypeCombo, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged), this, &FilterWidget::onSortTypeChanged);
     connect(ui->ascendingButton, &QToolButton::clicked, this, &FilterWidget::onAscendingClicked);
@@ -57,6 +71,7 @@ FilterWidget::FilterWidget(QWidget *parent)
 
 FilterWidget::~FilterWidget()
 {
+    cancelSearch();
     delete ui;
 }
 
@@ -65,6 +80,16 @@ Presentation::ArtifactFilterProxyModel *FilterWidget::proxyModel() const
     return m_model;
 }
 
+bool FilterWidget::isAsynchronous() const
+{
+    return m_asynchronous;
+}
+
+void FilterWidget::setAsynchronous(bool asynchronous)
+{
+    m_asynchronous = asynchronous;
+}
+
 void FilterWidget::clear()
 {
     ui->filterEdit->clear();
@@ -72,7 +97,16 @@ void FilterWidget::clear()
 
 void FilterWidget::onTextChanged(const QString &text)
 {
-    m_model->setFilterFixedString(text);
+    // Nothing to search for when the filter goes away
+    if (!m_asynchronous || text.isEmpty()) {
+        m_filterTimer->stop();
+        cancelSearch();
+        m_model->setFilterFixedString(text);
+        return;
+    }
+
+    cancelSearch();
+    m_filterTimer->start();
 }
 
 void FilterWidget::onSortTypeChanged(int index)
@@ -95,3 +129,30 @@ void FilterWidget::onShowFutureChanged(bool show)
 {
     m_model->setShowFutureTasks(show);
 }
+
+void FilterWidget::onFilterTimeout()
+{
+    cancelSearch();
+
+    m_searchRevision = m_model->textIndexRevision();
+    m_search = new Presentation::ArtifactSearch(m_model->textIndex(), ui->filterEdit->text(), this);
+    connect(m_search, &Presentation::ArtifactSearch::finished, this, &FilterWidget::onSearchFinished);
+    m_search->start();
+}
+
+void FilterWidget::onSearchFinished()
+{
+    m_model->setFilterMatches(m_search->text(), m_search->matches(), m_searchRevision);
+    m_search->deleteLater();
+    m_search = Q_NULLPTR;
+}
+
+void FilterWidget::cancelSearch()
+{
+    if (!m_search)
+        return;
+
+    m_search->cancel();
+    delete m_search;
+    m_search = Q_NULLPTR;
+}
@@ -29,10 +29,12 @@
 
 class QComboBox;
 class QLineEdit;
+class QTimer;
 
 namespace Presentation
 {
     class ArtifactFilterProxyModel;
+    class ArtifactSearch;
 }
 
 namespace Ui {
@@ -50,6 +52,11 @@ public:
 
     Presentation::ArtifactFilterProxyModel *proxyModel() const;
 
+    // When enabled, filtering waits for the typing to pause and the
+    // matching happens on a worker thread
+    bool isAsynchronous() const;
+    void setAsynchronous(bool asynchronous);
+
 public slots:
     void clear();
 
@@ -59,10 +66,18 @@ private slots:
     void onAscendingClicked();
     void onDescendingClicked();
     void onShowFutureChanged(bool show);
+    void onFilterTimeout();
+    void onSearchFinished();
 
 private:
+    void cancelSearch();
+
     Ui::FilterWidget *ui;
     Presentation::ArtifactFilterProxyModel *m_model;
+    bool m_asynchronous;
+    QTimer *m_filterTimer;
+    Presentation::ArtifactSearch *m_search;
+    int m_searchRevision;
 };
 
 }
@@ -25,6 +25,7 @@
 #include "itemdelegate.h"
 
 #include <QApplication>
+#include <QEvent>
 #include <QPainter>
 #include <QStyleOptionViewItem>
 
@@ -36,8 +37,27 @@
 
 using namespace Widgets;
 
+namespace {
+
+Domain::Artifact::Ptr artifactForIndex(const QModelIndex &index)
+{
+    const auto data = index.data(Presentation::QueryTreeModelBase::ObjectRole);
+
+    auto artifact = data.value<Domain::Artifact::Ptr>();
+    if (!artifact) {
+        auto task = data.value<Domain::Task::Ptr>();
+        auto note = data.value<Domain::Note::Ptr>();
+        artifact = task ? task.staticCast<Domain::Artifact>()
+                        : note.staticCast<Domain::Artifact>();
+    }
+    return artifact;
+}
+
+}
+
 ItemDelegate::ItemDelegate(QObject *parent)
-    : QStyledItemDelegate(parent)
+    : QStyledItemDelegate(parent),
+      m_model(Q_NULLPTR)
 {
 }
 
@@ -48,7 +68,11 @@ QSize ItemDelegate::sizeHint(const QStyleOptionViewItem &option,
     QStyleOptionViewItem opt = option;
     initStyleOption(&opt, index);
     opt.features = QStyleOptionViewItem::HasCheckIndicator;
-    opt.text += ' ' + QLocale().dateFormat(QLocale::ShortFormat).toUpper() + ' ';
+    if (m_sizeHintPadding.isEmpty() || m_sizeHintLocale != opt.locale) {
+        m_sizeHintLocale = opt.locale;
+        m_sizeHintPadding = ' ' + opt.locale.dateFormat(QLocale::ShortFormat).toUpper() + ' ';
+    }
+    opt.text += m_sizeHintPadding;
     return QStyledItemDelegate::sizeHint(opt, index);
 }
 
@@ -56,96 +80,202 @@ void ItemDelegate::paint(QPainter *painter,
                          const QStyleOptionViewItem &option,
                          const QModelIndex &index) const
 {
-    const auto data = index.data(Presentation::QueryTreeModelBase::ObjectRole);
+    watch(index.model(), option.widget);
 
-    auto task = Domain::Task::Ptr();
-    auto artifact = data.value<Domain::Artifact::Ptr>();
-    if (artifact) {
-        task = artifact.dynamicCast<Domain::Task>();
-    } else {
-        task = data.value<Domain::Task::Ptr>();
-        auto note = data.value<Domain::Note::Ptr>();
-        artifact = task ? task.staticCast<Domain::Artifact>()
-                        : note.staticCast<Domain::Artifact>();
+    const auto today = QDate::currentDate();
+    if (m_layoutDate != today) {
+        m_layoutCache.clear();
+        m_layoutDate = today;
+    }
+
+    // A dead artifact means its address got reused by a new one
+    const auto artifact = artifactForIndex(index);
+    auto cached = m_layoutCache.constFind(artifact.data());
+    if (cached == m_layoutCache.constEnd()
+     || cached->artifact.isNull()
+     || cached->size != option.rect.size()) {
+        cached = m_layoutCache.insert(artifact.data(), createLayout(option, index, artifact));
     }
+    const auto &layout = *cached;
 
     auto opt = QStyleOptionViewItem(option);
-    initStyleOption(&opt, index);
+    opt.features |= layout.features;
     const auto widget = opt.widget;
     const auto style = widget ? widget->style() : QApplication::style();
+    const auto topLeft = opt.rect.topLeft();
 
-    const auto isDone = task ? task->isDone() : false;
     const auto isEnabled = (opt.state & QStyle::State_Enabled);
     const auto isActive = (opt.state & QStyle::State_Active);
     const auto isSelected = (opt.state & QStyle::State_Selected);
     const auto isEditing = (opt.state & QStyle::State_Editing);
 
-    const auto startDate = task ? task->startDate() : QDateTime();
-    const auto dueDate = task ? task->dueDate() : QDateTime();
-
-    const auto onStartDate = startDate.isValid() && startDate.date() <= QDate::currentDate();
-    const auto pastDueDate = dueDate.isValid() && dueDate.date() < QDate::currentDate();
-    const auto onDueDate = dueDate.isValid() && dueDate.date() == QDate::currentDate();
-
-    const auto taskDelegate = task ? task->delegate() : Domain::Task::Delegate();
-
-    const auto baseFont = opt.font;
-    const auto summaryFont = [=] {
-        auto font = baseFont;
-        font.setStrikeOut(isDone);
-        font.setBold(!isDone && (onStartDate || onDueDate || pastDueDate));
-        font.setItalic(taskDelegate.isValid());
-        return font;
-    }();
-    const auto summaryMetrics = QFontMetrics(summaryFont);
-
     const auto colorGroup = (isEnabled && !isActive) ? QPalette::Inactive
                           : isEnabled ? QPalette::Normal
                           : QPalette::Disabled;
     const auto colorRole = (isSelected && !isEditing) ? QPalette::HighlightedText : QPalette::Text;
-
-    const auto baseColor = opt.palette.color(colorGroup, colorRole);
-    const auto summaryColor = isDone ? baseColor
-                            : pastDueDate ? QColor(Qt::red)
-                            : onDueDate ? QColor("orange")
-                            : baseColor;
-
-    const auto summaryText = taskDelegate.isValid() ? i18n("(%1) %2", taskDelegate.display(), opt.text) : opt.text;
-    const auto dueDateText = dueDate.isValid() ? QLocale().toString(dueDate.date(), QLocale::ShortFormat)
-                                               : QString();
-
-    const auto textMargin = style->pixelMetric(QStyle::PM_FocusFrameHMargin, 0, widget) + 1;
-    const auto dueDateWidth = dueDate.isValid() ? (summaryMetrics.width(dueDateText) + 2 * textMargin) : 0;
-
-
-    const auto checkRect = style->subElementRect(QStyle::SE_ItemViewItemCheckIndicator, &opt, widget);
-    const auto summaryRect = style->subElementRect(QStyle::SE_ItemViewItemText, &opt, widget)
-                             .adjusted(textMargin, 0, -dueDateWidth - textMargin, 0);
-    const auto dueDateRect = opt.rect.adjusted(opt.rect.width() - dueDateWidth, 0, 0, 0);
+    const auto summaryColor = layout.summaryColor.isValid() ? layout.summaryColor
+                                                            : opt.palette.color(colorGroup, colorRole);
 
 
     // Draw background
     style->drawPrimitive(QStyle::PE_PanelItemViewItem, &opt, painter, widget);
 
     // Draw the check box
-    if (task) {
+    if (layout.isTask) {
         auto checkOption = opt;
-        checkOption.rect = checkRect;
+        checkOption.rect = layout.checkRect.translated(topLeft);
         checkOption.state = option.state & ~QStyle::State_HasFocus;
-        checkOption.state |= isDone ? QStyle::State_On : QStyle::State_Off;
+        checkOption.state |= layout.isDone ? QStyle::State_On : QStyle::State_Off;
         style->drawPrimitive(QStyle::PE_IndicatorViewItemCheck, &checkOption, painter, widget);
     }
 
     // Draw the summary
-    if (!summaryText.isEmpty()) {
+    if (!layout.summaryText.isEmpty()) {
         painter->setPen(summaryColor);
-        painter->setFont(summaryFont);
-        painter->drawText(summaryRect, Qt::AlignVCenter,
-                          summaryMetrics.elidedText(summaryText, Qt::ElideRight, summaryRect.width()));
+        painter->setFont(layout.summaryFont);
+        painter->drawText(layout.summaryRect.translated(topLeft), Qt::AlignVCenter, layout.summaryText);
     }
 
     // Draw the due date
-    if (!dueDateText.isEmpty()) {
-        painter->drawText(dueDateRect, Qt::AlignCenter, dueDateText);
+    if (!layout.dueDateText.isEmpty()) {
+        painter->drawText(layout.dueDateRect.translated(topLeft), Qt::AlignCenter, layout.dueDateText);
+    }
+}
+
+bool ItemDelegate::eventFilter(QObject *watched, QEvent *event)
+{
+    if (watched == m_widget.data()
+     && (event->type() == QEvent::LocaleChange
+      || event->type() == QEvent::FontChange
+      || event->type() == QEvent::StyleChange)) {
+        m_layoutCache.clear();
+    }
+
+    return QStyledItemDelegate::eventFilter(watched, event);
+}
+
+ItemDelegate::Layout ItemDelegate::createLayout(const QStyleOptionViewItem &option,
+                                                const QModelIndex &index,
+                                                const Domain::Artifact::Ptr &artifact) const
+{
+    auto opt = QStyleOptionViewItem(option);
+    initStyleOption(&opt, index);
+    const auto widget = opt.widget;
+    const auto style = widget ? widget->style() : QApplication::style();
+    const auto topLeft = opt.rect.topLeft();
+
+    const auto task = artifact.dynamicCast<Domain::Task>();
+    const auto isDone = task ? task->isDone() : false;
+    const auto startDate = task ? task->startDate() : QDateTime();
+    const auto dueDate = task ? task->dueDate() : QDateTime();
+    const auto delegate = task ? task->delegate() : Domain::Task::Delegate();
+
+    const auto onStartDate = startDate.isValid() && startDate.date() <= m_layoutDate;
+    const auto pastDueDate = dueDate.isValid() && dueDate.date() < m_layoutDate;
+    const auto onDueDate = dueDate.isValid() && dueDate.date() == m_layoutDate;
+
+    Layout layout;
+    layout.artifact = artifact;
+    layout.isTask = !task.isNull();
+    layout.isDone = isDone;
+    layout.features = opt.features;
+    layout.size = opt.rect.size();
+
+    layout.summaryFont = opt.font;
+    layout.summaryFont.setStrikeOut(isDone);
+    layout.summaryFont.setBold(!isDone && (onStartDate || onDueDate || pastDueDate));
+    layout.summaryFont.setItalic(delegate.isValid());
+    const auto summaryMetrics = QFontMetrics(layout.summaryFont);
+
+    layout.summaryColor = isDone ? QColor()
+                        : pastDueDate ? QColor(Qt::red)
+                        : onDueDate ? QColor("orange")
+                        : QColor();
+
+    const auto textMargin = style->pixelMetric(QStyle::PM_FocusFrameHMargin, 0, widget) + 1;
+    const auto textRect = style->subElementRect(QStyle::SE_ItemViewItemText, &opt, widget);
+
+    layout.dueDateText = dueDate.isValid() ? opt.locale.toString(dueDate.date(), QLocale::ShortFormat)
+                                           : QString();
+    const auto dueDateWidth = dueDate.isValid() ? (summaryMetrics.width(layout.dueDateText) + 2 * textMargin) : 0;
+
+    const auto summaryText = delegate.isValid() ? i18n("(%1) %2", delegate.display(), opt.text) : opt.text;
+    const auto summaryWidth = textRect.width() - dueDateWidth - 2 * textMargin;
+    layout.summaryText = summaryMetrics.elidedText(summaryText, Qt::ElideRight, summaryWidth);
+
+    layout.checkRect = style->subElementRect(QStyle::SE_ItemViewItemCheckIndicator, &opt, widget).translated(-topLeft);
+    layout.summaryRect = textRect.adjusted(textMargin, 0, -dueDateWidth - textMargin, 0).translated(-topLeft);
+    layout.dueDateRect = opt.rect.adjusted(opt.rect.width() - dueDateWidth, 0, 0, 0).translated(-topLeft);
+
+    return layout;
+}
+
+void ItemDelegate::watch(const QAbstractItemModel *model, const QWidget *widget) const
+{
+    auto self = const_cast<ItemDelegate*>(this);
+
+    if (widget != m_widget) {
+        if (m_widget)
+            m_widget->removeEventFilter(self);
+        m_widget = const_cast<QWidget*>(widget);
+        if (m_widget)
+            m_widget->installEventFilter(self);
+        m_layoutCache.clear();
+    }
+
+    if (model == m_model)
+        return;
+
+    foreach (const auto &connection, m_modelConnections)
+        disconnect(connection);
+    m_modelConnections.clear();
+    m_layoutCache.clear();
+
+    m_model = model;
+    if (!m_model)
+        return;
+
+    m_modelConnections << connect(m_model, &QAbstractItemModel::dataChanged,
+                                  self, [this](const QModelIndex &topLeft, const QModelIndex &bottomRight) {
+        forgetRows(topLeft.parent(), topLeft.row(), bottomRight.row(), false);
+    });
+    m_modelConnections << connect(m_model, &QAbstractItemModel::rowsAboutToBeRemoved,
+                                  self, [this](const QModelIndex &parent, int first, int last) {
+        forgetRows(parent, first, last, true);
+        forgetDeadArtifacts();
+    });
+    m_modelConnections << connect(m_model, &QAbstractItemModel::modelReset,
+                                  self, [this] {
+        m_layoutCache.clear();
+    });
+    m_modelConnections << connect(m_model, &QObject::destroyed,
+                                  self, [this] {
+        m_modelConnections.clear();
+        m_layoutCache.clear();
+        m_model = Q_NULLPTR;
+    });
+}
+
+void ItemDelegate::forgetRows(const QModelIndex &parent, int first, int last, bool withChildren) const
+{
+    for (int row = first; row <= last; row++) {
+        const auto index = m_model->index(row, 0, parent);
+        m_layoutCache.remove(artifactForIndex(index).data());
+
+        const auto childCount = withChildren ? m_model->rowCount(index) : 0;
+        if (childCount > 0)
+            forgetRows(index, 0, childCount - 1, true);
+    }
+}
+
+void ItemDelegate::forgetDeadArtifacts() const
+{
+    // Rows can get another artifact in place, the one they had before
+    // is only noticed once it is gone
+    for (auto it = m_layoutCache.begin(); it != m_layoutCache.end();) {
+        if (it->artifact.isNull())
+            it = m_layoutCache.erase(it);
+        else
+            ++it;
     }
 }
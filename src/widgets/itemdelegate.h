@@ -25,8 +25,16 @@
 #ifndef WIDGETS_ITEMDELEGATE_H
 #define WIDGETS_ITEMDELEGATE_H
 
+#include <QColor>
+#include <QDate>
+#include <QFont>
+#include <QHash>
+#include <QLocale>
+#include <QPointer>
 #include <QStyledItemDelegate>
 
+#include "domain/artifact.h"
+
 namespace Widgets {
 
 class ItemDelegate : public QStyledItemDelegate
@@ -40,6 +48,47 @@ public:
     void paint(QPainter *painter,
                const QStyleOptionViewItem &option,
                const QModelIndex &index) const Q_DECL_OVERRIDE;
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) Q_DECL_OVERRIDE;
+
+private:
+    // Everything paint needs to draw a row except what depends on its
+    // state, it is dropped when the data of the row, the day, the locale,
+    // the font or the style change, rects are relative to the row
+    struct Layout
+    {
+        QWeakPointer<Domain::Artifact> artifact;
+        bool isTask;
+        bool isDone;
+        QStyleOptionViewItem::ViewItemFeatures features;
+        QSize size;
+        QRect checkRect;
+        QRect summaryRect;
+        QRect dueDateRect;
+
+        QFont summaryFont;
+        QColor summaryColor; // Invalid when the row uses the text color
+        QString summaryText;
+        QString dueDateText;
+    };
+
+    Layout createLayout(const QStyleOptionViewItem &option,
+                        const QModelIndex &index,
+                        const Domain::Artifact::Ptr &artifact) const;
+
+    void watch(const QAbstractItemModel *model, const QWidget *widget) const;
+    void forgetRows(const QModelIndex &parent, int first, int last, bool withChildren) const;
+    void forgetDeadArtifacts() const;
+
+    mutable QHash<const Domain::Artifact*, Layout> m_layoutCache;
+    mutable QDate m_layoutDate;
+    mutable const QAbstractItemModel *m_model;
+    mutable QList<QMetaObject::Connection> m_modelConnections;
+    mutable QPointer<QWidget> m_widget;
+
+    mutable QLocale m_sizeHintLocale;
+    mutable QString m_sizeHintPadding;
 };
 
 }
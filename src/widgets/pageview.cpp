@@ -137,6 +137,7 @@ PageView::PageView(QWidget *parent)
     m_centralView->setObjectName(QStringLiteral("centralView"));
     m_centralView->header()->hide();
     m_centralView->setAlternatingRowColors(true);
+    m_centralView->setUniformRowHeights(true);
     m_centralView->setItemDelegate(new ItemDelegate(this));
     m_centralView->setDragDropMode(QTreeView::DragDrop);
     m_centralView->setSelectionMode(QAbstractItemView::ExtendedSelection);
@@ -365,11 +366,19 @@ void PageView::onRemoveItemRequested()
             return;
     }
 
+    QModelIndexList validIndexes;
     foreach (const QModelIndex &currentIndex, currentIndexes) {
-        if (!currentIndex.isValid())
-            continue;
+        if (currentIndex.isValid())
+            validIndexes << currentIndex;
+    }
+
+    if (validIndexes.isEmpty())
+        return;
+
+    // The whole selection goes to the model in one go
+    QMetaObject::invokeMethod(m_model, "removeItems", Q_ARG(QModelIndexList, validIndexes));
 
-        QMetaObject::invokeMethod(m_model, "removeItem", Q_ARG(QModelIndex, currentIndex));
+    foreach (const QModelIndex &currentIndex, validIndexes) {
         const auto data = currentIndex.data(Presentation::QueryTreeModelBase::ObjectRole);
         if (data.isValid()) {
             auto task = data.value<Domain::Artifact::Ptr>().objectCast<Domain::Task>();
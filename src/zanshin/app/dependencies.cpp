@@ -98,7 +98,8 @@ void App::initializeDependencies()
     deps.add<Domain::TaskRepository,
              Akonadi::TaskRepository(Akonadi::StorageInterface*,
                                      Akonadi::SerializerInterface*,
-                                     Akonadi::MessagingInterface*)>();
+                                     Akonadi::MessagingInterface*,
+                                     Akonadi::Cache*)>();
 
     deps.add<Presentation::ArtifactEditorModel>([] (Utils::DependencyManager *deps) {
         auto model = new Presentation::ArtifactEditorModel;
@@ -23,6 +23,8 @@
 */
 
 #include <QApplication>
+#include <QCommandLineParser>
+#include <QTextStream>
 #include <KConfigGroup>
 #include <KSharedConfig>
 #include "zanshin021migrator.h"
@@ -31,21 +33,34 @@ int main(int argc, char **argv)
 {
     QApplication app(argc, argv);
 
-    // Qt5 TODO use QCommandLineParser
-    const bool force = (argc > 1 && QByteArray(argv[1]) == "--force");
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addOption(QCommandLineOption(QStringLiteral("force"), QStringLiteral("Migrate even if it was done already")));
+    parser.addOption(QCommandLineOption(QStringLiteral("dry-run"), QStringLiteral("Only report what would be migrated")));
+    parser.addOption(QCommandLineOption(QStringLiteral("chunk-size"), QStringLiteral("Number of items written per transaction"),
+                                        QStringLiteral("count"), QStringLiteral("100")));
+    parser.process(app);
+
+    const bool force = parser.isSet(QStringLiteral("force"));
+    const bool dryRun = parser.isSet(QStringLiteral("dry-run"));
 
     Zanshin021Migrator migrator;
+    migrator.setDryRun(dryRun);
+    migrator.setChunkSize(parser.value(QStringLiteral("chunk-size")).toInt());
+    migrator.setProgressFunction([] (int done, int total) {
+        QTextStream(stdout) << "Migrated " << done << " of " << total << " projects" << endl;
+    });
 
     KSharedConfig::Ptr config = KSharedConfig::openConfig(QStringLiteral("zanshin-migratorrc"));
     KConfigGroup group = config->group("Migrations");
-    if (force || !group.readEntry("Migrated021Projects", false)) {
+    if (force || dryRun || !group.readEntry("Migrated021Projects", false)) {
         if (!migrator.migrateProjects()) {
             return 1;
         }
-        group.writeEntry("Migrated021Projects", true);
+        if (!dryRun)
+            group.writeEntry("Migrated021Projects", true);
     }
     config->sync();
 
     return 0;
 };
-
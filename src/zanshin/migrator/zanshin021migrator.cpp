@@ -23,17 +23,59 @@
 
 #include "zanshin021migrator.h"
 #include <akonadi/akonadicollectionfetchjobinterface.h>
-#include <akonadi/akonadiitemfetchjobinterface.h>
 
-#include <AkonadiCore/TransactionSequence>
+#include <AkonadiCore/ItemFetchJob>
+#include <AkonadiCore/ItemFetchScope>
 #include <AkonadiCore/ItemModifyJob>
+#include <AkonadiCore/TransactionSequence>
 
+#include <QDebug>
+#include <QEventLoop>
 #include <QStringList>
+#include <QTextStream>
 #include <KCalCore/Todo>
 
 Zanshin021Migrator::Zanshin021Migrator()
+    : m_maxConcurrentFetches(4),
+      m_chunkSize(100),
+      m_dryRun(false)
+{
+
+}
+
+int Zanshin021Migrator::maxConcurrentFetches() const
+{
+    return m_maxConcurrentFetches;
+}
+
+void Zanshin021Migrator::setMaxConcurrentFetches(int count)
+{
+    m_maxConcurrentFetches = qMax(1, count);
+}
+
+int Zanshin021Migrator::chunkSize() const
+{
+    return m_chunkSize;
+}
+
+void Zanshin021Migrator::setChunkSize(int size)
 {
+    m_chunkSize = qMax(1, size);
+}
+
+bool Zanshin021Migrator::isDryRun() const
+{
+    return m_dryRun;
+}
+
+void Zanshin021Migrator::setDryRun(bool dryRun)
+{
+    m_dryRun = dryRun;
+}
 
+void Zanshin021Migrator::setProgressFunction(const ProgressFunction &function)
+{
+    m_progressFunction = function;
 }
 
 bool Zanshin021Migrator::isProject(const Akonadi::Item& item)
@@ -43,73 +85,155 @@ bool Zanshin021Migrator::isProject(const Akonadi::Item& item)
 }
 
 
-Zanshin021Migrator::SeenItemHash Zanshin021Migrator::fetchAllItems()
+Zanshin021Migrator::SeenItemHash Zanshin021Migrator::fetchAllItems(bool *ok)
 {
     SeenItemHash hash;
+    bool success = true;
 
     auto collectionsJob = m_storage.fetchCollections(Akonadi::Collection::root(), Akonadi::Storage::Recursive, Akonadi::StorageInterface::Tasks);
-    collectionsJob->kjob()->exec();
-
-    auto collections = collectionsJob->collections();
-    foreach (const auto &collection, collections) {
-        auto job = m_storage.fetchItems(collection);
-        job->kjob()->exec();
-        auto items = job->items();
-        foreach (const Akonadi::Item &item, items) {
-            if (item.hasPayload<KCalCore::Todo::Ptr>()) {
-                auto todo = item.payload<KCalCore::Todo::Ptr>();
-                hash.insert(todo->uid(), SeenItem(item));
-            }
-        }
+    if (!collectionsJob->kjob()->exec()) {
+        qWarning() << "Couldn't fetch collections:" << collectionsJob->kjob()->errorString();
+        if (ok)
+            *ok = false;
+        return hash;
     }
 
+    // The collections are fetched in parallel and their items are processed
+    // batch by batch as they arrive, only the table entries are kept
+    auto pendingCollections = collectionsJob->collections();
+    int runningJobs = 0;
+    QEventLoop loop;
+
+    std::function<void()> startFetches;
+    startFetches = [&] {
+        while (runningJobs < m_maxConcurrentFetches && !pendingCollections.isEmpty()) {
+            auto job = new Akonadi::ItemFetchJob(pendingCollections.takeFirst());
+            // The payload is needed to know the uid, parent and project markers, nothing else is
+            job->fetchScope().fetchFullPayload();
+            job->setDeliveryOption(Akonadi::ItemFetchJob::EmitItemsInBatches);
+
+            QObject::connect(job, &Akonadi::ItemFetchJob::itemsReceived, [&hash] (const Akonadi::Item::List &items) {
+                foreach (const Akonadi::Item &item, items) {
+                    if (item.hasPayload<KCalCore::Todo::Ptr>()) {
+                        auto todo = item.payload<KCalCore::Todo::Ptr>();
+                        hash.insert(todo->uid(), SeenItem(item.id(), todo->relatedTo(), isProject(item),
+                                                          todo->comments().contains(QStringLiteral("X-Zanshin-Project"))));
+                    }
+                }
+            });
+            QObject::connect(job, &KJob::result, [&] (KJob *fetchJob) {
+                if (fetchJob->error()) {
+                    // Migrating with part of the items could leave projects half done
+                    qWarning() << "Couldn't fetch items:" << fetchJob->errorString();
+                    success = false;
+                    pendingCollections.clear();
+                }
+                runningJobs--;
+                startFetches();
+                if (runningJobs == 0)
+                    loop.quit();
+            });
+
+            runningJobs++;
+        }
+    };
+
+    startFetches();
+    if (runningJobs > 0)
+        loop.exec();
+
+    if (ok)
+        *ok = success;
     return hash;
 }
 
-void Zanshin021Migrator::markAsProject(SeenItem& seenItem, Akonadi::TransactionSequence* sequence)
+void Zanshin021Migrator::markAsProject(SeenItem& seenItem)
 {
-    Akonadi::Item &item = seenItem.item();
-    if (!isProject(item)) {
-        auto todo = item.payload<KCalCore::Todo::Ptr>();
-        todo->setCustomProperty("Zanshin", "Project", QStringLiteral("1"));
-        item.setPayload(todo);
+    if (!seenItem.isProject()) {
         seenItem.setDirty();
-        qDebug() << "Marking as project:" << item.id() << item.remoteId() << todo->summary();
-        new Akonadi::ItemModifyJob(item, sequence);
+        qDebug() << "Marking as project:" << seenItem.id();
     }
 }
 
-void Zanshin021Migrator::migrateProjectComments(Zanshin021Migrator::SeenItemHash& items, Akonadi::TransactionSequence* sequence)
+void Zanshin021Migrator::reportProgress(int done, int total)
+{
+    if (m_progressFunction)
+        m_progressFunction(done, total);
+}
+
+void Zanshin021Migrator::migrateProjectComments(Zanshin021Migrator::SeenItemHash& items)
 {
     for (SeenItemHash::iterator it = items.begin(); it != items.end(); ++it) {
         SeenItem &seenItem = it.value();
-        Akonadi::Item &item = seenItem.item();
-        auto todo = item.payload<KCalCore::Todo::Ptr>();
-        if (todo->comments().contains(QStringLiteral("X-Zanshin-Project")))
-            markAsProject(seenItem, sequence);
+        if (seenItem.hasProjectComment())
+            markAsProject(seenItem);
     }
 }
 
-void Zanshin021Migrator::migrateProjectWithChildren(Zanshin021Migrator::SeenItemHash& items, Akonadi::TransactionSequence* sequence)
+void Zanshin021Migrator::migrateProjectWithChildren(Zanshin021Migrator::SeenItemHash& items)
 {
     for (SeenItemHash::iterator it = items.begin(); it != items.end(); ++it) {
-        const SeenItem &seenItem = it.value();
-        const auto todo = seenItem.item().payload<KCalCore::Todo::Ptr>();
-        const QString parentUid = todo->relatedTo();
+        const QString parentUid = it.value().relatedTo();
         if (!parentUid.isEmpty()) {
             auto parentIt = items.find(parentUid);
             if (parentIt != items.end())
-                markAsProject(*parentIt, sequence);
+                markAsProject(*parentIt);
         }
     }
 }
 
-bool Zanshin021Migrator::migrateProjects()
+bool Zanshin021Migrator::commitProjects(const Zanshin021Migrator::SeenItemHash& items)
 {
-    SeenItemHash items = fetchAllItems();
-    auto sequence = new Akonadi::TransactionSequence;
-    migrateProjectComments(items, sequence);
-    migrateProjectWithChildren(items, sequence);
-    return sequence->exec();
+    Akonadi::Item::List dirtyItems;
+    for (auto it = items.constBegin(); it != items.constEnd(); ++it) {
+        if (it.value().isDirty())
+            dirtyItems << Akonadi::Item(it.value().id());
+    }
+
+    const int total = dirtyItems.size();
+    reportProgress(0, total);
+
+    if (m_dryRun) {
+        QTextStream(stdout) << "Dry run, " << total << " items would be marked as project" << endl;
+        return true;
+    }
+
+    // The payloads are fetched again chunk by chunk, and each chunk gets
+    // written in its own transaction to keep the jobs and memory bounded
+    for (int i = 0; i < total; i += m_chunkSize) {
+        auto fetchJob = new Akonadi::ItemFetchJob(dirtyItems.mid(i, m_chunkSize));
+        fetchJob->fetchScope().fetchFullPayload();
+        if (!fetchJob->exec())
+            return false;
+
+        auto sequence = new Akonadi::TransactionSequence;
+        foreach (Akonadi::Item item, fetchJob->items()) {
+            if (!item.hasPayload<KCalCore::Todo::Ptr>())
+                continue;
+
+            auto todo = item.payload<KCalCore::Todo::Ptr>();
+            todo->setCustomProperty("Zanshin", "Project", QStringLiteral("1"));
+            item.setPayload(todo);
+            new Akonadi::ItemModifyJob(item, sequence);
+        }
+
+        if (!sequence->exec())
+            return false;
+
+        reportProgress(qMin(i + m_chunkSize, total), total);
+    }
+
+    return true;
 }
 
+bool Zanshin021Migrator::migrateProjects()
+{
+    bool ok = false;
+    SeenItemHash items = fetchAllItems(&ok);
+    if (!ok)
+        return false;
+
+    migrateProjectComments(items);
+    migrateProjectWithChildren(items);
+    return commitProjects(items);
+}
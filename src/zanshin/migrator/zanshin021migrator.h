@@ -24,47 +24,83 @@
 #ifndef ZANSHIN021MIGRATOR_H
 #define ZANSHIN021MIGRATOR_H
 
+#include <functional>
+
 #include <AkonadiCore/Item>
 #include <akonadi/akonadistorage.h>
 
-namespace Akonadi {
-    class TransactionSequence;
-}
-
+// What the migration needs to know about a todo, its payload isn't kept
+// around so that big collections don't end up entirely in memory
 class SeenItem
 {
 public:
-    explicit SeenItem(const Akonadi::Item &theItem)
-        : m_item(theItem), m_dirty(false)
+    SeenItem(Akonadi::Item::Id id, const QString &relatedTo, bool isProject, bool hasProjectComment)
+        : m_id(id), m_relatedTo(relatedTo), m_flags(0)
     {
+        if (isProject)
+            m_flags |= ProjectFlag;
+        if (hasProjectComment)
+            m_flags |= ProjectCommentFlag;
     }
     // invalid item, for QHash::value
     SeenItem()
-        : m_item(Akonadi::Item()), m_dirty(false)
+        : m_id(-1), m_flags(0)
     {
     }
-    bool isDirty() const { return m_dirty; }
-    void setDirty() { m_dirty = true; }
 
-    Akonadi::Item &item() { return m_item; }
-    const Akonadi::Item &item() const { return m_item; }
+    Akonadi::Item::Id id() const { return m_id; }
+    QString relatedTo() const { return m_relatedTo; }
+    bool isProject() const { return m_flags & ProjectFlag; }
+    bool hasProjectComment() const { return m_flags & ProjectCommentFlag; }
+
+    bool isDirty() const { return m_flags & DirtyFlag; }
+    // the item will be written as a project
+    void setDirty() { m_flags |= ProjectFlag | DirtyFlag; }
 
 private:
-    Akonadi::Item m_item;
-    bool m_dirty;
+    enum Flag {
+        ProjectFlag = 0x1,
+        ProjectCommentFlag = 0x2,
+        DirtyFlag = 0x4
+    };
+
+    Akonadi::Item::Id m_id;
+    QString m_relatedTo;
+    quint8 m_flags;
 };
 
 class Zanshin021Migrator
 {
 public:
+    // Number of modified items written so far, out of the total to write
+    typedef std::function<void(int, int)> ProgressFunction;
+
     Zanshin021Migrator();
 
+    // Collections fetched at the same time
+    int maxConcurrentFetches() const;
+    void setMaxConcurrentFetches(int count);
+
+    // Items fetched and written in a single transaction
+    int chunkSize() const;
+    void setChunkSize(int size);
+
+    // When set, the items to migrate are only reported, nothing gets written
+    bool isDryRun() const;
+    void setDryRun(bool dryRun);
+
+    void setProgressFunction(const ProgressFunction &function);
+
     typedef QHash<QString /*uid*/, SeenItem> SeenItemHash;
-    SeenItemHash fetchAllItems();
+    // ok is set to false if some collections or items couldn't be fetched
+    SeenItemHash fetchAllItems(bool *ok = Q_NULLPTR);
 
-    void migrateProjectComments(Zanshin021Migrator::SeenItemHash& items, Akonadi::TransactionSequence* sequence);
+    void migrateProjectComments(Zanshin021Migrator::SeenItemHash& items);
 
-    void migrateProjectWithChildren(Zanshin021Migrator::SeenItemHash& items, Akonadi::TransactionSequence* sequence);
+    void migrateProjectWithChildren(Zanshin021Migrator::SeenItemHash& items);
+
+    // Writes the dirty items, returns false on the first failing chunk
+    bool commitProjects(const Zanshin021Migrator::SeenItemHash& items);
 
     bool migrateProjects();
 
@@ -72,10 +108,14 @@ public:
     static bool isProject(const Akonadi::Item &item);
 
 private:
-    void markAsProject(SeenItem &seenItem, Akonadi::TransactionSequence* sequence);
+    void markAsProject(SeenItem &seenItem);
+    void reportProgress(int done, int total);
 
     Akonadi::Storage m_storage;
-
+    int m_maxConcurrentFetches;
+    int m_chunkSize;
+    bool m_dryRun;
+    ProgressFunction m_progressFunction;
 };
 
 #endif // ZANSHIN021MIGRATOR_H
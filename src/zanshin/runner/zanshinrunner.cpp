@@ -25,43 +25,93 @@
 #include "zanshinrunner.h"
 
 #include "domain/task.h"
+#include "akonadi/akonadicachingstorage.h"
+#include "akonadi/akonadimonitorimpl.h"
 #include "akonadi/akonaditaskrepository.h"
+#include "akonadi/akonaditasksearchindexer.h"
 #include "akonadi/akonadiserializer.h"
 #include "akonadi/akonadistorage.h"
+#include "akonadi/akonadistoragesettings.h"
 
+#include <QAction>
 #include <QIcon>
+#include <QProcess>
 
 #include <KConfig>
 #include <KLocalizedString>
 
 K_EXPORT_PLASMA_RUNNER(zanshin, ZanshinRunner)
-Domain::TaskRepository::Ptr createTaskRepository()
-{
-    using namespace Akonadi;
-    auto repository = new TaskRepository(StorageInterface::Ptr(new Storage),
-                                         SerializerInterface::Ptr(new Serializer),
-                                         MessagingInterface::Ptr());
-    return Domain::TaskRepository::Ptr(repository);
-}
 
 ZanshinRunner::ZanshinRunner(QObject *parent, const QVariantList &args)
-    : Plasma::AbstractRunner(parent, args),
-      m_taskRepository(createTaskRepository())
+    : Plasma::AbstractRunner(parent, args)
 {
     setObjectName(QStringLiteral("Zanshin"));
     setIgnoredTypes(Plasma::RunnerContext::Directory | Plasma::RunnerContext::File |
                     Plasma::RunnerContext::NetworkLocation | Plasma::RunnerContext::Help);
+
+    // The settings keep the configuration they were created with, they get
+    // created here on zanshinrc so that the rest of KRunner keeps its own
+    KConfig::setMainConfigName(QStringLiteral("zanshinrc"));
+    Akonadi::StorageSettings::instance();
+    KConfig::setMainConfigName(QString());
+
+    using namespace Akonadi;
+    m_serializer = SerializerInterface::Ptr(new Serializer);
+    // We only look at tasks, no need for their tags, attributes or notes
+    m_monitor = MonitorInterface::Ptr(new MonitorImpl(MonitorImpl::TaskItemScope));
+    // Going through the cache avoids fetching all the collections again on each quick-add
+    // when no default collection is configured, and keeps the items around for the search
+    m_cache = Cache::Ptr::create(m_serializer, m_monitor);
+    m_storage = StorageInterface::Ptr(new CachingStorage(m_cache, StorageInterface::Ptr(new Storage)));
+    m_taskRepository = Domain::TaskRepository::Ptr(new TaskRepository(m_storage, m_serializer,
+                                                                      MessagingInterface::Ptr(),
+                                                                      m_cache));
+
+    addAction(QStringLiteral("complete"), QIcon::fromTheme(QStringLiteral("task-complete")), i18n("Mark as done"));
+
+    connect(this, &Plasma::AbstractRunner::prepare, this, &ZanshinRunner::onPrepare);
 }
 
 ZanshinRunner::~ZanshinRunner()
 {
 }
 
+void ZanshinRunner::onPrepare()
+{
+    // The index is only built when the runner gets used the first time, then
+    // the monitor keeps it up to date. It's done here since the matching
+    // happens in other threads.
+    if (!m_searchIndex) {
+        m_searchIndex = Domain::TaskSearchIndex::Ptr::create();
+        new Akonadi::TaskSearchIndexer(m_storage, m_serializer, m_monitor, m_searchIndex, this);
+    }
+}
+
 void ZanshinRunner::match(Plasma::RunnerContext &context)
 {
     const QString command = context.query().trimmed();
 
     if (!command.startsWith(QStringLiteral("todo:"), Qt::CaseInsensitive)) {
+        if (!m_searchIndex || command.size() < 3)
+            return;
+
+        QList<Plasma::QueryMatch> matches;
+
+        foreach (const auto &hit, m_searchIndex->search(command, 10)) {
+            const bool isPrefix = hit.title.startsWith(command, Qt::CaseInsensitive);
+
+            Plasma::QueryMatch match(this);
+            match.setData(hit.id);
+            match.setType(isPrefix ? Plasma::QueryMatch::CompletionMatch : Plasma::QueryMatch::PossibleMatch);
+            match.setIcon(QIcon::fromTheme(QStringLiteral("view-task")));
+            match.setText(hit.title);
+            match.setSubtext(i18n("Open task in Zanshin"));
+            match.setRelevance(isPrefix ? 0.8 : 0.6);
+
+            matches << match;
+        }
+
+        context.addMatches(matches);
         return;
     }
 
@@ -88,13 +138,31 @@ void ZanshinRunner::run(const Plasma::RunnerContext &context, const Plasma::Quer
 {
     Q_UNUSED(context)
 
-    KConfig::setMainConfigName("zanshinrc");
+    // Search hits only carry the item id, the task is built from the cache
+    if (match.data().userType() == QMetaType::LongLong) {
+        if (match.selectedAction() == action(QStringLiteral("complete"))) {
+            auto task = m_serializer->createTaskFromItem(m_cache->item(match.data().toLongLong()));
+            if (task) {
+                task->setDone(true);
+                m_taskRepository->update(task);
+            }
+        } else {
+            QProcess::startDetached(QStringLiteral("zanshin"));
+        }
+        return;
+    }
 
     auto task = Domain::Task::Ptr::create();
     task->setTitle(match.data().toString());
     m_taskRepository->create(task);
+}
 
-    KConfig::setMainConfigName(QString());
+QList<QAction*> ZanshinRunner::actionsForMatch(const Plasma::QueryMatch &match)
+{
+    if (match.data().userType() != QMetaType::LongLong)
+        return QList<QAction*>();
+
+    return QList<QAction*>() << action(QStringLiteral("complete"));
 }
 
 #include "zanshinrunner.moc"
@@ -27,7 +27,13 @@
 
 #include <KRunner/AbstractRunner>
 
+#include "akonadi/akonadicache.h"
+#include "akonadi/akonadimonitorinterface.h"
+#include "akonadi/akonadiserializerinterface.h"
+#include "akonadi/akonadistorageinterface.h"
+
 #include "domain/taskrepository.h"
+#include "domain/tasksearchindex.h"
 
 class ZanshinRunner : public Plasma::AbstractRunner
 {
@@ -39,8 +45,18 @@ public:
 
     void match(Plasma::RunnerContext &context);
     void run(const Plasma::RunnerContext &context, const Plasma::QueryMatch &action);
+    QList<QAction*> actionsForMatch(const Plasma::QueryMatch &match);
+
+private slots:
+    void onPrepare();
+
 private:
+    Akonadi::SerializerInterface::Ptr m_serializer;
+    Akonadi::MonitorInterface::Ptr m_monitor;
+    Akonadi::Cache::Ptr m_cache;
+    Akonadi::StorageInterface::Ptr m_storage;
     Domain::TaskRepository::Ptr m_taskRepository;
+    Domain::TaskSearchIndex::Ptr m_searchIndex;
 };
 
 
@@ -0,0 +1,95 @@
+/* This file is part of Zanshin
+
+   Copyright 2016 Kevin Ottens <ervin@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+#include <testlib/qtest_zanshin.h>
+
+#include <QStandardItemModel>
+
+#include "domain/task.h"
+
+#include "presentation/artifactfilterproxymodel.h"
+#include "presentation/querytreemodelbase.h"
+
+// Measures how long it takes to apply a new filter on a big task tree
+class ArtifactFilterBenchmark : public QObject
+{
+    Q_OBJECT
+
+    enum {
+        ProjectCount = 100,
+        TasksPerProject = 500
+    };
+
+    QStandardItem *createTaskItem(int id) const
+    {
+        auto task = Domain::Task::Ptr::create();
+        task->setTitle(QStringLiteral("Task %1").arg(id));
+        task->setText(QStringLiteral("Some longer description for the task number %1, "
+                                     "the kind of text users paste in there").arg(id));
+
+        auto item = new QStandardItem;
+        item->setData(task->title(), Qt::DisplayRole);
+        item->setData(QVariant::fromValue(Domain::Artifact::Ptr(task)),
+                      Presentation::QueryTreeModelBase::ObjectRole);
+        return item;
+    }
+
+private slots:
+    void shouldFilterQuickly_data()
+    {
+        QTest::addColumn<QString>("filter");
+
+        QTest::newRow("no match") << "no such task";
+        QTest::newRow("one match") << "number 4242,";
+        QTest::newRow("few matches") << "task 4242";
+        QTest::newRow("all match") << "description";
+    }
+
+    void shouldFilterQuickly()
+    {
+        QFETCH(QString, filter);
+
+        QStandardItemModel input;
+        for (int i = 0; i < ProjectCount; i++) {
+            auto project = createTaskItem(i);
+            for (int j = 0; j < TasksPerProject; j++)
+                project->appendRow(createTaskItem(ProjectCount + i * TasksPerProject + j));
+            input.appendRow(project);
+        }
+
+        Presentation::ArtifactFilterProxyModel output;
+        output.setSourceModel(&input);
+        output.setShowFutureTasks(true);
+
+        QBENCHMARK {
+            output.setFilterFixedString(filter);
+            output.rowCount();
+            output.setFilterFixedString(QString());
+            output.rowCount();
+        }
+    }
+};
+
+ZANSHIN_TEST_MAIN(ArtifactFilterBenchmark)
+
+#include "artifactfilterbenchmark.moc"
@@ -0,0 +1,147 @@
+/* This file is part of Zanshin
+
+   Copyright 2016 Kevin Ottens <ervin@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+#include <testlib/qtest_zanshin.h>
+
+#include <functional>
+
+#include "domain/livequery.h"
+
+// Measures what it costs a live query to dispatch one event when its steps
+// are type erased and bound at runtime (as LiveQueryIntegrator used to do)
+// compared to steps known at compile time
+class LiveQueryBenchmark : public QObject
+{
+    Q_OBJECT
+
+    enum {
+        OutputCount = 200
+    };
+
+    struct Entry
+    {
+        typedef QSharedPointer<Entry> Ptr;
+
+        explicit Entry(int id) : id(id), value(id) {}
+
+        int id;
+        int value;
+    };
+
+    struct Converter
+    {
+        Entry::Ptr create(int input) { return Entry::Ptr::create(input); }
+        void update(int input, Entry::Ptr &output) { output->value = input; }
+        bool represents(int input, const Entry::Ptr &output) { return output->id == input; }
+    };
+
+    struct InlineFunctions
+    {
+        void fetch(const Domain::LiveQueryInput<int>::AddFunction &add) const
+        {
+            for (int i = 0; i < OutputCount; i++)
+                add(i);
+        }
+
+        bool predicate(int input) const { return input >= 0; }
+        Entry::Ptr convert(int input) const { return converter->create(input); }
+        void update(int input, Entry::Ptr &output) const { converter->update(input, output); }
+        bool represents(int input, const Entry::Ptr &output) const { return converter->represents(input, output); }
+
+        Converter *converter;
+    };
+
+    typedef Domain::LiveQueryInput<int>::Ptr InputPtr;
+    typedef Domain::LiveQueryOutput<Entry::Ptr>::Ptr OutputPtr;
+
+    QPair<InputPtr, OutputPtr> createQuery(bool inlined)
+    {
+        if (inlined) {
+            auto functions = InlineFunctions();
+            functions.converter = &m_converter;
+            auto query = Domain::LiveQueryImpl<int, Entry::Ptr, InlineFunctions>::Ptr::create(functions);
+            return qMakePair(InputPtr(query), OutputPtr(query));
+        }
+
+        using namespace std::placeholders;
+
+        auto query = Domain::LiveQuery<int, Entry::Ptr>::Ptr::create();
+        query->setFetchFunction([] (const Domain::LiveQueryInput<int>::AddFunction &add) {
+            for (int i = 0; i < OutputCount; i++)
+                add(i);
+        });
+        query->setPredicateFunction([] (int input) { return input >= 0; });
+        query->setConvertFunction(std::bind(&Converter::create, &m_converter, _1));
+        query->setUpdateFunction(std::bind(&Converter::update, &m_converter, _1, _2));
+        query->setRepresentsFunction(std::bind(&Converter::represents, &m_converter, _1, _2));
+        return qMakePair(InputPtr(query), OutputPtr(query));
+    }
+
+    void addRows()
+    {
+        QTest::addColumn<bool>("inlined");
+
+        QTest::newRow("std::function") << false;
+        QTest::newRow("inlined") << true;
+    }
+
+private slots:
+    void shouldDispatchChanges_data() { addRows(); }
+    void shouldDispatchChanges()
+    {
+        QFETCH(bool, inlined);
+
+        auto query = createQuery(inlined);
+        auto result = query.second->result();
+        QCOMPARE(result->data().size(), int(OutputCount));
+
+        int i = 0;
+        QBENCHMARK {
+            query.first->onChanged(i++ % OutputCount);
+        }
+
+        QCOMPARE(result->data().size(), int(OutputCount));
+    }
+
+    void shouldDispatchIgnoredAdds_data() { addRows(); }
+    void shouldDispatchIgnoredAdds()
+    {
+        QFETCH(bool, inlined);
+
+        auto query = createQuery(inlined);
+        auto result = query.second->result();
+
+        QBENCHMARK {
+            query.first->onAdded(-1);
+        }
+
+        QCOMPARE(result->data().size(), int(OutputCount));
+    }
+
+private:
+    Converter m_converter;
+};
+
+ZANSHIN_TEST_MAIN(LiveQueryBenchmark)
+
+#include "livequerybenchmark.moc"
@@ -0,0 +1,186 @@
+/* This file is part of Zanshin
+
+   Copyright 2016 Kevin Ottens <ervin@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+#include <testlib/qtest_zanshin.h>
+
+#include <QElapsedTimer>
+
+#include <KJob>
+
+#include "akonadi/akonadiprojectqueries.h"
+#include "akonadi/akonadiserializer.h"
+#include "akonadi/akonaditaskqueries.h"
+#include "akonadi/akonaditaskrepository.h"
+
+#include "testlib/akonadifakedata.h"
+#include "testlib/gencollection.h"
+#include "testlib/gentodo.h"
+
+using namespace Testlib;
+
+// Measures the time it takes for the common page flows to give a visible
+// result when the storage behaves like a slow Akonadi server
+class PageFlowsBenchmark : public QObject
+{
+    Q_OBJECT
+
+    enum {
+        CollectionCount = 4,
+        TasksPerCollection = 50,
+        ProjectChildCount = 20
+    };
+
+    void fillData(AkonadiFakeData &data)
+    {
+        QFETCH(int, jobLatency);
+        QFETCH(int, itemLatency);
+        QFETCH(int, maxConcurrentJobs);
+
+        for (int i = 1; i <= CollectionCount; i++) {
+            data.createCollection(GenCollection().withId(i).withRootAsParent().withTaskContent());
+
+            for (int j = 0; j < TasksPerCollection; j++) {
+                const auto id = i * 1000 + j;
+                auto todo = GenTodo().withId(id).withParent(i)
+                                     .withUid(QStringLiteral("uid-%1").arg(id))
+                                     .withTitle(QString::number(id));
+                // Half of the tasks are planned for the workday
+                if (j % 2)
+                    todo.withStartDate(QDateTime(QDate(2015, 3, 1)));
+                data.createItem(todo);
+            }
+        }
+
+        data.createItem(GenTodo().withId(1).withParent(1).asProject()
+                                 .withUid(QStringLiteral("project")).withTitle(QStringLiteral("project")));
+        for (int j = 0; j < ProjectChildCount; j++) {
+            const auto id = 100000 + j;
+            data.createItem(GenTodo().withId(id).withParent(1)
+                                     .withUid(QStringLiteral("uid-%1").arg(id))
+                                     .withParentUid(QStringLiteral("project"))
+                                     .withTitle(QString::number(id)));
+        }
+
+        data.storageBehavior().setJobLatency(jobLatency);
+        data.storageBehavior().setItemLatency(itemLatency);
+        data.storageBehavior().setMaxConcurrentJobs(maxConcurrentJobs);
+    }
+
+    template<typename Predicate>
+    void measureUntil(const QElapsedTimer &timer, Predicate isVisible)
+    {
+        while (!isVisible()) {
+            QVERIFY(timer.elapsed() < 60000);
+            QTest::qWait(1);
+        }
+        QTest::setBenchmarkResult(timer.elapsed(), QTest::WalltimeMilliseconds);
+    }
+
+    void addLatencyRows()
+    {
+        QTest::addColumn<int>("jobLatency");
+        QTest::addColumn<int>("itemLatency");
+        QTest::addColumn<int>("maxConcurrentJobs");
+
+        QTest::newRow("no latency") << 0 << 0 << 0;
+        QTest::newRow("local server") << 5 << 0 << 8;
+        QTest::newRow("remote server") << 50 << 1 << 4;
+        QTest::newRow("slow server") << 200 << 5 << 2;
+    }
+
+private slots:
+    void shouldShowInbox_data() { addLatencyRows(); }
+    void shouldShowInbox()
+    {
+        AkonadiFakeData data;
+        fillData(data);
+
+        QScopedPointer<Domain::TaskQueries> queries(new Akonadi::TaskQueries(Akonadi::StorageInterface::Ptr(data.createStorage()),
+                                                                             Akonadi::Serializer::Ptr(new Akonadi::Serializer),
+                                                                             Akonadi::MonitorInterface::Ptr(data.createMonitor())));
+
+        QElapsedTimer timer;
+        timer.start();
+        auto result = queries->findInboxTopLevel();
+        measureUntil(timer, [result] { return !result->data().isEmpty(); });
+    }
+
+    void shouldShowWorkday_data() { addLatencyRows(); }
+    void shouldShowWorkday()
+    {
+        AkonadiFakeData data;
+        fillData(data);
+
+        QScopedPointer<Domain::TaskQueries> queries(new Akonadi::TaskQueries(Akonadi::StorageInterface::Ptr(data.createStorage()),
+                                                                             Akonadi::Serializer::Ptr(new Akonadi::Serializer),
+                                                                             Akonadi::MonitorInterface::Ptr(data.createMonitor())));
+
+        QElapsedTimer timer;
+        timer.start();
+        auto result = queries->findWorkdayTopLevel();
+        measureUntil(timer, [result] { return !result->data().isEmpty(); });
+    }
+
+    void shouldShowProject_data() { addLatencyRows(); }
+    void shouldShowProject()
+    {
+        AkonadiFakeData data;
+        fillData(data);
+
+        auto serializer = Akonadi::Serializer::Ptr(new Akonadi::Serializer);
+        QScopedPointer<Domain::ProjectQueries> queries(new Akonadi::ProjectQueries(Akonadi::StorageInterface::Ptr(data.createStorage()),
+                                                                                   serializer,
+                                                                                   Akonadi::MonitorInterface::Ptr(data.createMonitor())));
+        auto project = serializer->createProjectFromItem(data.item(1));
+
+        QElapsedTimer timer;
+        timer.start();
+        auto result = queries->findTopLevel(project);
+        measureUntil(timer, [result] { return result->data().size() == ProjectChildCount; });
+    }
+
+    void shouldRemoveTask_data() { addLatencyRows(); }
+    void shouldRemoveTask()
+    {
+        AkonadiFakeData data;
+        fillData(data);
+
+        auto serializer = Akonadi::Serializer::Ptr(new Akonadi::Serializer);
+        QScopedPointer<Domain::TaskRepository> repository(new Akonadi::TaskRepository(Akonadi::StorageInterface::Ptr(data.createStorage()),
+                                                                                      serializer,
+                                                                                      Akonadi::MessagingInterface::Ptr()));
+        auto task = serializer->createTaskFromItem(data.item(1000));
+
+        QElapsedTimer timer;
+        timer.start();
+        auto job = repository->remove(task);
+        bool done = false;
+        connect(job, &KJob::result, this, [&done] { done = true; });
+        measureUntil(timer, [&done] { return done; });
+        QVERIFY(!data.item(1000).isValid());
+    }
+};
+
+ZANSHIN_TEST_MAIN(PageFlowsBenchmark)
+
+#include "pageflowsbenchmark.moc"
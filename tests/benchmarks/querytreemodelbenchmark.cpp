@@ -0,0 +1,115 @@
+/* This file is part of Zanshin
+
+   Copyright 2016 Kevin Ottens <ervin@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+#include <testlib/qtest_zanshin.h>
+
+#include "domain/queryresult.h"
+#include "presentation/querytreemodel.h"
+
+#include "testlib/modeltest.h"
+
+// Measures the index computations of QueryTreeModel on big flat lists,
+// which used to be linear in the number of siblings
+class QueryTreeModelBenchmark : public QObject
+{
+    Q_OBJECT
+
+    enum {
+        RowCount = 50000
+    };
+
+    typedef Domain::QueryResultProvider<QString> Provider;
+    typedef Domain::QueryResult<QString> Result;
+    typedef Presentation::QueryTreeModel<QString> Model;
+
+    // Top level items have one child each, children have none
+    Model *createModel(const Provider::Ptr &topLevelProvider)
+    {
+        auto queryGenerator = [topLevelProvider] (const QString &item) -> Domain::QueryResultInterface<QString>::Ptr {
+            if (item.isEmpty())
+                return Result::create(topLevelProvider);
+
+            if (item.startsWith(QLatin1Char('+')))
+                return Domain::QueryResultInterface<QString>::Ptr();
+
+            auto provider = Provider::Ptr::create();
+            provider->append(QLatin1Char('+') + item);
+            return Result::create(provider);
+        };
+        auto flagsFunction = [] (const QString &) {
+            return Qt::ItemIsSelectable | Qt::ItemIsEnabled;
+        };
+        auto dataFunction = [] (const QString &item, int role) -> QVariant {
+            if (role != Qt::DisplayRole)
+                return QVariant();
+            return item;
+        };
+        auto setDataFunction = [] (const QString &, const QVariant &, int) {
+            return false;
+        };
+
+        return new Model(queryGenerator, flagsFunction, dataFunction, setDataFunction, this);
+    }
+
+private slots:
+    void shouldResolveParentsQuickly()
+    {
+        auto provider = Provider::Ptr::create();
+        for (int i = 0; i < RowCount; i++)
+            provider->append(QString::number(i));
+
+        QScopedPointer<Model> model(createModel(provider));
+        QCOMPARE(model->rowCount(), int(RowCount));
+
+        QBENCHMARK {
+            for (int i = 0; i < RowCount; i++) {
+                const auto parent = model->index(i, 0);
+                const auto child = model->index(0, 0, parent);
+                QCOMPARE(model->parent(child).row(), i);
+            }
+        }
+    }
+
+    void shouldInsertAndRemoveQuickly()
+    {
+        auto provider = Provider::Ptr::create();
+        QScopedPointer<Model> model(createModel(provider));
+        new ModelTest(model.data(), model.data());
+
+        QBENCHMARK {
+            // Inserting at the front moves all the rows after it,
+            // children signal their parent index each time
+            for (int i = 0; i < RowCount; i++)
+                provider->insert(0, QString::number(i));
+            QCOMPARE(model->rowCount(), int(RowCount));
+
+            while (!provider->data().isEmpty())
+                provider->removeFirst();
+            QCOMPARE(model->rowCount(), 0);
+        }
+    }
+};
+
+ZANSHIN_TEST_MAIN(QueryTreeModelBenchmark)
+
+#include "querytreemodelbenchmark.moc"
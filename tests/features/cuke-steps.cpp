@@ -43,6 +43,7 @@
 #include "akonadi/akonadimessaginginterface.h"
 
 #include "utils/dependencymanager.h"
+#include "utils/future.h"
 #include "utils/jobhandler.h"
 
 #include "testlib/akonadifakedata.h"
@@ -190,7 +191,7 @@ public:
 
     void waitForEmptyJobQueue()
     {
-        while (Utils::JobHandler::jobCount() != 0) {
+        while (Utils::JobHandler::jobCount() != 0 || Utils::pendingFutureCount() != 0) {
             QTest::qWait(20);
         }
     }
@@ -27,6 +27,8 @@
 #include <KCalCore/Todo>
 #include <QTimer>
 
+#include <algorithm>
+
 #include "akonadi/akonadistoragesettings.h"
 #include "akonadifakedata.h"
 #include "akonadifakejobs.h"
@@ -115,6 +117,7 @@ KJob *AkonadiFakeStorage::createItem(Akonadi::Item item, Akonadi::Collection col
     Q_ASSERT(!item.isValid());
 
     auto job = new FakeJob;
+    applyLatency(job, 1);
     if (!m_data->item(item.id()).isValid()) {
         Utils::JobHandler::install(job, [=] () mutable {
             item.setId(m_data->maxItemId() + 1);
@@ -134,6 +137,7 @@ KJob *AkonadiFakeStorage::updateItem(Akonadi::Item item, QObject *parent)
 {
     auto job = new FakeJob(parent);
     auto startMode = startModeForParent(parent);
+    applyLatency(job, 1, parent);
 
     if (m_data->item(item.id()).isValid()) {
         Utils::JobHandler::install(job, [=] () mutable {
@@ -151,6 +155,7 @@ KJob *AkonadiFakeStorage::updateItem(Akonadi::Item item, QObject *parent)
 KJob *AkonadiFakeStorage::removeItem(Akonadi::Item item)
 {
     auto job = new FakeJob;
+    applyLatency(job, 1);
     if (m_data->item(item.id()).isValid()) {
         Utils::JobHandler::install(job, [=] {
             m_data->removeItem(item);
@@ -166,6 +171,7 @@ KJob *AkonadiFakeStorage::removeItems(Akonadi::Item::List items, QObject *parent
 {
     auto job = new FakeJob;
     auto startMode = startModeForParent(parent);
+    applyLatency(job, items.size(), parent);
     bool allItemsExist = std::all_of(items.constBegin(), items.constEnd(),
                                      [=] (const Akonadi::Item &item) {
                                          return m_data->item(item.id()).isValid();
@@ -188,6 +194,7 @@ KJob *AkonadiFakeStorage::moveItem(Akonadi::Item item, Akonadi::Collection colle
 {
     auto job = new FakeJob(parent);
     auto startMode = startModeForParent(parent);
+    applyLatency(job, 1, parent);
     if (m_data->item(item.id()).isValid()
      && m_data->collection(collection.id()).isValid()) {
         Utils::JobHandler::install(job, [=] () mutable {
@@ -209,6 +216,7 @@ KJob *AkonadiFakeStorage::moveItems(Akonadi::Item::List items, Akonadi::Collecti
 
     auto job = new FakeJob(parent);
     auto startMode = startModeForParent(parent);
+    applyLatency(job, items.size(), parent);
     bool allItemsExist = std::all_of(items.constBegin(), items.constEnd(),
                                      [=] (const Akonadi::Item &item) {
                                          return m_data->item(item.id()).isValid();
@@ -244,6 +252,7 @@ KJob *AkonadiFakeStorage::createCollection(Akonadi::Collection collection, QObje
 
     auto job = new FakeJob(parent);
     auto startMode = startModeForParent(parent);
+    applyLatency(job, 1, parent);
     if (!m_data->collection(collection.id()).isValid()) {
         Utils::JobHandler::install(job, [=] () mutable {
             collection.setId(m_data->maxCollectionId() + 1);
@@ -260,6 +269,7 @@ KJob *AkonadiFakeStorage::updateCollection(Akonadi::Collection collection, QObje
 {
     auto job = new FakeJob(parent);
     auto startMode = startModeForParent(parent);
+    applyLatency(job, 1, parent);
     if (m_data->collection(collection.id()).isValid()) {
         Utils::JobHandler::install(job, [=] {
             m_data->modifyCollection(collection);
@@ -275,6 +285,7 @@ KJob *AkonadiFakeStorage::removeCollection(Akonadi::Collection collection, QObje
 {
     auto job = new FakeJob(parent);
     auto startMode = startModeForParent(parent);
+    applyLatency(job, 1, parent);
     if (m_data->collection(collection.id()).isValid()) {
         Utils::JobHandler::install(job, [=] {
             m_data->removeCollection(collection);
@@ -289,6 +300,7 @@ KJob *AkonadiFakeStorage::removeCollection(Akonadi::Collection collection, QObje
 KJob *AkonadiFakeStorage::createTransaction()
 {
     auto job = new AkonadiFakeTransaction;
+    applyLatency(job, 0);
     Utils::JobHandler::install(job, noop);
     return job;
 }
@@ -298,6 +310,7 @@ KJob *AkonadiFakeStorage::createTag(Akonadi::Tag tag)
     Q_ASSERT(!tag.isValid());
 
     auto job = new FakeJob;
+    applyLatency(job, 1);
     if (!m_data->tag(tag.id()).isValid()) {
         Utils::JobHandler::install(job, [=] () mutable {
             tag.setId(m_data->maxTagId() + 1);
@@ -313,6 +326,7 @@ KJob *AkonadiFakeStorage::createTag(Akonadi::Tag tag)
 KJob *AkonadiFakeStorage::updateTag(Akonadi::Tag tag)
 {
     auto job = new FakeJob;
+    applyLatency(job, 1);
     if (m_data->tag(tag.id()).isValid()) {
         Utils::JobHandler::install(job, [=] {
             m_data->modifyTag(tag);
@@ -327,6 +341,7 @@ KJob *AkonadiFakeStorage::updateTag(Akonadi::Tag tag)
 KJob *AkonadiFakeStorage::removeTag(Akonadi::Tag tag)
 {
     auto job = new FakeJob;
+    applyLatency(job, 1);
     if (m_data->tag(tag.id()).isValid()) {
         Utils::JobHandler::install(job, [=] {
             m_data->removeTag(tag);
@@ -384,6 +399,7 @@ Akonadi::CollectionFetchJobInterface *AkonadiFakeStorage::fetchCollections(Akona
     const auto behavior = m_data->storageBehavior().fetchCollectionsBehavior(collection.id());
     if (behavior == AkonadiFakeStorageBehavior::NormalFetch)
         job->setCollections(collections);
+    applyLatency(job, collections.size());
     job->setExpectedError(m_data->storageBehavior().fetchCollectionsErrorCode(collection.id()));
     Utils::JobHandler::install(job, noop);
     return job;
@@ -405,6 +421,7 @@ Akonadi::ItemFetchJobInterface *AkonadiFakeStorage::fetchItems(Akonadi::Collecti
     const auto behavior = m_data->storageBehavior().fetchItemsBehavior(collection.id());
     if (behavior == AkonadiFakeStorageBehavior::NormalFetch)
         job->setItems(items);
+    applyLatency(job, items.size());
     job->setExpectedError(m_data->storageBehavior().fetchItemsErrorCode(collection.id()));
     Utils::JobHandler::install(job, noop);
     return job;
@@ -421,6 +438,7 @@ Akonadi::ItemFetchJobInterface *AkonadiFakeStorage::fetchItem(Akonadi::Item item
     const auto behavior = m_data->storageBehavior().fetchItemBehavior(item.id());
     if (behavior == AkonadiFakeStorageBehavior::NormalFetch)
         job->setItems(Akonadi::Item::List() << fullItem);
+    applyLatency(job, 1);
     job->setExpectedError(m_data->storageBehavior().fetchItemErrorCode(item.id()));
     Utils::JobHandler::install(job, noop);
     return job;
@@ -444,6 +462,7 @@ Akonadi::ItemFetchJobInterface *AkonadiFakeStorage::fetchTagItems(Akonadi::Tag t
     const auto behavior = m_data->storageBehavior().fetchTagItemsBehavior(tag.id());
     if (behavior == AkonadiFakeStorageBehavior::NormalFetch)
         job->setItems(items);
+    applyLatency(job, items.size());
     job->setExpectedError(m_data->storageBehavior().fetchTagItemsErrorCode(tag.id()));
     Utils::JobHandler::install(job, noop);
     return job;
@@ -455,6 +474,7 @@ Akonadi::TagFetchJobInterface *AkonadiFakeStorage::fetchTags()
     const auto behavior = m_data->storageBehavior().fetchTagsBehavior();
     if (behavior == AkonadiFakeStorageBehavior::NormalFetch)
         job->setTags(m_data->tags());
+    applyLatency(job, m_data->tags().size());
     job->setExpectedError(m_data->storageBehavior().fetchTagsErrorCode());
     Utils::JobHandler::install(job, noop);
     return job;
@@ -503,6 +523,31 @@ Akonadi::Item::Id AkonadiFakeStorage::findId(const Akonadi::Item &item)
 
 }
 
+void AkonadiFakeStorage::applyLatency(FakeJob *job, int entryCount, QObject *parent)
+{
+    const auto &behavior = m_data->storageBehavior();
+    const int cost = behavior.jobLatency() + behavior.itemLatency() * entryCount;
+    const int maxJobs = behavior.maxConcurrentJobs();
+
+    // Jobs inside a transaction are already serialized by the transaction itself
+    if (maxJobs <= 0 || qobject_cast<AkonadiFakeTransaction*>(parent)) {
+        job->setDuration(cost);
+        return;
+    }
+
+    if (!m_clock.isValid())
+        m_clock.start();
+
+    // Each slot holds the time at which it becomes available again,
+    // the job goes in the first one to free up and waits for it if needed
+    m_slots.resize(maxJobs);
+    const auto now = m_clock.elapsed();
+    auto slot = std::min_element(m_slots.begin(), m_slots.end());
+    const auto end = std::max(now, *slot) + cost;
+    *slot = end;
+    job->setDuration(int(end - now));
+}
+
 Akonadi::Collection::List AkonadiFakeStorage::collectChildren(const Akonadi::Collection &root)
 {
     auto collections = Akonadi::Collection::List();
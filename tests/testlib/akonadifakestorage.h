@@ -24,8 +24,13 @@
 #ifndef TESTLIB_AKONADIFAKESTORAGE_H
 #define TESTLIB_AKONADIFAKESTORAGE_H
 
+#include <QElapsedTimer>
+#include <QVector>
+
 #include "akonadi/akonadistorageinterface.h"
 
+class FakeJob;
+
 namespace Testlib {
 
 class AkonadiFakeData;
@@ -66,8 +71,11 @@ private:
     Akonadi::Collection::Id findId(const Akonadi::Collection &collection);
     Akonadi::Item::Id findId(const Akonadi::Item &item);
     Akonadi::Collection::List collectChildren(const Akonadi::Collection &root);
+    void applyLatency(FakeJob *job, int entryCount, QObject *parent = Q_NULLPTR);
 
     AkonadiFakeData *m_data;
+    QElapsedTimer m_clock;
+    QVector<qint64> m_slots;
 };
 
 }
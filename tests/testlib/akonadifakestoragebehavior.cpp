@@ -23,11 +23,16 @@
 
 #include "akonadifakestoragebehavior.h"
 
+#include "fakejob.h"
+
 using namespace Testlib;
 
 AkonadiFakeStorageBehavior::AkonadiFakeStorageBehavior()
     : m_fetchTagsErrorCode(KJob::NoError),
-      m_fetchTagsBehavior(NormalFetch)
+      m_fetchTagsBehavior(NormalFetch),
+      m_jobLatency(FakeJob::DURATION),
+      m_itemLatency(0),
+      m_maxConcurrentJobs(0)
 {
 }
 
@@ -154,3 +159,33 @@ AkonadiFakeStorageBehavior::FetchBehavior AkonadiFakeStorageBehavior::fetchTagsB
 {
     return m_fetchTagsBehavior;
 }
+
+void AkonadiFakeStorageBehavior::setJobLatency(int msecs)
+{
+    m_jobLatency = msecs;
+}
+
+int AkonadiFakeStorageBehavior::jobLatency() const
+{
+    return m_jobLatency;
+}
+
+void AkonadiFakeStorageBehavior::setItemLatency(int msecs)
+{
+    m_itemLatency = msecs;
+}
+
+int AkonadiFakeStorageBehavior::itemLatency() const
+{
+    return m_itemLatency;
+}
+
+void AkonadiFakeStorageBehavior::setMaxConcurrentJobs(int count)
+{
+    m_maxConcurrentJobs = count;
+}
+
+int AkonadiFakeStorageBehavior::maxConcurrentJobs() const
+{
+    return m_maxConcurrentJobs;
+}
@@ -73,6 +73,16 @@ public:
     void setFetchTagsBehavior(FetchBehavior behavior);
     FetchBehavior fetchTagsBehavior() const;
 
+    // Latency model used to simulate slow servers, a job takes
+    // jobLatency() + itemLatency() * number of entries it carries
+    // and at most maxConcurrentJobs() jobs run in parallel (0 means no limit)
+    void setJobLatency(int msecs);
+    int jobLatency() const;
+    void setItemLatency(int msecs);
+    int itemLatency() const;
+    void setMaxConcurrentJobs(int count);
+    int maxConcurrentJobs() const;
+
 private:
     QHash<Akonadi::Collection::Id, int> m_fetchCollectionsErrorCode;
     QHash<Akonadi::Collection::Id, FetchBehavior> m_fetchCollectionsBehavior;
@@ -91,6 +101,10 @@ private:
 
     int m_fetchTagsErrorCode;
     FetchBehavior m_fetchTagsBehavior;
+
+    int m_jobLatency;
+    int m_itemLatency;
+    int m_maxConcurrentJobs;
 };
 
 }
@@ -25,9 +25,18 @@
 
 #include <QTimer>
 
+static int s_runningCount = 0;
+static int s_maxRunningCount = 0;
+
 FakeJob::FakeJob(QObject *parent)
-    : KJob(parent), m_done(false), m_launched(false), m_errorCode(KJob::NoError)
+    : KJob(parent), m_done(false), m_launched(false), m_running(false), m_duration(DURATION), m_errorCode(KJob::NoError)
+{
+    connect(this, &KJob::finished, this, &FakeJob::onFinished);
+}
+
+FakeJob::~FakeJob()
 {
+    onFinished();
 }
 
 void FakeJob::setExpectedError(int errorCode, const QString &errorText)
@@ -36,11 +45,24 @@ void FakeJob::setExpectedError(int errorCode, const QString &errorText)
     m_errorText = errorText;
 }
 
+int FakeJob::duration() const
+{
+    return m_duration;
+}
+
+void FakeJob::setDuration(int msecs)
+{
+    m_duration = msecs;
+}
+
 void FakeJob::start()
 {
     if (!m_launched) {
         m_launched = true;
-        QTimer::singleShot(DURATION, Qt::PreciseTimer, this, &FakeJob::onTimeout);
+        m_running = true;
+        s_runningCount++;
+        s_maxRunningCount = qMax(s_maxRunningCount, s_runningCount);
+        QTimer::singleShot(m_duration, Qt::PreciseTimer, this, &FakeJob::onTimeout);
     }
 }
 
@@ -54,6 +76,29 @@ void FakeJob::onTimeout()
     emitResult();
 }
 
+int FakeJob::runningCount()
+{
+    return s_runningCount;
+}
+
+int FakeJob::maxRunningCount()
+{
+    return s_maxRunningCount;
+}
+
+void FakeJob::resetMaxRunningCount()
+{
+    s_maxRunningCount = s_runningCount;
+}
+
+void FakeJob::onFinished()
+{
+    if (m_running) {
+        m_running = false;
+        s_runningCount--;
+    }
+}
+
 bool FakeJob::isDone() const
 {
     return m_done;
@@ -32,11 +32,21 @@ class FakeJob : public KJob
 public:
     static const int DURATION = 50;
     explicit FakeJob(QObject *parent = Q_NULLPTR);
+    ~FakeJob();
 
     void setExpectedError(int errorCode, const QString &errorText = QString());
 
+    int duration() const;
+    void setDuration(int msecs);
+
     void start();
 
+    // Fake jobs started and not finished yet, and the highest
+    // number of them seen since the last reset
+    static int runningCount();
+    static int maxRunningCount();
+    static void resetMaxRunningCount();
+
 private slots:
     virtual void onTimeout();
 
@@ -46,8 +56,12 @@ public:
     QString expectedErrorText() const;
 
 private:
+    void onFinished();
+
     bool m_done;
     bool m_launched;
+    bool m_running;
+    int m_duration;
     int m_errorCode;
     QString m_errorText;
 };
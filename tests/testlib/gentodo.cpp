@@ -105,6 +105,16 @@ GenTodo &GenTodo::done(bool value)
     return *this;
 }
 
+GenTodo &GenTodo::running(bool value)
+{
+    auto todo = m_item.payload<KCalCore::Todo::Ptr>();
+    if (value)
+        todo->setCustomProperty("Zanshin", "Running", QStringLiteral("1"));
+    else
+        todo->removeCustomProperty("Zanshin", "Running");
+    return *this;
+}
+
 GenTodo &GenTodo::withDoneDate(const QString &date)
 {
     m_item.payload<KCalCore::Todo::Ptr>()->setCompleted(KDateTime(QDate::fromString(date, Qt::ISODate)));
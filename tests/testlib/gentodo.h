@@ -46,6 +46,7 @@ public:
     GenTodo &withTitle(const QString &title);
     GenTodo &withText(const QString &text);
     GenTodo &done(bool value = true);
+    GenTodo &running(bool value = true);
     GenTodo &withDoneDate(const QString &date);
     GenTodo &withDoneDate(const QDateTime &date);
     GenTodo &withStartDate(const QString &date);
@@ -52,6 +52,7 @@ MonitorSpy::MonitorSpy(Akonadi::MonitorInterface* monitor, QObject *parent)
     connect(m_monitor, &Akonadi::MonitorInterface::itemAdded, this, &MonitorSpy::restartTimer);
     connect(m_monitor, &Akonadi::MonitorInterface::itemRemoved, this, &MonitorSpy::restartTimer);
     connect(m_monitor, &Akonadi::MonitorInterface::itemChanged, this, &MonitorSpy::restartTimer);
+    connect(m_monitor, &Akonadi::MonitorInterface::itemMetadataChanged, this, &MonitorSpy::restartTimer);
     connect(m_monitor, &Akonadi::MonitorInterface::itemMoved, this, &MonitorSpy::restartTimer);
 
     connect(m_monitor, &Akonadi::MonitorInterface::tagAdded, this, &MonitorSpy::restartTimer);
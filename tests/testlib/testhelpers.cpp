@@ -25,13 +25,14 @@
 
 #include <QTest>
 
+#include "utils/future.h"
 #include "utils/jobhandler.h"
 
 using namespace Testlib;
 
 void TestHelpers::waitForEmptyJobQueue()
 {
-    while (Utils::JobHandler::jobCount() != 0) {
+    while (Utils::JobHandler::jobCount() != 0 || Utils::pendingFutureCount() != 0) {
         QTest::qWait(20);
     }
 }
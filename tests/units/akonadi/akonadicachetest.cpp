@@ -627,6 +627,56 @@ private slots:
         // THEN
         QVERIFY(cache->items(collection1).contains(item3));
         QVERIFY(cache->items(tag1).contains(item3));
+
+        // WHEN
+        monitor->changeItem(GenTodo(items.at(1)).withTags({}));
+
+        // THEN
+        QVERIFY(!cache->items(tag1).contains(items.at(1)));
+        QVERIFY(cache->items(tag1).contains(item3));
+    }
+
+    void shouldRefreshItemMetadata()
+    {
+        // GIVEN
+        const auto collection = Akonadi::Collection(GenCollection().withRootAsParent()
+                                                                   .withId(1)
+                                                                   .withName("tasks")
+                                                                   .withTaskContent());
+        const auto tag = Akonadi::Tag(GenTag().withId(1).withName("tag"));
+        auto item = Akonadi::Item(GenTodo().withId(1).withParent(1).withTags({1}).withTitle("item1"));
+        item.setRevision(1);
+
+        auto monitor = AkonadiFakeMonitor::Ptr::create();
+        auto serializer = Akonadi::Serializer::Ptr(new Akonadi::Serializer);
+        auto cache = Akonadi::Cache::Ptr::create(serializer, monitor);
+        cache->setCollections(Akonadi::StorageInterface::Tasks, Akonadi::Collection::List() << collection);
+        cache->populateCollection(collection, Akonadi::Item::List() << item);
+        cache->populateTag(tag, Akonadi::Item::List() << item);
+
+        // WHEN
+        // Notification with the bookkeeping only, no payload nor tags
+        auto notified = Akonadi::Item(1);
+        notified.setParentCollection(collection);
+        notified.setRevision(2);
+        notified.setRemoteRevision(QStringLiteral("rev-2"));
+        notified.setFlags(Akonadi::Item::Flags() << "\\SEEN");
+        monitor->changeItemMetadata(notified);
+
+        // THEN
+        const auto cached = cache->item(1);
+        QCOMPARE(cached.revision(), 2);
+        QCOMPARE(cached.remoteRevision(), QStringLiteral("rev-2"));
+        QCOMPARE(cached.flags(), notified.flags());
+        QCOMPARE(serializer->createTaskFromItem(cached)->title(), QStringLiteral("item1"));
+        QVERIFY(cache->items(collection).contains(item));
+        QVERIFY(cache->items(tag).contains(item));
+
+        // WHEN
+        monitor->changeItemMetadata(Akonadi::Item(GenTodo().withId(2).withParent(1).withTitle("item2")));
+
+        // THEN
+        QVERIFY(!cache->item(2).isValid());
     }
 
     void shouldHandleItemAdds()
@@ -717,6 +767,51 @@ private slots:
         QCOMPARE(cache->item(items.at(0).id()), Akonadi::Item());
         QCOMPARE(cache->item(items.at(1).id()), items.at(1));
     }
+
+    void shouldFindDescendantItems()
+    {
+        // GIVEN
+        const auto collection = Akonadi::Collection(GenCollection().withRootAsParent()
+                                                                   .withId(1)
+                                                                   .withName("tasks")
+                                                                   .withTaskContent());
+        const auto items = Akonadi::Item::List() << Akonadi::Item(GenTodo().withId(1).withParent(1).withUid("1"))
+                                                 << Akonadi::Item(GenTodo().withId(2).withParent(1).withUid("2").withParentUid("1"))
+                                                 << Akonadi::Item(GenTodo().withId(3).withParent(1).withUid("3").withParentUid("2"))
+                                                 << Akonadi::Item(GenTodo().withId(4).withParent(1).withUid("4").withParentUid("1"))
+                                                 << Akonadi::Item(GenTodo().withId(5).withParent(1).withUid("5"));
+
+        auto monitor = AkonadiFakeMonitor::Ptr::create();
+        auto cache = Akonadi::Cache::Ptr::create(Akonadi::Serializer::Ptr(new Akonadi::Serializer), monitor);
+        cache->setCollections(Akonadi::StorageInterface::Tasks,
+                              Akonadi::Collection::List() << collection);
+
+        // WHEN
+        cache->populateCollection(collection, items);
+
+        // THEN
+        auto descendants = cache->descendantItems(items.at(0));
+        std::sort(descendants.begin(), descendants.end());
+        QCOMPARE(descendants, Akonadi::Item::List() << items.at(1) << items.at(2) << items.at(3));
+        QCOMPARE(cache->descendantItems(items.at(1)), Akonadi::Item::List() << items.at(2));
+        QVERIFY(cache->descendantItems(items.at(4)).isEmpty());
+
+        // WHEN
+        const auto reparentedItem = Akonadi::Item(GenTodo().withId(2).withParent(1).withUid("2").withParentUid("5"));
+        monitor->changeItem(reparentedItem);
+
+        // THEN
+        QCOMPARE(cache->descendantItems(items.at(0)), Akonadi::Item::List() << items.at(3));
+        descendants = cache->descendantItems(items.at(4));
+        std::sort(descendants.begin(), descendants.end());
+        QCOMPARE(descendants, Akonadi::Item::List() << items.at(1) << items.at(2));
+
+        // WHEN
+        monitor->removeItem(items.at(2));
+
+        // THEN
+        QCOMPARE(cache->descendantItems(items.at(4)), Akonadi::Item::List() << items.at(1));
+    }
 };
 
 ZANSHIN_TEST_MAIN(AkonadiCacheTest)
@@ -25,6 +25,7 @@
 
 #include "akonadi/akonadicachingstorage.h"
 #include "akonadi/akonadiserializer.h"
+#include "akonadi/akonadistoragesettings.h"
 
 #include "akonadi/akonadicollectionfetchjobinterface.h"
 #include "akonadi/akonadiitemfetchjobinterface.h"
@@ -298,6 +299,56 @@ private slots:
         }
     }
 
+    void shouldResolveWritableDefaultTaskCollectionFromCache()
+    {
+        // GIVEN
+        AkonadiFakeData data;
+
+        // One read-only task collection and a writable one
+        auto readOnlyCollection = Akonadi::Collection(GenCollection().withId(42).withName(QStringLiteral("42Col")).withRootAsParent().withTaskContent());
+        readOnlyCollection.setRights(Akonadi::Collection::ReadOnly);
+        data.createCollection(readOnlyCollection);
+
+        auto writableCollection = Akonadi::Collection(GenCollection().withId(43).withName(QStringLiteral("43Col")).withRootAsParent().withTaskContent());
+        writableCollection.setRights(Akonadi::Collection::CanCreateItem
+                                   | Akonadi::Collection::CanChangeItem
+                                   | Akonadi::Collection::CanDeleteItem);
+        data.createCollection(writableCollection);
+
+        auto cache = Akonadi::Cache::Ptr::create(Akonadi::SerializerInterface::Ptr(new Akonadi::Serializer),
+                                                 Akonadi::MonitorInterface::Ptr(data.createMonitor()));
+        Akonadi::CachingStorage storage(cache, Akonadi::StorageInterface::Ptr(data.createStorage()));
+
+        // Nothing configured
+        Akonadi::StorageSettings::instance().setDefaultTaskCollection(Akonadi::Collection());
+
+        // THEN (nothing known yet)
+        QVERIFY(!storage.defaultTaskCollection().isValid());
+
+        // WHEN
+        auto job = storage.fetchCollections(Akonadi::Collection::root(),
+                                            Akonadi::StorageInterface::Recursive,
+                                            Akonadi::StorageInterface::Tasks);
+        QVERIFY2(job->kjob()->exec(), qPrintable(job->kjob()->errorString()));
+
+        // THEN
+        QCOMPARE(storage.defaultTaskCollection(), writableCollection);
+
+        // WHEN (the configured collection is read-only)
+        Akonadi::StorageSettings::instance().setDefaultTaskCollection(readOnlyCollection);
+
+        // THEN
+        QCOMPARE(storage.defaultTaskCollection(), writableCollection);
+
+        // WHEN (the writable collection goes away)
+        data.removeCollection(writableCollection);
+
+        // THEN
+        QCOMPARE(storage.defaultTaskCollection(), readOnlyCollection);
+
+        Akonadi::StorageSettings::instance().setDefaultTaskCollection(Akonadi::Collection());
+    }
+
     void shouldCacheSingleItems()
     {
         // GIVEN
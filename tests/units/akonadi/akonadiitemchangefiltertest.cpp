@@ -0,0 +1,136 @@
+/* This file is part of Zanshin
+
+   Copyright 2016 Kevin Ottens <ervin@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+#include <testlib/qtest_zanshin.h>
+
+#include "akonadi/akonadiitemchangefilter.h"
+
+typedef QSet<QByteArray> PartSet;
+Q_DECLARE_METATYPE(PartSet)
+Q_DECLARE_METATYPE(Akonadi::ItemChangeFilter::ChangeKind)
+
+static Akonadi::Item createItem(Akonadi::Item::Id id, int revision, Akonadi::Collection::Id collectionId = 1)
+{
+    auto item = Akonadi::Item(id);
+    item.setRevision(revision);
+    item.setParentCollection(Akonadi::Collection(collectionId));
+    return item;
+}
+
+class AkonadiItemChangeFilterTest : public QObject
+{
+    Q_OBJECT
+private slots:
+    void shouldSortChangesByTheirParts_data()
+    {
+        QTest::addColumn<PartSet>("parts");
+        QTest::addColumn<Akonadi::ItemChangeFilter::ChangeKind>("expectedKind");
+
+        QTest::newRow("unknown parts") << PartSet() << Akonadi::ItemChangeFilter::RelevantChange;
+        QTest::newRow("payload") << (PartSet() << "PLD:RFC822") << Akonadi::ItemChangeFilter::RelevantChange;
+        QTest::newRow("tag") << (PartSet() << "TAG") << Akonadi::ItemChangeFilter::RelevantChange;
+        QTest::newRow("tags") << (PartSet() << "TAGS") << Akonadi::ItemChangeFilter::RelevantChange;
+        QTest::newRow("flags and payload") << (PartSet() << "FLAGS" << "PLD:RFC822") << Akonadi::ItemChangeFilter::RelevantChange;
+        QTest::newRow("flags") << (PartSet() << "FLAGS") << Akonadi::ItemChangeFilter::MetadataChange;
+        QTest::newRow("remote revision") << (PartSet() << "REMOTEREVISION") << Akonadi::ItemChangeFilter::MetadataChange;
+        QTest::newRow("remote id and attribute") << (PartSet() << "REMOTEID" << "ATR:ENTITYDISPLAY") << Akonadi::ItemChangeFilter::MetadataChange;
+    }
+
+    void shouldSortChangesByTheirParts()
+    {
+        // GIVEN
+        QFETCH(PartSet, parts);
+        QFETCH(Akonadi::ItemChangeFilter::ChangeKind, expectedKind);
+        Akonadi::ItemChangeFilter filter;
+
+        // WHEN
+        const auto kind = filter.itemChanged(createItem(42, 1), parts);
+
+        // THEN
+        QCOMPARE(kind, expectedKind);
+        QCOMPARE(filter.trackedItemCount(), 1);
+    }
+
+    void shouldDropRevisionsAlreadySeen()
+    {
+        // GIVEN
+        Akonadi::ItemChangeFilter filter;
+        const auto payload = PartSet() << "PLD:RFC822";
+        const auto flags = PartSet() << "FLAGS";
+        QCOMPARE(filter.itemChanged(createItem(42, 3), payload), Akonadi::ItemChangeFilter::RelevantChange);
+
+        // WHEN / THEN
+        QCOMPARE(filter.itemChanged(createItem(42, 3), payload), Akonadi::ItemChangeFilter::DuplicateChange);
+        QCOMPARE(filter.itemChanged(createItem(42, 2), payload), Akonadi::ItemChangeFilter::DuplicateChange);
+        QCOMPARE(filter.itemChanged(createItem(42, 4), flags), Akonadi::ItemChangeFilter::MetadataChange);
+        QCOMPARE(filter.itemChanged(createItem(42, 4), flags), Akonadi::ItemChangeFilter::DuplicateChange);
+        QCOMPARE(filter.itemChanged(createItem(42, 5), payload), Akonadi::ItemChangeFilter::RelevantChange);
+        QCOMPARE(filter.itemChanged(createItem(43, 1), payload), Akonadi::ItemChangeFilter::RelevantChange);
+
+        // Without revision we can't tell, so it's never a duplicate
+        QCOMPARE(filter.itemChanged(createItem(44, -1), payload), Akonadi::ItemChangeFilter::RelevantChange);
+        QCOMPARE(filter.itemChanged(createItem(44, -1), payload), Akonadi::ItemChangeFilter::RelevantChange);
+        QCOMPARE(filter.trackedItemCount(), 2);
+    }
+
+    void shouldForgetRemovedItems()
+    {
+        // GIVEN
+        Akonadi::ItemChangeFilter filter;
+        const auto payload = PartSet() << "PLD:RFC822";
+        filter.itemChanged(createItem(42, 1, 1), payload);
+        filter.itemChanged(createItem(43, 1, 1), payload);
+        filter.itemChanged(createItem(44, 1, 1), payload);
+        filter.itemChanged(createItem(45, 1, 2), payload);
+        QCOMPARE(filter.trackedItemCount(), 4);
+
+        // WHEN
+        filter.itemRemoved(createItem(42, 1, 1));
+
+        // THEN
+        QCOMPARE(filter.trackedItemCount(), 3);
+        QCOMPARE(filter.itemChanged(createItem(42, 1, 1), payload), Akonadi::ItemChangeFilter::RelevantChange);
+        filter.itemRemoved(createItem(42, 1, 1));
+
+        // WHEN
+        filter.itemMoved(createItem(44, 1, 2));
+        filter.collectionRemoved(Akonadi::Collection(1));
+
+        // THEN
+        QCOMPARE(filter.trackedItemCount(), 2);
+        QCOMPARE(filter.itemChanged(createItem(43, 1, 1), payload), Akonadi::ItemChangeFilter::RelevantChange);
+        QCOMPARE(filter.itemChanged(createItem(44, 1, 2), payload), Akonadi::ItemChangeFilter::DuplicateChange);
+        QCOMPARE(filter.itemChanged(createItem(45, 1, 2), payload), Akonadi::ItemChangeFilter::DuplicateChange);
+
+        // WHEN
+        filter.collectionRemoved(Akonadi::Collection(2));
+
+        // THEN
+        QCOMPARE(filter.trackedItemCount(), 1);
+    }
+};
+
+ZANSHIN_TEST_MAIN(AkonadiItemChangeFilterTest)
+
+#include "akonadiitemchangefiltertest.moc"
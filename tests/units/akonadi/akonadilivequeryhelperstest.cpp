@@ -34,6 +34,7 @@
 #include "akonadi/akonadiserializer.h"
 
 #include "testlib/akonadifakedata.h"
+#include "testlib/fakejob.h"
 #include "testlib/gencollection.h"
 #include "testlib/gennote.h"
 #include "testlib/gentag.h"
@@ -376,6 +377,52 @@ private slots:
         QCOMPARE(result, expected);
     }
 
+    void shouldFetchItemsFromManyCollections()
+    {
+        // GIVEN
+        auto data = AkonadiFakeData();
+        auto helpers = createHelpers(data);
+
+        // More task collections than item fetches allowed to run in parallel
+        auto expected = QStringList();
+        for (int id = 42; id < 52; id++) {
+            data.createCollection(GenCollection().withId(id).withRootAsParent().withName(QString::number(id)).withTaskContent());
+
+            // Two tasks in each of them
+            const auto firstTitle = QString::number(id * 10);
+            const auto secondTitle = QString::number(id * 10 + 1);
+            data.createItem(GenTodo().withId(id * 10).withParent(id).withTitle(firstTitle));
+            data.createItem(GenTodo().withId(id * 10 + 1).withParent(id).withTitle(secondTitle));
+            expected << firstTitle << secondTitle;
+        }
+
+        // The list which will be filled by the fetch function
+        auto items = Akonadi::Item::List();
+        auto add = [&items] (const Akonadi::Item &item) {
+            items.append(item);
+        };
+
+        // WHEN
+        FakeJob::resetMaxRunningCount();
+        auto fetch = helpers->fetchItems(Akonadi::StorageInterface::Tasks);
+        fetch(add);
+        TestHelpers::waitForEmptyJobQueue();
+
+        auto result = QStringList();
+        std::transform(items.constBegin(), items.constEnd(),
+                       std::back_inserter(result),
+                       titleFromItem);
+        result.sort();
+
+        // THEN
+        expected.sort();
+        QCOMPARE(result, expected);
+
+        // The item fetches were queued instead of all started at once
+        QCOMPARE(FakeJob::runningCount(), 0);
+        QCOMPARE(FakeJob::maxRunningCount(), 4);
+    }
+
     void shouldFetchItemsByTag_data()
     {
         QTest::addColumn<Akonadi::Tag>("tag");
@@ -458,6 +505,53 @@ private slots:
         QCOMPARE(result, expected);
     }
 
+    void shouldFetchItemsByTagOnlyFromSelectedCollections_data()
+    {
+        QTest::addColumn<int>("errorCode");
+
+        QTest::newRow("tag items fetch") << int(KJob::NoError);
+        QTest::newRow("fallback on all items") << int(KJob::KilledJobError);
+    }
+
+    void shouldFetchItemsByTagOnlyFromSelectedCollections()
+    {
+        // GIVEN
+        auto data = AkonadiFakeData();
+        auto helpers = createHelpers(data);
+
+        // Two top level collections with tasks, the second one not selected
+        data.createCollection(GenCollection().withId(42).withRootAsParent().withName(QStringLiteral("42")).withTaskContent());
+        data.createCollection(GenCollection().withId(43).withRootAsParent().withName(QStringLiteral("43")).withTaskContent().selected(false));
+
+        // One tag
+        data.createTag(GenTag().withId(42));
+
+        // Two items in each collection, one with the tag and one without
+        data.createItem(GenTodo().withId(42).withParent(42).withTags({}).withTitle(QStringLiteral("42")));
+        data.createItem(GenTodo().withId(43).withParent(42).withTags({42}).withTitle(QStringLiteral("43")));
+        data.createItem(GenTodo().withId(44).withParent(43).withTags({}).withTitle(QStringLiteral("44")));
+        data.createItem(GenTodo().withId(45).withParent(43).withTags({42}).withTitle(QStringLiteral("45")));
+
+        // The server might fail to give the items of the tag
+        QFETCH(int, errorCode);
+        data.storageBehavior().setFetchTagItemsErrorCode(42, errorCode);
+
+        // The list which will be filled by the fetch function
+        auto items = Akonadi::Item::List();
+        auto add = [&items] (const Akonadi::Item &item) {
+            items.append(item);
+        };
+
+        // WHEN
+        auto fetch = helpers->fetchItems(Akonadi::Tag(42));
+        fetch(add);
+        TestHelpers::waitForEmptyJobQueue();
+
+        // THEN
+        QCOMPARE(items.size(), 1);
+        QCOMPARE(titleFromItem(items.first()), QStringLiteral("43"));
+    }
+
     void shouldFetchSiblings_data()
     {
         QTest::addColumn<Akonadi::Item>("item");
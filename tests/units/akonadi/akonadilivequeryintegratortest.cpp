@@ -1430,8 +1430,102 @@ private slots:
         QCOMPARE(result->data().at(0)->title(), QStringLiteral("42"));
     }
 
+    void shouldKeepArtifactsOrderedByTitle()
+    {
+        // GIVEN
+        AkonadiFakeData data;
+
+        data.createCollection(GenCollection().withId(42).withRootAsParent().withName(QStringLiteral("42")));
+        data.createItem(GenTodo().withId(42).withParent(42).withTitle(QStringLiteral("B")));
+        data.createItem(GenTodo().withId(43).withParent(42).withTitle(QStringLiteral("c")));
+        data.createItem(GenTodo().withId(44).withParent(42).withTitle(QStringLiteral("A")));
+
+        auto integrator = createIntegrator(data);
+        auto storage = createStorage(data);
+
+        auto query = Domain::LiveQueryOutput<Domain::Task::Ptr>::Ptr();
+        auto fetch = fetchItemsInAllCollectionsFunction(storage);
+        auto predicate = [] (const Akonadi::Item &) {
+            return true;
+        };
+
+        integrator->bind("tasks", query, fetch, predicate);
+        auto result = query->result();
+        TestHelpers::waitForEmptyJobQueue();
+
+        QCOMPARE(result->data().size(), 3);
+        QCOMPARE(result->data().at(0)->title(), QStringLiteral("A"));
+        QCOMPARE(result->data().at(1)->title(), QStringLiteral("B"));
+        QCOMPARE(result->data().at(2)->title(), QStringLiteral("c"));
+
+        QStringList events;
+        result->addPostInsertHandler([&events] (const Domain::Task::Ptr &task, int index) {
+            events << QStringLiteral("insert %1 %2").arg(task->title()).arg(index);
+        });
+        result->addPostRemoveHandler([&events] (const Domain::Task::Ptr &task, int index) {
+            events << QStringLiteral("remove %1 %2").arg(task->title()).arg(index);
+        });
+        result->addPostReplaceHandler([&events] (const Domain::Task::Ptr &task, int index) {
+            events << QStringLiteral("replace %1 %2").arg(task->title()).arg(index);
+        });
+
+        // WHEN
+        data.modifyItem(GenTodo(data.item(42)).withTitle(QStringLiteral("b2")));
+        data.modifyItem(GenTodo(data.item(44)).withTitle(QStringLiteral("D")));
+
+        // THEN
+        const QStringList expectedEvents = {QStringLiteral("replace b2 1"),
+                                            QStringLiteral("remove D 0"),
+                                            QStringLiteral("insert D 2")};
+        QCOMPARE(events, expectedEvents);
+        QCOMPARE(result->data().size(), 3);
+        QCOMPARE(result->data().at(0)->title(), QStringLiteral("b2"));
+        QCOMPARE(result->data().at(1)->title(), QStringLiteral("c"));
+        QCOMPARE(result->data().at(2)->title(), QStringLiteral("D"));
+    }
+
+    void shouldApplyItemBurstsAsBulkUpdates()
+    {
+        // GIVEN
+        AkonadiFakeData data;
+
+        data.createCollection(GenCollection().withId(42).withRootAsParent().withName(QStringLiteral("42")));
+
+        auto integrator = createIntegrator(data);
+        auto storage = createStorage(data);
+
+        auto query = Domain::LiveQueryOutput<Domain::Task::Ptr>::Ptr();
+        auto fetch = fetchItemsInAllCollectionsFunction(storage);
+        auto predicate = [] (const Akonadi::Item &) {
+            return true;
+        };
 
+        integrator->bind("tasks", query, fetch, predicate);
+        auto result = query->result();
+        TestHelpers::waitForEmptyJobQueue();
+        QVERIFY(result->data().isEmpty());
+
+        int insertCount = 0;
+        int preResetCount = 0;
+        int postResetCount = 0;
+        result->addPostInsertHandler([&insertCount] (const Domain::Task::Ptr &, int) { insertCount++; });
+        result->addPreResetHandler([&preResetCount] { preResetCount++; });
+        result->addPostResetHandler([&postResetCount] { postResetCount++; });
+
+        // WHEN
+        for (int i = 0; i < 150; i++)
+            data.createItem(GenTodo().withId(i + 1).withParent(42).withTitle(QStringLiteral("%1").arg(i, 3, 10, QLatin1Char('0'))));
 
+        // THEN
+        QCOMPARE(insertCount, 100);
+        QCOMPARE(result->data().size(), 100);
+
+        QTRY_COMPARE(result->data().size(), 150);
+        QCOMPARE(insertCount, 100);
+        QCOMPARE(preResetCount, 1);
+        QCOMPARE(postResetCount, 1);
+        QCOMPARE(result->data().last()->title(), QStringLiteral("149"));
+    }
 
     void shouldCallCollectionRemoveHandlers()
     {
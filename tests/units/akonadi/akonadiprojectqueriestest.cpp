@@ -264,6 +264,62 @@ private slots:
         QCOMPARE(result->data().at(0)->title(), QStringLiteral("43"));
     }
 
+    void shouldCountTopLevelOfProjectsInTheirCollection()
+    {
+        // GIVEN
+        AkonadiFakeData data;
+
+        // Two top level collections
+        data.createCollection(GenCollection().withId(42).withRootAsParent().withTaskContent());
+        data.createCollection(GenCollection().withId(43).withRootAsParent().withTaskContent());
+
+        // Two projects in the first collection, one of them having a child
+        data.createItem(GenTodo().withId(42).withParent(42)
+                                 .withTitle(QStringLiteral("42")).withUid(QStringLiteral("uid-42")).asProject());
+        data.createItem(GenTodo().withId(43).withParent(42)
+                                 .withTitle(QStringLiteral("43")).withUid(QStringLiteral("uid-43")).asProject());
+        data.createItem(GenTodo().withId(44).withParent(42)
+                                 .withTitle(QStringLiteral("44")).withParentUid(QStringLiteral("uid-42")));
+
+        // One task in the second collection having the first project uid as parent
+        data.createItem(GenTodo().withId(45).withParent(43)
+                                 .withTitle(QStringLiteral("45")).withParentUid(QStringLiteral("uid-42")));
+
+        auto serializer = Akonadi::Serializer::Ptr(new Akonadi::Serializer);
+        QScopedPointer<Domain::ProjectQueries> queries(new Akonadi::ProjectQueries(Akonadi::StorageInterface::Ptr(data.createStorage()),
+                                                                                   serializer,
+                                                                                   Akonadi::MonitorInterface::Ptr(data.createMonitor())));
+        auto project42 = serializer->createProjectFromItem(data.item(42));
+        auto project43 = serializer->createProjectFromItem(data.item(43));
+
+        // WHEN
+        auto counter42 = queries->countTopLevel(project42);
+        auto counter43 = queries->countTopLevel(project43);
+        QCOMPARE(counter42, queries->countTopLevel(project42));
+        QCOMPARE(counter42->count(), 0);
+        TestHelpers::waitForEmptyJobQueue();
+
+        // THEN
+        QCOMPARE(counter42->count(), 1);
+        QCOMPARE(counter43->count(), 0);
+
+        // WHEN
+        data.createItem(GenTodo().withId(46).withParent(42)
+                                 .withTitle(QStringLiteral("46")).withParentUid(QStringLiteral("uid-43")));
+        data.modifyItem(GenTodo(data.item(44)).withParentUid(QStringLiteral("uid-43")));
+
+        // THEN
+        QCOMPARE(counter42->count(), 0);
+        QCOMPARE(counter43->count(), 2);
+
+        // WHEN
+        data.removeItem(Akonadi::Item(46));
+
+        // THEN
+        QCOMPARE(counter42->count(), 0);
+        QCOMPARE(counter43->count(), 1);
+    }
+
     void shouldNotCrashWhenWeAskAgainTheSameTopLevelArtifacts()
     {
         // GIVEN
@@ -449,8 +505,8 @@ private slots:
 
         // THEN
         QCOMPARE(result->data().size(), 2);
-        QCOMPARE(result->data().at(0)->title(), QStringLiteral("44"));
-        QCOMPARE(result->data().at(1)->title(), QStringLiteral("43"));
+        QCOMPARE(result->data().at(0)->title(), QStringLiteral("43"));
+        QCOMPARE(result->data().at(1)->title(), QStringLiteral("44"));
 
         QVERIFY(!replaceHandlerCalled);
     }
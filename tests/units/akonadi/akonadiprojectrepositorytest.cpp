@@ -25,14 +25,19 @@
 
 #include "utils/mockobject.h"
 
+#include "testlib/akonadifakedata.h"
 #include "testlib/akonadifakejobs.h"
 #include "testlib/akonadifakemonitor.h"
+#include "testlib/gencollection.h"
+#include "testlib/gennote.h"
+#include "testlib/gentodo.h"
 
 #include "akonadi/akonadiprojectrepository.h"
-#include "akonadi/akonadiserializerinterface.h"
+#include "akonadi/akonadiserializer.h"
 #include "akonadi/akonadistorageinterface.h"
 
 using namespace mockitopp;
+using namespace Testlib;
 
 Q_DECLARE_METATYPE(Testlib::AkonadiFakeItemFetchJob*)
 
@@ -314,6 +319,48 @@ private slots:
         }
     }
 
+    void shouldAssociateSeveralArtifactsToAProject()
+    {
+        // GIVEN
+        AkonadiFakeData data;
+
+        // Two top level collections
+        data.createCollection(GenCollection().withId(42).withRootAsParent().withTaskContent().withNoteContent());
+        data.createCollection(GenCollection().withId(43).withRootAsParent().withTaskContent());
+
+        // One project and a note in the first collection
+        data.createItem(GenTodo().withId(42).withParent(42).asProject()
+                                 .withTitle(QStringLiteral("42")).withUid(QStringLiteral("uid-42")));
+        data.createItem(GenNote().withId(43).withParent(42).withTitle(QStringLiteral("43")));
+
+        // Two tasks in the second collection, one being child of the other
+        data.createItem(GenTodo().withId(44).withParent(43)
+                                 .withTitle(QStringLiteral("44")).withUid(QStringLiteral("uid-44")));
+        data.createItem(GenTodo().withId(45).withParent(43)
+                                 .withTitle(QStringLiteral("45")).withUid(QStringLiteral("uid-45"))
+                                 .withParentUid(QStringLiteral("uid-44")));
+
+        auto serializer = Akonadi::Serializer::Ptr(new Akonadi::Serializer);
+        auto project42 = serializer->createProjectFromItem(data.item(42));
+        auto note43 = serializer->createNoteFromItem(data.item(43));
+        auto task44 = serializer->createTaskFromItem(data.item(44));
+
+        QScopedPointer<Akonadi::ProjectRepository> repository(new Akonadi::ProjectRepository(Akonadi::StorageInterface::Ptr(data.createStorage()),
+                                                                                             serializer));
+
+        // WHEN
+        auto job = repository->associateArtifacts(project42, Domain::Artifact::List() << note43 << task44);
+        QVERIFY(job->exec());
+
+        // THEN
+        QCOMPARE(serializer->relatedUidFromItem(data.item(43)), QStringLiteral("uid-42"));
+        QCOMPARE(serializer->relatedUidFromItem(data.item(44)), QStringLiteral("uid-42"));
+        QCOMPARE(serializer->relatedUidFromItem(data.item(45)), QStringLiteral("uid-44"));
+        QCOMPARE(data.item(43).parentCollection().id(), Akonadi::Collection::Id(42));
+        QCOMPARE(data.item(44).parentCollection().id(), Akonadi::Collection::Id(42));
+        QCOMPARE(data.item(45).parentCollection().id(), Akonadi::Collection::Id(42));
+    }
+
     void shouldDissociateAnArtifactFromItsProject_data()
     {
         QTest::addColumn<Domain::Artifact::Ptr>("child");
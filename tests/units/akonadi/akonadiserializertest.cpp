@@ -604,6 +604,47 @@ private slots:
         QVERIFY(artifact.isNull());
     }
 
+    void shouldKnowWhenItemIsARunningTask_data()
+    {
+        QTest::addColumn<bool>("isProject");
+        QTest::addColumn<bool>("isRunning");
+        QTest::addColumn<bool>("expected");
+
+        QTest::newRow("task") << false << false << false;
+        QTest::newRow("running task") << false << true << true;
+        QTest::newRow("project") << true << false << false;
+        QTest::newRow("running project") << true << true << false;
+    }
+
+    void shouldKnowWhenItemIsARunningTask()
+    {
+        // GIVEN
+        QFETCH(bool, isProject);
+        QFETCH(bool, isRunning);
+
+        // A todo with the project and running flags
+        KCalCore::Todo::Ptr todo(new KCalCore::Todo);
+        todo->setSummary(QStringLiteral("foo"));
+        if (isProject)
+            todo->setCustomProperty("Zanshin", "Project", QStringLiteral("1"));
+        if (isRunning)
+            todo->setCustomProperty("Zanshin", "Running", QStringLiteral("1"));
+
+        // ... as payload of an item
+        Akonadi::Item item;
+        item.setMimeType(QStringLiteral("application/x-vnd.akonadi.calendar.todo"));
+        item.setPayload<KCalCore::Todo::Ptr>(todo);
+
+        // WHEN
+        Akonadi::Serializer serializer;
+        const bool result = serializer.isRunningTaskItem(item);
+
+        // THEN
+        QFETCH(bool, expected);
+        QCOMPARE(result, expected);
+        QVERIFY(!serializer.isRunningTaskItem(Akonadi::Item()));
+    }
+
     void shouldUpdateTaskFromItem_data()
     {
         QTest::addColumn<QString>("updatedSummary");
@@ -1160,6 +1201,30 @@ private slots:
         QCOMPARE(uid, expectedUid);
     }
 
+    void shouldRetrieveUidFromItem()
+    {
+        // GIVEN
+        KCalCore::Todo::Ptr todo(new KCalCore::Todo);
+        todo->setUid(QStringLiteral("1"));
+        Akonadi::Item taskItem;
+        taskItem.setMimeType(QStringLiteral("application/x-vnd.akonadi.calendar.todo"));
+        taskItem.setPayload<KCalCore::Todo::Ptr>(todo);
+
+        KMime::Message::Ptr message(new KMime::Message);
+        message->subject(true)->fromUnicodeString(QStringLiteral("foo"), "utf-8");
+        Akonadi::Item noteItem;
+        noteItem.setMimeType(Akonadi::NoteUtils::noteMimeType());
+        noteItem.setPayload<KMime::Message::Ptr>(message);
+
+        // WHEN
+        Akonadi::Serializer serializer;
+
+        // THEN
+        QCOMPARE(serializer.itemUid(taskItem), QStringLiteral("1"));
+        QCOMPARE(serializer.itemUid(noteItem), QString());
+        QCOMPARE(serializer.itemUid(Akonadi::Item()), QString());
+    }
+
     void shouldCreateNoteFromItem_data()
     {
         QTest::addColumn<QString>("title");
@@ -81,6 +81,9 @@ private slots:
             // WHEN
             g.writeEntry("defaultCollection", i);
             g.writeEntry("defaultNoteCollection", i + 1);
+            // The values are kept in memory, writes to the shared config done
+            // behind the settings back only show up once it's reloaded
+            StorageSettings::instance().reloadConfiguration();
 
             // THEN
             QCOMPARE(StorageSettings::instance().defaultTaskCollection(), Collection(i));
@@ -105,6 +108,46 @@ private slots:
         }
     }
 
+    void shouldCoalesceWritesToDisk()
+    {
+        // GIVEN
+        StorageSettings &settings = StorageSettings::instance();
+        settings.setDefaultTaskCollection(Collection(29));
+        settings.syncConfiguration();
+
+        // WHEN
+        for (int i = 30; i <= 40; i++)
+            settings.setDefaultTaskCollection(Collection(i));
+
+        // THEN
+        KConfig onDisk(KSharedConfig::openConfig()->name());
+        QCOMPARE(KConfigGroup(&onDisk, "General").readEntry("defaultCollection", -1), 29);
+        QTRY_COMPARE(KConfig(KSharedConfig::openConfig()->name()).group("General").readEntry("defaultCollection", -1), 40);
+    }
+
+    void shouldReloadOnExternalChanges()
+    {
+        // GIVEN
+        StorageSettings &settings = StorageSettings::instance();
+        settings.setDefaultTaskCollection(Collection(50));
+        settings.setDefaultNoteCollection(Collection(51));
+        settings.syncConfiguration();
+        QSignalSpy taskSpy(&settings, &Akonadi::StorageSettings::defaultTaskCollectionChanged);
+        QSignalSpy noteSpy(&settings, &Akonadi::StorageSettings::defaultNoteCollectionChanged);
+
+        // WHEN
+        KConfig external(KSharedConfig::openConfig()->name());
+        KConfigGroup(&external, "General").writeEntry("defaultCollection", 52);
+        external.sync();
+
+        // THEN
+        QTRY_COMPARE(taskSpy.count(), 1);
+        QCOMPARE(taskSpy.first().first().value<Collection>(), Collection(52));
+        QCOMPARE(settings.defaultTaskCollection(), Collection(52));
+        QCOMPARE(noteSpy.count(), 0);
+        QCOMPARE(settings.defaultNoteCollection(), Collection(51));
+    }
+
     void shouldNotifyTaskCollectionChanges()
     {
         StorageSettings &settings = StorageSettings::instance();
@@ -428,8 +428,8 @@ private slots:
 
         // THEN
         QCOMPARE(result->data().size(), 2);
-        QCOMPARE(result->data().at(0)->title(), QStringLiteral("44"));
-        QCOMPARE(result->data().at(1)->title(), QStringLiteral("43"));
+        QCOMPARE(result->data().at(0)->title(), QStringLiteral("43"));
+        QCOMPARE(result->data().at(1)->title(), QStringLiteral("44"));
 
         QVERIFY(!replaceHandlerCalled);
     }
@@ -1034,6 +1034,47 @@ private slots:
         QCOMPARE(result->data().at(1)->title(), QStringLiteral("43"));
     }
 
+    void shouldOnlyListRunningTasks()
+    {
+        // GIVEN
+        AkonadiFakeData data;
+
+        // One top level collection
+        data.createCollection(GenCollection().withId(42).withRootAsParent().withTaskContent());
+
+        // Three tasks, one of them running
+        data.createItem(GenTodo().withId(42).withParent(42).withTitle(QStringLiteral("42")));
+        data.createItem(GenTodo().withId(43).withParent(42).withTitle(QStringLiteral("43")).running());
+        data.createItem(GenTodo().withId(44).withParent(42).withTitle(QStringLiteral("44")));
+
+        QScopedPointer<Domain::TaskQueries> queries(new Akonadi::TaskQueries(Akonadi::StorageInterface::Ptr(data.createStorage()),
+                                                                             Akonadi::Serializer::Ptr(new Akonadi::Serializer),
+                                                                             Akonadi::MonitorInterface::Ptr(data.createMonitor())));
+        auto result = queries->findRunning();
+        result->data();
+        result = queries->findRunning(); // Should not cause any problem or wrong data
+        QVERIFY(result->data().isEmpty());
+        TestHelpers::waitForEmptyJobQueue();
+
+        QCOMPARE(result->data().size(), 1);
+        QCOMPARE(result->data().at(0)->title(), QStringLiteral("43"));
+        QVERIFY(result->data().at(0)->isRunning());
+
+        // WHEN
+        data.modifyItem(GenTodo(data.item(43)).running(false));
+        data.modifyItem(GenTodo(data.item(44)).running());
+
+        // THEN
+        QCOMPARE(result->data().size(), 1);
+        QCOMPARE(result->data().at(0)->title(), QStringLiteral("44"));
+
+        // WHEN
+        data.removeItem(Akonadi::Item(44));
+
+        // THEN
+        QVERIFY(result->data().isEmpty());
+    }
+
     void shouldLookInAllSelectedCollectionsForInboxTopLevel()
     {
         // GIVEN
@@ -1339,6 +1380,48 @@ private slots:
         QCOMPARE(result->data().at(0)->title(), QStringLiteral("42"));
     }
 
+    void shouldCountInboxTopLevelWithoutListingIt()
+    {
+        // GIVEN
+        AkonadiFakeData data;
+
+        // One top level collection
+        data.createCollection(GenCollection().withId(42).withRootAsParent().withTaskContent());
+
+        // Two top level tasks and a child task
+        data.createItem(GenTodo().withId(42).withParent(42).withUid(QStringLiteral("uid-42")).withTitle(QStringLiteral("42")));
+        data.createItem(GenTodo().withId(43).withParent(42).withTitle(QStringLiteral("43")));
+        data.createItem(GenTodo().withId(44).withParent(42).withTitle(QStringLiteral("44")).withParentUid(QStringLiteral("uid-42")));
+
+        QScopedPointer<Domain::TaskQueries> queries(new Akonadi::TaskQueries(Akonadi::StorageInterface::Ptr(data.createStorage()),
+                                                                             Akonadi::Serializer::Ptr(new Akonadi::Serializer),
+                                                                             Akonadi::MonitorInterface::Ptr(data.createMonitor())));
+        auto counter = queries->countInboxTopLevel();
+        QCOMPARE(counter, queries->countInboxTopLevel());
+        QCOMPARE(counter->count(), 0);
+        TestHelpers::waitForEmptyJobQueue();
+        QCOMPARE(counter->count(), 2);
+
+        // WHEN
+        data.createItem(GenTodo().withId(45).withParent(42).withTitle(QStringLiteral("45")));
+
+        // THEN
+        QCOMPARE(counter->count(), 3);
+
+        // WHEN
+        data.modifyItem(GenTodo(data.item(43)).withParentUid(QStringLiteral("uid-42")));
+
+        // THEN
+        QCOMPARE(counter->count(), 2);
+
+        // WHEN
+        data.modifyItem(GenTodo(data.item(44)).withParentUid(QString()));
+        data.removeItem(Akonadi::Item(45));
+
+        // THEN
+        QCOMPARE(counter->count(), 2);
+    }
+
     void shouldLookInAllWorkdayReportedForAllTasks_data()
     {
         QTest::addColumn<bool>("isExpectedInWorkday");
@@ -1477,7 +1560,7 @@ private slots:
         QCOMPARE(result->data().at(1)->title(), QStringLiteral("43"));
     }
 
-    void shouldPollForCurrentDayToListWorkday()
+    void shouldFollowDayChangesToListWorkday()
     {
         // GIVEN
         qputenv("ZANSHIN_OVERRIDE_DATETIME", "2015-03-10T23:59:59UTC");
@@ -1498,29 +1581,26 @@ private slots:
                                  .withTitle(QStringLiteral("43")).withUid(QStringLiteral("uid-43"))
                                  .withStartDate(today.addDays(1)));
 
-        QScopedPointer<Domain::TaskQueries> queries;
-        {
-            auto akqueries = new Akonadi::TaskQueries(Akonadi::StorageInterface::Ptr(data.createStorage()),
-                                                      Akonadi::Serializer::Ptr(new Akonadi::Serializer),
-                                                      Akonadi::MonitorInterface::Ptr(data.createMonitor()));
-            QCOMPARE(akqueries->workdayPollInterval(), 30000);
-            akqueries->setWorkdayPollInterval(500);
-            queries.reset(akqueries);
-        }
+        QScopedPointer<Domain::TaskQueries> queries(new Akonadi::TaskQueries(Akonadi::StorageInterface::Ptr(data.createStorage()),
+                                                                             Akonadi::Serializer::Ptr(new Akonadi::Serializer),
+                                                                             Akonadi::MonitorInterface::Ptr(data.createMonitor())));
         auto result = queries->findWorkdayTopLevel();
         TestHelpers::waitForEmptyJobQueue();
         QCOMPARE(result->data().size(), 1);
         QCOMPARE(result->data().at(0)->title(), QStringLiteral("42"));
 
+        // Only the newly relevant task is inserted, nothing gets reset
+        int removeCount = 0;
+        result->addPreRemoveHandler([&removeCount] (const Domain::Task::Ptr &, int) { removeCount++; });
+
         // WHEN
         qputenv("ZANSHIN_OVERRIDE_DATETIME", "2015-03-11T00:01:00UTC");
-        QTest::qWait(1000);
-        TestHelpers::waitForEmptyJobQueue();
 
         // THEN
-        QCOMPARE(result->data().size(), 2);
+        QTRY_COMPARE(result->data().size(), 2);
         QCOMPARE(result->data().at(0)->title(), QStringLiteral("42"));
         QCOMPARE(result->data().at(1)->title(), QStringLiteral("43"));
+        QCOMPARE(removeCount, 0);
     }
 };
 
@@ -446,6 +446,55 @@ private slots:
         }
     }
 
+    void shouldRemoveATaskWithItsDescendantsFromCache()
+    {
+        // GIVEN
+        AkonadiFakeData data;
+
+        // One top level collection
+        const auto collection = Akonadi::Collection(GenCollection().withId(42).withRootAsParent().withTaskContent());
+        data.createCollection(collection);
+
+        // Four tasks in the collection (three generations and an unrelated one)
+        data.createItem(GenTodo().withId(42).withParent(42)
+                                 .withTitle(QStringLiteral("42")).withUid(QStringLiteral("uid-42")));
+        data.createItem(GenTodo().withId(43).withParent(42)
+                                 .withTitle(QStringLiteral("43")).withUid(QStringLiteral("uid-43"))
+                                 .withParentUid(QStringLiteral("uid-42")));
+        data.createItem(GenTodo().withId(44).withParent(42)
+                                 .withTitle(QStringLiteral("44")).withUid(QStringLiteral("uid-44"))
+                                 .withParentUid(QStringLiteral("uid-43")));
+        data.createItem(GenTodo().withId(45).withParent(42)
+                                 .withTitle(QStringLiteral("45")).withUid(QStringLiteral("uid-45")));
+
+        // A cache which already knows the collection content
+        auto serializer = Akonadi::Serializer::Ptr(new Akonadi::Serializer);
+        auto monitor = Akonadi::MonitorInterface::Ptr(data.createMonitor());
+        auto cache = Akonadi::Cache::Ptr::create(serializer, monitor);
+        cache->setCollections(Akonadi::StorageInterface::Tasks, Akonadi::Collection::List() << collection);
+        cache->populateCollection(collection, data.items());
+
+        // Fetching from the storage would fail
+        data.storageBehavior().setFetchItemErrorCode(42, KJob::KilledJobError);
+        data.storageBehavior().setFetchItemsErrorCode(42, KJob::KilledJobError);
+
+        auto task42 = serializer->createTaskFromItem(data.item(42));
+        QScopedPointer<Akonadi::TaskRepository> repository(new Akonadi::TaskRepository(Akonadi::StorageInterface::Ptr(data.createStorage()),
+                                                                                       serializer,
+                                                                                       Akonadi::MessagingInterface::Ptr(),
+                                                                                       cache));
+
+        // WHEN
+        auto job = repository->remove(task42);
+        QVERIFY(job->exec());
+
+        // THEN
+        QVERIFY(!data.item(42).isValid());
+        QVERIFY(!data.item(43).isValid());
+        QVERIFY(!data.item(44).isValid());
+        QVERIFY(data.item(45).isValid());
+    }
+
     void shouldPromoteTaskToProject()
     {
         // GIVEN
@@ -611,11 +660,9 @@ private slots:
         Utils::MockObject<Akonadi::SerializerInterface> serializerMock;
         serializerMock(&Akonadi::SerializerInterface::createItemFromTask).when(child).thenReturn(childItem);
         serializerMock(&Akonadi::SerializerInterface::createItemFromTask).when(parent).thenReturn(parentItem);
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(childItem).thenReturn(child);
-        serializerMock(&Akonadi::SerializerInterface::createTaskFromItem).when(parentItem).thenReturn(parent);
         serializerMock(&Akonadi::SerializerInterface::updateItemParent).when(childItem, parent).thenReturn();
-        serializerMock(&Akonadi::SerializerInterface::objectUid).when(parent).thenReturn(QStringLiteral("parent"));
-        serializerMock(&Akonadi::SerializerInterface::objectUid).when(child).thenReturn(QStringLiteral("child"));
+        serializerMock(&Akonadi::SerializerInterface::itemUid).when(parentItem).thenReturn(QStringLiteral("parent"));
+        serializerMock(&Akonadi::SerializerInterface::itemUid).when(childItem).thenReturn(QStringLiteral("child"));
         serializerMock(&Akonadi::SerializerInterface::relatedUidFromItem).when(parentItem).thenReturn(QString());
         serializerMock(&Akonadi::SerializerInterface::relatedUidFromItem).when(childItem).thenReturn(QString());
         if (execParentJob)
@@ -689,6 +736,212 @@ private slots:
         QVERIFY(!job->errorText().isEmpty());
     }
 
+    void shouldUpdateSeveralTasksAtOnce()
+    {
+        // GIVEN
+        AkonadiFakeData data;
+
+        // One top level collection with two tasks
+        data.createCollection(GenCollection().withId(42).withRootAsParent().withTaskContent());
+        data.createItem(GenTodo().withId(42).withParent(42).withTitle(QStringLiteral("42")));
+        data.createItem(GenTodo().withId(43).withParent(42).withTitle(QStringLiteral("43")));
+
+        auto serializer = Akonadi::Serializer::Ptr(new Akonadi::Serializer);
+        auto task42 = serializer->createTaskFromItem(data.item(42));
+        auto task43 = serializer->createTaskFromItem(data.item(43));
+        task42->setTitle(QStringLiteral("new 42"));
+        task43->setDone(true);
+
+        QScopedPointer<Akonadi::TaskRepository> repository(new Akonadi::TaskRepository(Akonadi::StorageInterface::Ptr(data.createStorage()),
+                                                                                       serializer,
+                                                                                       Akonadi::MessagingInterface::Ptr()));
+
+        // WHEN
+        auto job = repository->updateTasks(Domain::Task::List() << task42 << task43);
+        QVERIFY(job->exec());
+
+        // THEN
+        QCOMPARE(serializer->createTaskFromItem(data.item(42))->title(), QStringLiteral("new 42"));
+        QVERIFY(serializer->createTaskFromItem(data.item(43))->isDone());
+    }
+
+    void shouldRemoveSeveralTasksWithTheirDescendants()
+    {
+        // GIVEN
+        AkonadiFakeData data;
+
+        // Two top level collections
+        data.createCollection(GenCollection().withId(42).withRootAsParent().withTaskContent());
+        data.createCollection(GenCollection().withId(43).withRootAsParent().withTaskContent());
+
+        // Three tasks in the first collection (forming a chain) and two in the second one
+        data.createItem(GenTodo().withId(42).withParent(42)
+                                 .withTitle(QStringLiteral("42")).withUid(QStringLiteral("uid-42")));
+        data.createItem(GenTodo().withId(43).withParent(42)
+                                 .withTitle(QStringLiteral("43")).withUid(QStringLiteral("uid-43"))
+                                 .withParentUid(QStringLiteral("uid-42")));
+        data.createItem(GenTodo().withId(44).withParent(42)
+                                 .withTitle(QStringLiteral("44")).withUid(QStringLiteral("uid-44"))
+                                 .withParentUid(QStringLiteral("uid-43")));
+        data.createItem(GenTodo().withId(45).withParent(43)
+                                 .withTitle(QStringLiteral("45")).withUid(QStringLiteral("uid-45")));
+        data.createItem(GenTodo().withId(46).withParent(43)
+                                 .withTitle(QStringLiteral("46")).withUid(QStringLiteral("uid-46")));
+
+        auto serializer = Akonadi::Serializer::Ptr(new Akonadi::Serializer);
+        auto task42 = serializer->createTaskFromItem(data.item(42));
+        auto task43 = serializer->createTaskFromItem(data.item(43));
+        auto task45 = serializer->createTaskFromItem(data.item(45));
+
+        QScopedPointer<Akonadi::TaskRepository> repository(new Akonadi::TaskRepository(Akonadi::StorageInterface::Ptr(data.createStorage()),
+                                                                                       serializer,
+                                                                                       Akonadi::MessagingInterface::Ptr()));
+
+        // WHEN
+        auto job = repository->removeTasks(Domain::Task::List() << task42 << task43 << task45);
+        QVERIFY(job->exec());
+
+        // THEN
+        QVERIFY(!data.item(42).isValid());
+        QVERIFY(!data.item(43).isValid());
+        QVERIFY(!data.item(44).isValid());
+        QVERIFY(!data.item(45).isValid());
+        QVERIFY(data.item(46).isValid());
+    }
+
+    void shouldAssociateSeveralTasksToAnother()
+    {
+        // GIVEN
+        AkonadiFakeData data;
+
+        // Two top level collections
+        data.createCollection(GenCollection().withId(42).withRootAsParent().withTaskContent());
+        data.createCollection(GenCollection().withId(43).withRootAsParent().withTaskContent());
+
+        // Two tasks in the first collection
+        data.createItem(GenTodo().withId(42).withParent(42)
+                                 .withTitle(QStringLiteral("42")).withUid(QStringLiteral("uid-42")));
+        data.createItem(GenTodo().withId(43).withParent(42)
+                                 .withTitle(QStringLiteral("43")).withUid(QStringLiteral("uid-43")));
+
+        // Two tasks in the second collection, one being child of the other
+        data.createItem(GenTodo().withId(44).withParent(43)
+                                 .withTitle(QStringLiteral("44")).withUid(QStringLiteral("uid-44")));
+        data.createItem(GenTodo().withId(45).withParent(43)
+                                 .withTitle(QStringLiteral("45")).withUid(QStringLiteral("uid-45"))
+                                 .withParentUid(QStringLiteral("uid-44")));
+
+        auto serializer = Akonadi::Serializer::Ptr(new Akonadi::Serializer);
+        auto task42 = serializer->createTaskFromItem(data.item(42));
+        auto task43 = serializer->createTaskFromItem(data.item(43));
+        auto task44 = serializer->createTaskFromItem(data.item(44));
+
+        QScopedPointer<Akonadi::TaskRepository> repository(new Akonadi::TaskRepository(Akonadi::StorageInterface::Ptr(data.createStorage()),
+                                                                                       serializer,
+                                                                                       Akonadi::MessagingInterface::Ptr()));
+
+        // WHEN
+        auto job = repository->associateTasks(task42, Domain::Task::List() << task43 << task44);
+        QVERIFY(job->exec());
+
+        // THEN
+        QCOMPARE(serializer->relatedUidFromItem(data.item(43)), QStringLiteral("uid-42"));
+        QCOMPARE(serializer->relatedUidFromItem(data.item(44)), QStringLiteral("uid-42"));
+        QCOMPARE(serializer->relatedUidFromItem(data.item(45)), QStringLiteral("uid-44"));
+        QCOMPARE(data.item(43).parentCollection().id(), Akonadi::Collection::Id(42));
+        QCOMPARE(data.item(44).parentCollection().id(), Akonadi::Collection::Id(42));
+        QCOMPARE(data.item(45).parentCollection().id(), Akonadi::Collection::Id(42));
+    }
+
+    void shouldPreventCyclesDuringBatchAssociation()
+    {
+        // GIVEN
+        AkonadiFakeData data;
+
+        // One top level collection
+        data.createCollection(GenCollection().withId(42).withRootAsParent().withTaskContent());
+
+        // Three tasks in the collection (one being child of the second one)
+        data.createItem(GenTodo().withId(42).withParent(42)
+                                 .withTitle(QStringLiteral("42")).withUid(QStringLiteral("uid-42")));
+        data.createItem(GenTodo().withId(43).withParent(42)
+                                 .withTitle(QStringLiteral("43")).withUid(QStringLiteral("uid-43"))
+                                 .withParentUid(QStringLiteral("uid-42")));
+        data.createItem(GenTodo().withId(44).withParent(42)
+                                 .withTitle(QStringLiteral("44")).withUid(QStringLiteral("uid-44"))
+                                 .withParentUid(QStringLiteral("uid-43")));
+        data.createItem(GenTodo().withId(45).withParent(42)
+                                 .withTitle(QStringLiteral("45")).withUid(QStringLiteral("uid-45")));
+
+        auto serializer = Akonadi::Serializer::Ptr(new Akonadi::Serializer);
+        auto task42 = serializer->createTaskFromItem(data.item(42));
+        auto task44 = serializer->createTaskFromItem(data.item(44));
+        auto task45 = serializer->createTaskFromItem(data.item(45));
+
+        auto monitor = Akonadi::MonitorInterface::Ptr(data.createMonitor());
+        QScopedPointer<Akonadi::TaskRepository> repository(new Akonadi::TaskRepository(Akonadi::StorageInterface::Ptr(data.createStorage()),
+                                                                                       serializer,
+                                                                                       Akonadi::MessagingInterface::Ptr()));
+        QSignalSpy spy(monitor.data(), &Akonadi::MonitorInterface::itemChanged);
+
+        // WHEN
+        auto job = repository->associateTasks(task44, Domain::Task::List() << task45 << task42);
+        QVERIFY(!job->exec());
+
+        // THEN
+        QVERIFY(spy.isEmpty());
+        QVERIFY(job->error() != KJob::NoError);
+        QVERIFY(!job->errorText().isEmpty());
+    }
+
+    void shouldFailAssociationWhenParentIsGone()
+    {
+        // GIVEN
+        AkonadiFakeData data;
+
+        // One top level collection
+        data.createCollection(GenCollection().withId(42).withRootAsParent().withTaskContent());
+
+        // Three tasks in the collection
+        data.createItem(GenTodo().withId(42).withParent(42)
+                                 .withTitle(QStringLiteral("42")).withUid(QStringLiteral("uid-42")));
+        data.createItem(GenTodo().withId(43).withParent(42)
+                                 .withTitle(QStringLiteral("43")).withUid(QStringLiteral("uid-43")));
+        data.createItem(GenTodo().withId(44).withParent(42)
+                                 .withTitle(QStringLiteral("44")).withUid(QStringLiteral("uid-44")));
+
+        auto serializer = Akonadi::Serializer::Ptr(new Akonadi::Serializer);
+        auto task42 = serializer->createTaskFromItem(data.item(42));
+        auto task43 = serializer->createTaskFromItem(data.item(43));
+        auto task44 = serializer->createTaskFromItem(data.item(44));
+
+        QScopedPointer<Akonadi::TaskRepository> repository(new Akonadi::TaskRepository(Akonadi::StorageInterface::Ptr(data.createStorage()),
+                                                                                       serializer,
+                                                                                       Akonadi::MessagingInterface::Ptr()));
+
+        // The parent went away before the association
+        data.removeItem(Akonadi::Item(42));
+
+        // WHEN
+        auto job = repository->associate(task42, task43);
+
+        // THEN
+        QVERIFY(!job->exec());
+        QCOMPARE(job->error(), int(KJob::UserDefinedError));
+        QVERIFY(!job->errorText().isEmpty());
+        QVERIFY(serializer->relatedUidFromItem(data.item(43)).isEmpty());
+
+        // WHEN
+        job = repository->associateTasks(task42, Domain::Task::List() << task43 << task44);
+
+        // THEN
+        QVERIFY(!job->exec());
+        QCOMPARE(job->error(), int(KJob::UserDefinedError));
+        QVERIFY(!job->errorText().isEmpty());
+        QVERIFY(serializer->relatedUidFromItem(data.item(43)).isEmpty());
+        QVERIFY(serializer->relatedUidFromItem(data.item(44)).isEmpty());
+    }
+
     void shouldDissociateATaskFromItsParent_data()
     {
         QTest::addColumn<Domain::Task::Ptr>("child");
@@ -0,0 +1,148 @@
+/* This file is part of Zanshin
+
+   Copyright 2016 Kevin Ottens <ervin@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+#include <testlib/qtest_zanshin.h>
+
+#include "akonadi/akonaditasksearchindexer.h"
+#include "akonadi/akonadiserializer.h"
+
+#include "testlib/akonadifakedata.h"
+#include "testlib/gencollection.h"
+#include "testlib/gentodo.h"
+#include "testlib/testhelpers.h"
+
+using namespace Testlib;
+
+static QStringList titles(const QVector<Domain::TaskSearchIndex::Hit> &hits)
+{
+    auto result = QStringList();
+    foreach (const auto &hit, hits)
+        result << hit.title;
+    return result;
+}
+
+class AkonadiTaskSearchIndexerTest : public QObject
+{
+    Q_OBJECT
+private slots:
+    void shouldIndexOpenTasksUnderTheirItemIds()
+    {
+        // GIVEN
+        AkonadiFakeData data;
+        data.createCollection(GenCollection().withId(42).withRootAsParent().withTaskContent());
+        data.createCollection(GenCollection().withId(43).withRootAsParent().withTaskContent());
+        data.createItem(GenTodo().withId(42).withParent(42).withTitle(QStringLiteral("Buy milk")));
+        data.createItem(GenTodo().withId(43).withParent(43).withTitle(QStringLiteral("Buy bread")));
+        data.createItem(GenTodo().withId(44).withParent(43).withTitle(QStringLiteral("Buy stamps")).done());
+
+        auto index = Domain::TaskSearchIndex::Ptr::create();
+
+        // WHEN
+        Akonadi::TaskSearchIndexer indexer(Akonadi::StorageInterface::Ptr(data.createStorage()),
+                                           Akonadi::Serializer::Ptr(new Akonadi::Serializer),
+                                           Akonadi::MonitorInterface::Ptr(data.createMonitor()),
+                                           index);
+        TestHelpers::waitForEmptyJobQueue();
+
+        // THEN
+        const auto hits = index->search(QStringLiteral("buy"));
+        QCOMPARE(titles(hits), QStringList() << QStringLiteral("Buy bread") << QStringLiteral("Buy milk"));
+        QCOMPARE(hits.at(0).id, qint64(43));
+        QCOMPARE(hits.at(1).id, qint64(42));
+    }
+
+    void shouldFollowTheMonitor()
+    {
+        // GIVEN
+        AkonadiFakeData data;
+        data.createCollection(GenCollection().withId(42).withRootAsParent().withTaskContent());
+        data.createCollection(GenCollection().withId(43).withRootAsParent().withTaskContent());
+        data.createItem(GenTodo().withId(42).withParent(42).withTitle(QStringLiteral("Buy milk")));
+
+        auto index = Domain::TaskSearchIndex::Ptr::create();
+        Akonadi::TaskSearchIndexer indexer(Akonadi::StorageInterface::Ptr(data.createStorage()),
+                                           Akonadi::Serializer::Ptr(new Akonadi::Serializer),
+                                           Akonadi::MonitorInterface::Ptr(data.createMonitor()),
+                                           index);
+        TestHelpers::waitForEmptyJobQueue();
+        QCOMPARE(index->count(), 1);
+
+        // WHEN
+        data.createItem(GenTodo().withId(43).withParent(43).withTitle(QStringLiteral("Buy bread")));
+        data.createItem(GenTodo().withId(44).withParent(43).withTitle(QStringLiteral("Call mom")));
+        data.modifyItem(GenTodo(data.item(42)).withTitle(QStringLiteral("Get milk")));
+
+        // THEN
+        QCOMPARE(titles(index->search(QStringLiteral("buy"))), QStringList() << QStringLiteral("Buy bread"));
+        QCOMPARE(titles(index->search(QStringLiteral("get"))), QStringList() << QStringLiteral("Get milk"));
+        QCOMPARE(index->count(), 3);
+
+        // WHEN
+        data.modifyItem(GenTodo(data.item(42)).done());
+        data.removeItem(Akonadi::Item(44));
+
+        // THEN
+        QCOMPARE(index->count(), 1);
+
+        // WHEN
+        data.removeCollection(Akonadi::Collection(43));
+
+        // THEN
+        QCOMPARE(index->count(), 0);
+    }
+
+    void shouldForgetTasksTurnedIntoProjects()
+    {
+        // GIVEN
+        AkonadiFakeData data;
+        data.createCollection(GenCollection().withId(42).withRootAsParent().withTaskContent());
+        data.createItem(GenTodo().withId(42).withParent(42).withTitle(QStringLiteral("Buy milk")));
+
+        auto index = Domain::TaskSearchIndex::Ptr::create();
+        Akonadi::TaskSearchIndexer indexer(Akonadi::StorageInterface::Ptr(data.createStorage()),
+                                           Akonadi::Serializer::Ptr(new Akonadi::Serializer),
+                                           Akonadi::MonitorInterface::Ptr(data.createMonitor()),
+                                           index);
+        TestHelpers::waitForEmptyJobQueue();
+        QCOMPARE(index->count(), 1);
+
+        // WHEN
+        data.modifyItem(GenTodo(data.item(42)).asProject());
+
+        // THEN
+        QCOMPARE(index->count(), 0);
+        QVERIFY(index->search(QStringLiteral("buy")).isEmpty());
+
+        // WHEN
+        data.modifyItem(GenTodo(data.item(42)).asProject(false));
+        data.removeCollection(Akonadi::Collection(42));
+
+        // THEN
+        QCOMPARE(index->count(), 0);
+    }
+};
+
+ZANSHIN_TEST_MAIN(AkonadiTaskSearchIndexerTest)
+
+#include "akonaditasksearchindexertest.moc"
@@ -371,6 +371,168 @@ private slots:
         QVERIFY(replaceHandlerCalled);
     }
 
+    void shouldOnlyReplaceOutputsWhichChanged()
+    {
+        // GIVEN
+        Domain::LiveQuery<QObject*, QObjectPtr> query;
+        query.setFetchFunction([this] (const Domain::LiveQuery<QObject*, QObjectPtr>::AddFunction &add) {
+            Utils::JobHandler::install(new FakeJob, [this, add] {
+                add(createObject(0, QStringLiteral("0A")));
+                add(createObject(1, QStringLiteral("0B")));
+            });
+        });
+        query.setConvertFunction([] (QObject *object) {
+            auto output = QObjectPtr::create();
+            output->setObjectName(object->objectName());
+            output->setProperty("objectId", object->property("objectId"));
+            return output;
+        });
+        query.setUpdateFunction([] (QObject *object, QObjectPtr &output) {
+            output->setObjectName(object->objectName());
+        });
+        query.setPredicateFunction([] (QObject *object) {
+            return object->objectName().startsWith('0');
+        });
+        query.setRepresentsFunction([] (QObject *object, const QObjectPtr &output) {
+            return object->property("objectId") == output->property("objectId");
+        });
+
+        Domain::QueryResult<QObjectPtr>::Ptr result = query.result();
+        QTest::qWait(150);
+        QCOMPARE(result->data().size(), 2);
+
+        QList<QList<QByteArray>> replacedFields;
+        auto resultPtr = result.data();
+        result->addPostReplaceHandler([&replacedFields, resultPtr](const QObjectPtr &, int) {
+                                          replacedFields << resultPtr->changedFields();
+                                      });
+
+        // WHEN
+        query.onChanged(createObject(1, QStringLiteral("0B")));
+
+        // Then
+        QVERIFY(replacedFields.isEmpty());
+
+        // WHEN
+        query.onChanged(createObject(1, QStringLiteral("0BB")));
+
+        // Then
+        QCOMPARE(result->data().at(1)->objectName(), QStringLiteral("0BB"));
+        QCOMPARE(replacedFields.size(), 1);
+        QCOMPARE(replacedFields.first(), QList<QByteArray>() << "objectName");
+        QVERIFY(result->changedFields().isEmpty());
+    }
+
+    void shouldReplaceOutputsChangedInPlace()
+    {
+        // GIVEN
+        Domain::LiveQuery<QObject*, QObjectPtr> query;
+        query.setFetchFunction([this] (const Domain::LiveQuery<QObject*, QObjectPtr>::AddFunction &add) {
+            Utils::JobHandler::install(new FakeJob, [this, add] {
+                add(createObject(0, QStringLiteral("0A")));
+                add(createObject(1, QStringLiteral("0B")));
+            });
+        });
+        query.setConvertFunction([] (QObject *object) {
+            auto output = QObjectPtr::create();
+            output->setObjectName(object->objectName());
+            output->setProperty("objectId", object->property("objectId"));
+            return output;
+        });
+        query.setUpdateFunction([] (QObject *object, QObjectPtr &output) {
+            output->setObjectName(object->objectName());
+            output->setProperty("objectId", object->property("objectId"));
+        });
+        query.setPredicateFunction([] (QObject *object) {
+            return object->objectName().startsWith('0');
+        });
+        query.setRepresentsFunction([] (QObject *object, const QObjectPtr &output) {
+            return object->property("objectId") == output->property("objectId");
+        });
+
+        Domain::QueryResult<QObjectPtr>::Ptr result = query.result();
+        QTest::qWait(150);
+        QCOMPARE(result->data().size(), 2);
+
+        QList<QList<QByteArray>> replacedFields;
+        auto resultPtr = result.data();
+        result->addPostReplaceHandler([&replacedFields, resultPtr](const QObjectPtr &, int) {
+                                          replacedFields << resultPtr->changedFields();
+                                      });
+
+        // WHEN
+        // Like a model changing the object before storing it
+        result->data().at(1)->setObjectName(QStringLiteral("0BB"));
+        query.onChanged(createObject(1, QStringLiteral("0BB")));
+
+        // THEN
+        QCOMPARE(replacedFields.size(), 1);
+        QCOMPARE(replacedFields.first(), QList<QByteArray>() << "objectName");
+
+        // WHEN
+        result->data().at(0)->setProperty("flagged", true);
+        query.onChanged(createObject(0, QStringLiteral("0A")));
+
+        // THEN
+        QCOMPARE(replacedFields.size(), 2);
+        QCOMPARE(replacedFields.last(), QList<QByteArray>() << "flagged");
+
+        // WHEN
+        query.onChanged(createObject(0, QStringLiteral("0A")));
+        query.onChanged(createObject(1, QStringLiteral("0BB")));
+
+        // THEN
+        QCOMPARE(replacedFields.size(), 2);
+    }
+
+    void shouldKeepResultsSortedOnChanges()
+    {
+        // GIVEN
+        Domain::LiveQuery<QObject*, QPair<int, QString>> query;
+        query.setFetchFunction([this] (const Domain::LiveQuery<QObject*, QString>::AddFunction &add) {
+            Utils::JobHandler::install(new FakeJob, [this, add] {
+                add(createObject(0, QStringLiteral("0C")));
+                add(createObject(1, QStringLiteral("0A")));
+                add(createObject(2, QStringLiteral("0B")));
+            });
+        });
+        query.setConvertFunction([] (QObject *object) {
+            return QPair<int, QString>(object->property("objectId").toInt(), object->objectName());
+        });
+        query.setUpdateFunction([] (QObject *object, QPair<int, QString> &output) {
+            output.second = object->objectName();
+        });
+        query.setPredicateFunction([] (QObject *object) {
+            return object->objectName().startsWith('0');
+        });
+        query.setRepresentsFunction([] (QObject *object, const QPair<int, QString> &output) {
+            return object->property("objectId").toInt() == output.first;
+        });
+        query.setSortKey<QByteArray>([] (const QPair<int, QString> &output) {
+            return output.second.toUtf8();
+        });
+
+        Domain::QueryResult<QPair<int, QString>>::Ptr result = query.result();
+        QTest::qWait(150);
+        QList<QPair<int, QString>> expected;
+        expected << QPair<int, QString>(1, QStringLiteral("0A"))
+                 << QPair<int, QString>(2, QStringLiteral("0B"))
+                 << QPair<int, QString>(0, QStringLiteral("0C"));
+        QCOMPARE(result->data(), expected);
+
+        // WHEN
+        query.onChanged(createObject(1, QStringLiteral("0D")));
+        query.onAdded(createObject(3, QStringLiteral("0BB")));
+
+        // THEN
+        expected.clear();
+        expected << QPair<int, QString>(2, QStringLiteral("0B"))
+                 << QPair<int, QString>(3, QStringLiteral("0BB"))
+                 << QPair<int, QString>(0, QStringLiteral("0C"))
+                 << QPair<int, QString>(1, QStringLiteral("0D"));
+        QCOMPARE(result->data(), expected);
+    }
+
     void shouldRemoveWhenChangesMakeInputUnsuitableForQuery()
     {
         // GIVEN
@@ -469,6 +631,51 @@ private slots:
         QVERIFY(!replaceHandlerCalled);
     }
 
+    void shouldOnlyRemoveWhenChangedAway()
+    {
+        // GIVEN
+        Domain::LiveQuery<QObject*, QPair<int, QString>> query;
+        query.setFetchFunction([this] (const Domain::LiveQuery<QObject*, QString>::AddFunction &add) {
+            Utils::JobHandler::install(new FakeJob, [this, add] {
+                add(createObject(0, QStringLiteral("0A")));
+                add(createObject(1, QStringLiteral("1A")));
+                add(createObject(3, QStringLiteral("0B")));
+                add(createObject(4, QStringLiteral("1B")));
+            });
+        });
+        query.setConvertFunction([] (QObject *object) {
+            return QPair<int, QString>(object->property("objectId").toInt(), object->objectName());
+        });
+        query.setPredicateFunction([] (QObject *object) {
+            return object->objectName().startsWith('0');
+        });
+        query.setRepresentsFunction([] (QObject *object, const QPair<int, QString> &output) {
+            return object->property("objectId").toInt() == output.first;
+        });
+
+        Domain::QueryResult<QPair<int, QString>>::Ptr result = query.result();
+        QTest::qWait(150);
+        QList<QPair<int, QString>> expected;
+        expected << QPair<int, QString>(0, QStringLiteral("0A"))
+                 << QPair<int, QString>(3, QStringLiteral("0B"));
+        QCOMPARE(result->data(), expected);
+
+        bool replaceHandlerCalled = false;
+        result->addPostReplaceHandler([&replaceHandlerCalled](const QPair<int, QString> &, int) {
+                                          replaceHandlerCalled = true;
+                                      });
+
+        // WHEN
+        query.onChangedAway(createObject(0, QStringLiteral("0AA")));
+        query.onChangedAway(createObject(4, QStringLiteral("0BB")));
+        query.onChangedAway(createObject(3, QStringLiteral("1B")));
+
+        // Then
+        expected.removeAt(1);
+        QCOMPARE(result->data(), expected);
+        QVERIFY(!replaceHandlerCalled);
+    }
+
     void shouldEmptyAndFetchAgainOnReset()
     {
         // GIVEN
@@ -525,6 +732,138 @@ private slots:
         QCOMPARE(result->data(), expected);
         QCOMPARE(removeHandlerCallCount, 2);
     }
+
+    void shouldCountInputsMatchingThePredicate()
+    {
+        // GIVEN
+        Domain::LiveCount<QObject*, int> query;
+        query.setFetchFunction([this] (const Domain::LiveQueryInput<QObject*>::AddFunction &add) {
+            Utils::JobHandler::install(new FakeJob, [this, add] {
+                add(createObject(0, QStringLiteral("0A")));
+                add(createObject(1, QStringLiteral("1A")));
+                add(createObject(3, QStringLiteral("0B")));
+                add(createObject(4, QStringLiteral("1B")));
+            });
+        });
+        query.setPredicateFunction([] (QObject *object) {
+            return object->objectName().startsWith('0');
+        });
+        query.setKeyFunction([] (QObject *object) {
+            return object->property("objectId").toInt();
+        });
+
+        Domain::Counter::Ptr counter = query.counter();
+        QCOMPARE(counter->count(), 0);
+        QTest::qWait(150);
+        QCOMPARE(counter->count(), 2);
+
+        QSignalSpy spy(counter.data(), &Domain::Counter::countChanged);
+
+        // WHEN
+        query.onAdded(createObject(6, QStringLiteral("0C")));
+        query.onAdded(createObject(6, QStringLiteral("0C")));
+        query.onAdded(createObject(7, QStringLiteral("1C")));
+
+        // THEN
+        QCOMPARE(counter->count(), 3);
+        QCOMPARE(spy.count(), 1);
+
+        // WHEN
+        query.onChangedAway(createObject(4, QStringLiteral("0BB")));
+        query.onChanged(createObject(4, QStringLiteral("0BB")));
+        query.onChangedAway(createObject(3, QStringLiteral("1B")));
+        query.onChanged(createObject(3, QStringLiteral("1B")));
+        query.onRemoved(createObject(0, QStringLiteral("0A")));
+        query.onRemoved(createObject(1, QStringLiteral("1A")));
+
+        // THEN
+        QCOMPARE(counter->count(), 2);
+        QCOMPARE(spy.count(), 4);
+
+        // WHEN
+        query.beginBulkUpdate();
+        query.onAdded(createObject(8, QStringLiteral("0D")));
+        query.onAdded(createObject(9, QStringLiteral("0E")));
+        QCOMPARE(counter->count(), 2);
+        query.endBulkUpdate();
+
+        // THEN
+        QCOMPARE(counter->count(), 4);
+        QCOMPARE(spy.count(), 5);
+    }
+
+    void shouldCountInputsOfAllGroupsOutOfOneFetch()
+    {
+        // GIVEN
+        int fetchCount = 0;
+        Domain::LiveGroupCount<QObject*, int, int> query;
+        query.setFetchFunction([this, &fetchCount] (const Domain::LiveQueryInput<QObject*>::AddFunction &add) {
+            fetchCount++;
+            Utils::JobHandler::install(new FakeJob, [this, add] {
+                add(createObject(0, QStringLiteral("0A")));
+                add(createObject(1, QStringLiteral("1A")));
+                add(createObject(3, QStringLiteral("0B")));
+                add(createObject(4, QStringLiteral("1B")));
+                add(createObject(5, QStringLiteral("2B")));
+            });
+        });
+        query.setGroupsFunction([] (QObject *object) {
+            return QList<int>() << object->objectName().at(0).digitValue();
+        });
+        query.setKeyFunction([] (QObject *object) {
+            return object->property("objectId").toInt();
+        });
+
+        Domain::Counter::Ptr counter0 = query.counter(0);
+        Domain::Counter::Ptr counter1 = query.counter(1);
+        QCOMPARE(query.counter(0), counter0);
+        QCOMPARE(counter0->count(), 0);
+        QCOMPARE(counter1->count(), 0);
+        QTest::qWait(150);
+        QCOMPARE(counter0->count(), 2);
+        QCOMPARE(counter1->count(), 2);
+        QCOMPARE(query.counter(2)->count(), 1);
+        QCOMPARE(fetchCount, 1);
+
+        QSignalSpy spy0(counter0.data(), &Domain::Counter::countChanged);
+        QSignalSpy spy1(counter1.data(), &Domain::Counter::countChanged);
+
+        // WHEN
+        query.onAdded(createObject(6, QStringLiteral("0C")));
+        query.onAdded(createObject(6, QStringLiteral("0C")));
+        query.onAdded(createObject(7, QStringLiteral("2C")));
+
+        // THEN
+        QCOMPARE(counter0->count(), 3);
+        QCOMPARE(counter1->count(), 2);
+        QCOMPARE(spy0.count(), 1);
+        QCOMPARE(spy1.count(), 0);
+
+        // WHEN
+        query.onChangedAway(createObject(4, QStringLiteral("0BB")));
+        query.onChanged(createObject(4, QStringLiteral("0BB")));
+        query.onRemoved(createObject(1, QStringLiteral("1A")));
+
+        // THEN
+        QCOMPARE(counter0->count(), 4);
+        QCOMPARE(counter1->count(), 0);
+        QCOMPARE(spy0.count(), 2);
+        QCOMPARE(spy1.count(), 2);
+
+        // WHEN
+        query.beginBulkUpdate();
+        query.onAdded(createObject(8, QStringLiteral("1D")));
+        query.onAdded(createObject(9, QStringLiteral("1E")));
+        QCOMPARE(counter1->count(), 0);
+        query.endBulkUpdate();
+
+        // THEN
+        QCOMPARE(counter0->count(), 4);
+        QCOMPARE(counter1->count(), 2);
+        QCOMPARE(spy0.count(), 2);
+        QCOMPARE(spy1.count(), 3);
+        QCOMPARE(fetchCount, 1);
+    }
 };
 
 ZANSHIN_TEST_MAIN(LiveQueryTest)
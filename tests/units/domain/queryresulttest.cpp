@@ -339,6 +339,108 @@ private slots:
         QCOMPARE(postReplaces, expectedPostReplaces);
         QCOMPARE(postReplacesPos, expectedReplacesPos);
     }
+
+    void shouldNotifyBulkUpdatesAsResets()
+    {
+        QList<QString> events, otherEvents;
+
+        QueryResultProvider<QString>::Ptr provider(new QueryResultProvider<QString>);
+        *provider << QStringLiteral("Foo");
+
+        QueryResult<QString>::Ptr result = QueryResult<QString>::create(provider);
+        result->addPostInsertHandler(
+            [&](const QString &value, int)
+            {
+                events << value;
+            }
+        );
+        result->addPreResetHandler(
+            [&]()
+            {
+                events << QStringLiteral("preReset") + QString::number(result->data().size());
+            }
+        );
+        result->addPostResetHandler(
+            [&]()
+            {
+                events << QStringLiteral("postReset") + QString::number(result->data().size());
+            }
+        );
+
+        QueryResult<QString>::Ptr otherResult = QueryResult<QString>::create(provider);
+        otherResult->addPostInsertHandler(
+            [&](const QString &value, int)
+            {
+                otherEvents << value;
+            }
+        );
+
+        provider->beginBulkUpdate();
+        provider->append(QStringLiteral("Bar"));
+        provider->beginBulkUpdate();
+        provider->append(QStringLiteral("Baz"));
+        provider->endBulkUpdate();
+        provider->removeFirst();
+        provider->endBulkUpdate();
+
+        provider->beginBulkUpdate();
+        provider->endBulkUpdate();
+
+        provider->append(QStringLiteral("Bazz"));
+
+        const QList<QString> expectedEvents = {"preReset1", "postReset2", "Bazz"};
+        const QList<QString> expectedOtherEvents = {"Bar", "Baz", "Bazz"};
+        QCOMPARE(events, expectedEvents);
+        QCOMPARE(otherEvents, expectedOtherEvents);
+        QCOMPARE(result->data(), QList<QString>() << "Bar" << "Baz" << "Bazz");
+    }
+
+    void shouldKeepItemsSortedByKey()
+    {
+        QList<QString> events;
+
+        QueryResultProvider<QString>::Ptr provider(new QueryResultProvider<QString>);
+        provider->setSortKey<QByteArray>([] (const QString &value) { return value.left(1).toUtf8(); });
+        QVERIFY(provider->isSorted());
+
+        QueryResult<QString>::Ptr result = QueryResult<QString>::create(provider);
+        result->addPostInsertHandler(
+            [&](const QString &value, int pos)
+            {
+                events << QStringLiteral("insert %1 %2").arg(value).arg(pos);
+            }
+        );
+        result->addPostRemoveHandler(
+            [&](const QString &value, int pos)
+            {
+                events << QStringLiteral("remove %1 %2").arg(value).arg(pos);
+            }
+        );
+        result->addPostReplaceHandler(
+            [&](const QString &value, int pos)
+            {
+                events << QStringLiteral("replace %1 %2").arg(value).arg(pos);
+            }
+        );
+
+        QCOMPARE(provider->insertSorted(QStringLiteral("C")), 0);
+        QCOMPARE(provider->insertSorted(QStringLiteral("A")), 0);
+        QCOMPARE(provider->insertSorted(QStringLiteral("B")), 1);
+        QCOMPARE(provider->insertSorted(QStringLiteral("B2")), 2);
+        QCOMPARE(result->data(), QList<QString>() << "A" << "B" << "B2" << "C");
+
+        events.clear();
+        provider->replace(1, QStringLiteral("B1"));
+        provider->replace(0, QStringLiteral("D"));
+        provider->removeAt(0);
+
+        const QList<QString> expectedEvents = {"replace B1 1",
+                                               "remove A 0", "insert D 3",
+                                               "remove B1 0"};
+        QCOMPARE(events, expectedEvents);
+        QCOMPARE(result->data(), QList<QString>() << "B2" << "C" << "D");
+        QCOMPARE(provider->insertSorted(QStringLiteral("C2")), 2);
+    }
 };
 
 ZANSHIN_TEST_MAIN(QueryResultTest)
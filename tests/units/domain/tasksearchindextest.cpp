@@ -0,0 +1,144 @@
+/* This file is part of Zanshin
+
+   Copyright 2016 Kevin Ottens <ervin@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+#include <testlib/qtest_zanshin.h>
+
+#include "domain/tasksearchindex.h"
+
+using namespace Domain;
+
+static QStringList titles(const QVector<TaskSearchIndex::Hit> &hits)
+{
+    auto result = QStringList();
+    foreach (const auto &hit, hits)
+        result << hit.title;
+    return result;
+}
+
+class TaskSearchIndexTest : public QObject
+{
+    Q_OBJECT
+private slots:
+    void shouldSplitTextInLowerCaseWords()
+    {
+        QCOMPARE(TaskSearchIndex::tokenize(QStringLiteral("  Buy MILK, eggs & buy bread! ")),
+                 QStringList() << QStringLiteral("buy")
+                               << QStringLiteral("milk")
+                               << QStringLiteral("eggs")
+                               << QStringLiteral("bread"));
+        QCOMPARE(TaskSearchIndex::tokenize(QStringLiteral("Café-2")),
+                 QStringList() << QStringLiteral("café") << QStringLiteral("2"));
+        QVERIFY(TaskSearchIndex::tokenize(QStringLiteral(" - ")).isEmpty());
+    }
+
+    void shouldFindTasksByWordPrefixes_data()
+    {
+        QTest::addColumn<QString>("query");
+        QTest::addColumn<QStringList>("expectedTitles");
+
+        QTest::newRow("empty") << QString() << QStringList();
+        QTest::newRow("no match") << QStringLiteral("xyz") << QStringList();
+        QTest::newRow("one word") << QStringLiteral("plumb") << (QStringList() << QStringLiteral("Call the plumber"));
+        QTest::newRow("case insensitive") << QStringLiteral("MILK") << (QStringList() << QStringLiteral("Buy milk"));
+        QTest::newRow("title prefix first") << QStringLiteral("bu") << (QStringList() << QStringLiteral("Buy milk")
+                                                                   << QStringLiteral("Buy new phone")
+                                                                   << QStringLiteral("Rebuild the shed bunker"));
+        QTest::newRow("all words") << QStringLiteral("ph bu") << (QStringList() << QStringLiteral("Buy new phone"));
+    }
+
+    void shouldFindTasksByWordPrefixes()
+    {
+        // GIVEN
+        TaskSearchIndex index;
+
+        // WHEN
+        index.insert(1, QStringLiteral("Buy new phone"));
+        index.insert(2, QStringLiteral("Call the plumber"));
+        index.insert(3, QStringLiteral("Rebuild the shed bunker"));
+        index.insert(4, QStringLiteral("Buy milk"));
+
+        // THEN
+        QFETCH(QString, query);
+        QFETCH(QStringList, expectedTitles);
+        QCOMPARE(index.count(), 4);
+        QCOMPARE(titles(index.search(query)), expectedTitles);
+    }
+
+    void shouldLimitTheNumberOfHits()
+    {
+        // GIVEN
+        TaskSearchIndex index;
+        index.insert(3, QStringLiteral("Task 3"));
+        index.insert(1, QStringLiteral("Task 1"));
+        index.insert(2, QStringLiteral("Task 2"));
+
+        // WHEN
+        const auto hits = index.search(QStringLiteral("task"), 2);
+
+        // THEN
+        QCOMPARE(titles(hits), QStringList() << QStringLiteral("Task 1") << QStringLiteral("Task 2"));
+        QCOMPARE(hits.first().id, qint64(1));
+        QCOMPARE(hits.last().id, qint64(2));
+    }
+
+    void shouldFollowTheChanges()
+    {
+        // GIVEN
+        TaskSearchIndex index;
+        index.insert(1, QStringLiteral("Buy milk"));
+
+        // WHEN
+        index.insert(2, QStringLiteral("Buy bread"));
+
+        // THEN
+        QCOMPARE(titles(index.search(QStringLiteral("buy"))),
+                 QStringList() << QStringLiteral("Buy bread") << QStringLiteral("Buy milk"));
+
+        // WHEN
+        index.insert(1, QStringLiteral("Get milk"));
+
+        // THEN
+        QCOMPARE(titles(index.search(QStringLiteral("buy"))), QStringList() << QStringLiteral("Buy bread"));
+        QCOMPARE(titles(index.search(QStringLiteral("get"))), QStringList() << QStringLiteral("Get milk"));
+        QCOMPARE(index.count(), 2);
+
+        // WHEN
+        index.remove(1);
+
+        // THEN
+        QVERIFY(index.search(QStringLiteral("get")).isEmpty());
+        QCOMPARE(index.count(), 1);
+
+        // WHEN
+        index.clear();
+
+        // THEN
+        QVERIFY(index.search(QStringLiteral("buy")).isEmpty());
+        QCOMPARE(index.count(), 0);
+    }
+};
+
+ZANSHIN_TEST_MAIN(TaskSearchIndexTest)
+
+#include "tasksearchindextest.moc"
@@ -33,7 +33,6 @@
 #include <KCalCore/ICalFormat>
 
 #include <AkonadiCore/Collection>
-#include <AkonadiCore/TransactionSequence>
 #include "akonadi/akonadicollectionfetchjobinterface.h"
 #include "akonadi/akonadiitemfetchjobinterface.h"
 #include "akonadi/akonadistorage.h"
@@ -80,9 +79,11 @@ private slots:
         Zanshin021Migrator migrator;
 
         // WHEN
-        Zanshin021Migrator::SeenItemHash hash = migrator.fetchAllItems();
+        bool ok = false;
+        Zanshin021Migrator::SeenItemHash hash = migrator.fetchAllItems(&ok);
 
         // THEN
+        QVERIFY(ok);
         // the migrator gathered all items and the initial state of "is a project" for each one is correct
         m_expectedUids.insert(QStringLiteral("child-of-project"), false);
         m_expectedUids.insert(QStringLiteral("new-project-with-property"), true);
@@ -101,8 +102,7 @@ private slots:
         Zanshin021Migrator::SeenItemHash hash = migrator.fetchAllItems();
 
         // WHEN
-        Akonadi::TransactionSequence *sequence = new Akonadi::TransactionSequence();
-        migrator.migrateProjectComments(hash, sequence);
+        migrator.migrateProjectComments(hash);
 
         // THEN
         // the project with an old-style comment was modified to have the property
@@ -112,9 +112,6 @@ private slots:
         m_expectedUids[QStringLiteral("old-project-with-comment")] = true; // migrated!
         checkExpectedIsProject(hash, m_expectedUids);
         m_expectedUids[QStringLiteral("old-project-with-comment")] = false; // revert for now
-
-        sequence->rollback();
-        sequence->exec();
     }
 
     void shouldMigrateTaskWithChildrenToProject()
@@ -124,8 +121,7 @@ private slots:
         Zanshin021Migrator::SeenItemHash hash = migrator.fetchAllItems();
 
         // WHEN
-        Akonadi::TransactionSequence *sequence = new Akonadi::TransactionSequence();
-        migrator.migrateProjectWithChildren(hash, sequence);
+        migrator.migrateProjectWithChildren(hash);
 
         // THEN
         // the project with children was modified to have the property
@@ -135,21 +131,69 @@ private slots:
         m_expectedUids[QStringLiteral("project-with-children")] = true; // migrated!
         checkExpectedIsProject(hash, m_expectedUids);
         m_expectedUids[QStringLiteral("project-with-children")] = false; // revert for now
+    }
+
+    void shouldFetchAllItemsQuickly_data()
+    {
+        QTest::addColumn<int>("maxConcurrentFetches");
+
+        QTest::newRow("one at a time") << 1;
+        QTest::newRow("parallel") << 4;
+    }
+
+    void shouldFetchAllItemsQuickly()
+    {
+        // GIVEN
+        QFETCH(int, maxConcurrentFetches);
+        Zanshin021Migrator migrator;
+        migrator.setMaxConcurrentFetches(maxConcurrentFetches);
+        Zanshin021Migrator::SeenItemHash hash;
+
+        // WHEN
+        QBENCHMARK {
+            hash = migrator.fetchAllItems();
+        }
 
-        sequence->rollback();
-        sequence->exec();
+        // THEN
+        checkExpectedIsProject(hash, m_expectedUids);
+    }
+
+    void shouldOnlyReportProjectsInDryRun()
+    {
+        // GIVEN
+        Zanshin021Migrator migrator;
+        migrator.setDryRun(true);
+        QList<QPair<int, int>> progress;
+        migrator.setProgressFunction([&progress] (int done, int total) {
+            progress << qMakePair(done, total);
+        });
+
+        // WHEN
+        const bool ret = migrator.migrateProjects();
+
+        // THEN
+        QVERIFY(ret); // success
+        QCOMPARE(progress, QList<QPair<int, int>>() << qMakePair(0, 2));
+        Zanshin021Migrator::SeenItemHash hash = migrator.fetchAllItems();
+        checkExpectedIsProject(hash, m_expectedUids); // nothing changed
     }
 
     void shouldMigrateProjects()
     {
         // GIVEN
         Zanshin021Migrator migrator;
+        migrator.setChunkSize(1);
+        QList<QPair<int, int>> progress;
+        migrator.setProgressFunction([&progress] (int done, int total) {
+            progress << qMakePair(done, total);
+        });
 
         // WHEN
         const bool ret = migrator.migrateProjects();
 
         // THEN
         QVERIFY(ret); // success
+        QCOMPARE(progress, QList<QPair<int, int>>() << qMakePair(0, 2) << qMakePair(1, 2) << qMakePair(2, 2));
         m_expectedUids[QStringLiteral("old-project-with-comment")] = true; // migrated!
         m_expectedUids[QStringLiteral("project-with-children")] = true; // migrated!
         Zanshin021Migrator::SeenItemHash hash = migrator.fetchAllItems();
@@ -168,7 +212,7 @@ private:
 
         for (auto it = expectedItems.constBegin(); it != expectedItems.constEnd(); ++it) {
             //qDebug() << it.key();
-            QCOMPARE(Zanshin021Migrator::isProject(hash.value(it.key()).item()), it.value());
+            QCOMPARE(hash.value(it.key()).isProject(), it.value());
         }
     }
 
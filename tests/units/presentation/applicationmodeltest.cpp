@@ -166,6 +166,22 @@ private slots:
         QVERIFY(!spy.takeFirst().at(0).value<QObject*>());
     }
 
+    void shouldSupportPagesWhichAreNotPageModels()
+    {
+        // GIVEN
+        Presentation::ApplicationModel app;
+        FakeErrorHandler errorHandler;
+        auto page = new QObject(this);
+
+        // WHEN
+        app.setCurrentPage(page);
+        app.setErrorHandler(&errorHandler);
+
+        // THEN
+        QCOMPARE(app.currentPage(), page);
+        QVERIFY(!page->parent());
+    }
+
     void shouldTakeOwnershipOfCurrentPage()
     {
         // GIVEN
@@ -29,7 +29,7 @@
 #include "domain/task.h"
 
 #include "presentation/artifactfilterproxymodel.h"
-#include "presentation/querytreemodelbase.h"
+#include "presentation/querytreemodel.h"
 
 Q_DECLARE_METATYPE(QList<QStandardItem*>)
 
@@ -282,6 +282,201 @@ private slots:
         // THEN
         QCOMPARE(outputTitles, expectedOutputTitles);
     }
+
+    void shouldSortAgainWhenArtifactsChange()
+    {
+        // GIVEN
+        QStandardItemModel input;
+        input.appendRow(createTaskItem(QStringLiteral("B"), QStringLiteral("foo"), QDate(2014, 03, 10)));
+        input.appendRow(createTaskItem(QStringLiteral("A"), QStringLiteral("foo"), QDate(2014, 03, 05)));
+        input.appendRow(createTaskItem(QStringLiteral("C"), QStringLiteral("foo"), QDate(2014, 03, 01)));
+
+        Presentation::ArtifactFilterProxyModel output;
+        output.setSourceModel(&input);
+        output.setSortType(Presentation::ArtifactFilterProxyModel::DateSort);
+        output.setSortOrder(Qt::AscendingOrder);
+        QCOMPARE(output.index(0, 0).data().toString(), QStringLiteral("C"));
+        QCOMPARE(output.index(2, 0).data().toString(), QStringLiteral("B"));
+
+        // WHEN
+        auto item = input.item(0);
+        auto task = item->data(Presentation::QueryTreeModelBase::ObjectRole).value<Domain::Artifact::Ptr>().objectCast<Domain::Task>();
+        task->setStartDate(QDateTime(QDate(2014, 02, 01)));
+        emit input.dataChanged(item->index(), item->index());
+
+        // THEN
+        QCOMPARE(output.index(0, 0).data().toString(), QStringLiteral("B"));
+        QCOMPARE(output.index(1, 0).data().toString(), QStringLiteral("C"));
+        QCOMPARE(output.index(2, 0).data().toString(), QStringLiteral("A"));
+    }
+
+    void shouldSortRowsInsertedAfterSourceIsSet()
+    {
+        // GIVEN
+        QStandardItemModel input;
+        input.appendRow(createTaskItem(QStringLiteral("B"), QStringLiteral("foo")));
+        input.appendRow(createTaskItem(QStringLiteral("D"), QStringLiteral("foo")));
+
+        Presentation::ArtifactFilterProxyModel output;
+        output.setSourceModel(&input);
+        QCOMPARE(output.index(0, 0).data().toString(), QStringLiteral("B"));
+        QSignalSpy layoutSpy(&output, &QAbstractItemModel::layoutChanged);
+
+        // WHEN
+        input.appendRow(createTaskItem(QStringLiteral("E"), QStringLiteral("foo")));
+
+        // THEN
+        QVERIFY(layoutSpy.isEmpty());
+        QCOMPARE(output.rowCount(), 3);
+        QCOMPARE(output.index(2, 0).data().toString(), QStringLiteral("E"));
+
+        // WHEN
+        input.appendRow(createTaskItem(QStringLiteral("A"), QStringLiteral("foo")));
+        input.insertRow(0, createTaskItem(QStringLiteral("C"), QStringLiteral("foo")));
+
+        // THEN
+        QCOMPARE(output.rowCount(), 5);
+        QCOMPARE(output.index(0, 0).data().toString(), QStringLiteral("A"));
+        QCOMPARE(output.index(1, 0).data().toString(), QStringLiteral("B"));
+        QCOMPARE(output.index(2, 0).data().toString(), QStringLiteral("C"));
+        QCOMPARE(output.index(3, 0).data().toString(), QStringLiteral("D"));
+        QCOMPARE(output.index(4, 0).data().toString(), QStringLiteral("E"));
+    }
+
+    void shouldOnlySortAgainWhenSortKeysChange()
+    {
+        // GIVEN
+        QStandardItemModel input;
+        input.appendRow(createTaskItem(QStringLiteral("B"), QStringLiteral("foo")));
+        input.appendRow(createTaskItem(QStringLiteral("A"), QStringLiteral("foo")));
+        input.appendRow(createTaskItem(QStringLiteral("C"), QStringLiteral("foo")));
+
+        Presentation::ArtifactFilterProxyModel output;
+        output.setSourceModel(&input);
+        QCOMPARE(output.index(0, 0).data().toString(), QStringLiteral("A"));
+        QSignalSpy layoutSpy(&output, &QAbstractItemModel::layoutChanged);
+
+        auto item = input.item(0);
+        auto task = item->data(Presentation::QueryTreeModelBase::ObjectRole).value<Domain::Artifact::Ptr>().objectCast<Domain::Task>();
+
+        // WHEN
+        task->setText(QStringLiteral("bar"));
+        emit input.dataChanged(item->index(), item->index());
+        emit input.dataChanged(item->index(), item->index(), {Qt::CheckStateRole});
+
+        // THEN
+        QVERIFY(layoutSpy.isEmpty());
+
+        // WHEN
+        task->setTitle(QStringLiteral("D"));
+        emit input.dataChanged(item->index(), item->index(), {Presentation::QueryTreeModelBase::ObjectRole});
+
+        // THEN
+        QCOMPARE(layoutSpy.size(), 1);
+        QCOMPARE(output.index(0, 0).data().toString(), QStringLiteral("A"));
+        QCOMPARE(output.index(2, 0).data().toString(), QStringLiteral("B"));
+    }
+
+    void shouldFollowSourceAlreadySortedByTitle()
+    {
+        // GIVEN
+        auto provider = Domain::QueryResultProvider<Domain::Task::Ptr>::Ptr::create();
+        provider->setSortKey<QString>([] (const Domain::Task::Ptr &task) { return task->title().toLower(); });
+
+        QList<Domain::Task::Ptr> tasks;
+        for (const auto &title : {QStringLiteral("B"), QStringLiteral("a"), QStringLiteral("C")}) {
+            auto task = Domain::Task::Ptr::create();
+            task->setTitle(title);
+            task->setProperty("itemId", tasks.size() + 1);
+            tasks << task;
+            provider->insertSorted(task);
+        }
+
+        auto queryGenerator = [provider] (const Domain::Task::Ptr &task) -> Domain::QueryResultInterface<Domain::Task::Ptr>::Ptr {
+            if (!task)
+                return Domain::QueryResult<Domain::Task::Ptr>::create(provider);
+            else
+                return Domain::QueryResult<Domain::Task::Ptr>::Ptr();
+        };
+        auto flagsFunction = [] (const Domain::Task::Ptr &) {
+            return Qt::ItemIsSelectable | Qt::ItemIsEnabled;
+        };
+        auto dataFunction = [] (const Domain::Task::Ptr &task, int role) -> QVariant {
+            if (role == Presentation::QueryTreeModelBase::ObjectRole)
+                return QVariant::fromValue(Domain::Artifact::Ptr(task));
+            else if (role == Qt::DisplayRole)
+                return task->title();
+            else
+                return QVariant();
+        };
+        auto setDataFunction = [] (const Domain::Task::Ptr &, const QVariant &, int) {
+            return false;
+        };
+        Presentation::QueryTreeModel<Domain::Task::Ptr> input(queryGenerator, flagsFunction, dataFunction, setDataFunction);
+        input.setIdentityFunction([] (const Domain::Task::Ptr &task) { return task->property("itemId"); });
+        input.setSortedByTitle(true);
+
+        Presentation::ArtifactFilterProxyModel output;
+        output.setSourceModel(&input);
+        QCOMPARE(output.sortColumn(), -1);
+        QCOMPARE(output.index(0, 0).data().toString(), QStringLiteral("a"));
+        QCOMPARE(output.index(1, 0).data().toString(), QStringLiteral("B"));
+        QCOMPARE(output.index(2, 0).data().toString(), QStringLiteral("C"));
+
+        QSignalSpy layoutSpy(&output, &QAbstractItemModel::layoutChanged);
+        QSignalSpy movedSpy(&input, &QAbstractItemModel::rowsMoved);
+
+        // WHEN
+        tasks.at(1)->setTitle(QStringLiteral("A2"));
+        provider->replace(0, tasks.at(1));
+
+        // THEN
+        QVERIFY(layoutSpy.isEmpty());
+        QVERIFY(movedSpy.isEmpty());
+        QCOMPARE(output.index(0, 0).data().toString(), QStringLiteral("A2"));
+
+        // WHEN
+        tasks.at(0)->setTitle(QStringLiteral("D"));
+        provider->replace(1, tasks.at(0));
+
+        // THEN
+        QCOMPARE(movedSpy.size(), 1);
+        QCOMPARE(output.sortColumn(), -1);
+        QCOMPARE(output.rowCount(), 3);
+        QCOMPARE(output.index(0, 0).data().toString(), QStringLiteral("A2"));
+        QCOMPARE(output.index(1, 0).data().toString(), QStringLiteral("C"));
+        QCOMPARE(output.index(2, 0).data().toString(), QStringLiteral("D"));
+
+        // WHEN
+        output.setSortOrder(Qt::DescendingOrder);
+
+        // THEN
+        QCOMPARE(output.sortColumn(), 0);
+        QCOMPARE(output.index(0, 0).data().toString(), QStringLiteral("D"));
+        QCOMPARE(output.index(1, 0).data().toString(), QStringLiteral("C"));
+        QCOMPARE(output.index(2, 0).data().toString(), QStringLiteral("A2"));
+    }
+
+    void shouldFilterAgainWhenArtifactsChange()
+    {
+        // GIVEN
+        QStandardItemModel input;
+        input.appendRow(createTaskItem(QStringLiteral("1. past"), QStringLiteral(""), QDate::currentDate().addDays(-1)));
+        input.appendRow(createTaskItem(QStringLiteral("2. future"), QStringLiteral(""), QDate::currentDate().addDays(1)));
+
+        Presentation::ArtifactFilterProxyModel output;
+        output.setSourceModel(&input);
+        QCOMPARE(output.rowCount(), 1);
+
+        // WHEN
+        auto item = input.item(1);
+        auto task = item->data(Presentation::QueryTreeModelBase::ObjectRole).value<Domain::Artifact::Ptr>().objectCast<Domain::Task>();
+        task->setStartDate(QDateTime(QDate::currentDate().addDays(-2)));
+        emit input.dataChanged(item->index(), item->index());
+
+        // THEN
+        QCOMPARE(output.rowCount(), 2);
+    }
 };
 
 ZANSHIN_TEST_MAIN(ArtifactFilterProxyModelTest)
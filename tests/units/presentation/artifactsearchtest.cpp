@@ -0,0 +1,139 @@
+/* This file is part of Zanshin
+
+   Copyright 2016 Kevin Ottens <ervin@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+
+#include <testlib/qtest_zanshin.h>
+
+#include <QSemaphore>
+#include <QSignalSpy>
+#include <QThreadPool>
+
+#include "domain/task.h"
+
+#include "presentation/artifactsearch.h"
+
+using namespace Presentation;
+
+class BlockingRunnable : public QRunnable
+{
+public:
+    explicit BlockingRunnable(QSemaphore *started, QSemaphore *release)
+        : m_started(started),
+          m_release(release)
+    {
+    }
+
+    void run() Q_DECL_OVERRIDE
+    {
+        m_started->release();
+        m_release->acquire();
+    }
+
+private:
+    QSemaphore *m_started;
+    QSemaphore *m_release;
+};
+
+class ArtifactSearchTest : public QObject
+{
+    Q_OBJECT
+private:
+    ArtifactTextIndex createIndex() const
+    {
+        ArtifactTextIndex index;
+        foreach (const auto &title, QStringList() << QStringLiteral("Buy milk") << QStringLiteral("Call mom")) {
+            auto task = Domain::Task::Ptr::create();
+            task->setTitle(title);
+            index.insert(task);
+        }
+        return index;
+    }
+
+private slots:
+    void shouldFindMatchesInTheBackground()
+    {
+        // GIVEN
+        ArtifactSearch search(createIndex(), QStringLiteral("milk"));
+        QSignalSpy spy(&search, &ArtifactSearch::finished);
+
+        // WHEN
+        search.start();
+
+        // THEN
+        QVERIFY(spy.wait());
+        QVERIFY(search.isFinished());
+        QCOMPARE(search.matches().size(), 1);
+        QCOMPARE(search.matches().first()->title(), QStringLiteral("Buy milk"));
+    }
+
+    void shouldNotWaitForTheWorkerWhenDestroyed()
+    {
+        // GIVEN
+        auto pool = QThreadPool::globalInstance();
+        const int maxThreadCount = pool->maxThreadCount();
+        pool->setMaxThreadCount(1);
+
+        // The only thread of the pool is busy
+        QSemaphore started, release;
+        pool->start(new BlockingRunnable(&started, &release));
+        started.acquire();
+
+        auto search = new ArtifactSearch(createIndex(), QStringLiteral("milk"));
+        QSignalSpy spy(search, &ArtifactSearch::finished);
+        search->start();
+
+        // WHEN
+        delete search;
+
+        // THEN
+        release.release();
+        pool->waitForDone();
+        QCoreApplication::sendPostedEvents(Q_NULLPTR, QEvent::DeferredDelete);
+        QVERIFY(spy.isEmpty());
+
+        pool->setMaxThreadCount(maxThreadCount);
+    }
+
+    void shouldNotDeliverMatchesOnceDestroyed()
+    {
+        // GIVEN
+        QList<ArtifactSearch*> searches;
+        for (int i = 0; i < 16; i++) {
+            auto search = new ArtifactSearch(createIndex(), QStringLiteral("mo"));
+            search->start();
+            searches << search;
+        }
+
+        // WHEN
+        qDeleteAll(searches);
+        QThreadPool::globalInstance()->waitForDone();
+
+        // THEN
+        QCoreApplication::processEvents();
+        QCoreApplication::sendPostedEvents(Q_NULLPTR, QEvent::DeferredDelete);
+    }
+};
+
+ZANSHIN_TEST_MAIN(ArtifactSearchTest)
+
+#include "artifactsearchtest.moc"
@@ -0,0 +1,146 @@
+/* This file is part of Zanshin
+
+   Copyright 2016 Kevin Ottens <ervin@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+#include <testlib/qtest_zanshin.h>
+
+#include "domain/note.h"
+#include "domain/task.h"
+
+#include "presentation/artifacttextindex.h"
+
+using namespace Presentation;
+
+class ArtifactTextIndexTest : public QObject
+{
+    Q_OBJECT
+private:
+    Domain::Artifact::Ptr createTask(const QString &title, const QString &text) const
+    {
+        auto task = Domain::Task::Ptr::create();
+        task->setTitle(title);
+        task->setText(text);
+        return task;
+    }
+
+    QStringList titles(const QList<Domain::Artifact::Ptr> &artifacts) const
+    {
+        QStringList result;
+        foreach (const auto &artifact, artifacts)
+            result << artifact->title();
+        result.sort();
+        return result;
+    }
+
+private slots:
+    void shouldBeCreatedEmpty()
+    {
+        ArtifactTextIndex index;
+        QCOMPARE(index.size(), 0);
+        QVERIFY(index.find(QStringLiteral("foo")).isEmpty());
+    }
+
+    void shouldFindSubstringsInTitleAndText_data()
+    {
+        QTest::addColumn<QString>("text");
+        QTest::addColumn<int>("fields");
+        QTest::addColumn<QStringList>("expectedTitles");
+
+        const int both = int(ArtifactTextIndex::Title | ArtifactTextIndex::Text);
+        QTest::newRow("title and text") << "find me" << both << (QStringList() << "1. foo" << "2. Find Me");
+        QTest::newRow("title only") << "find me" << int(ArtifactTextIndex::Title) << (QStringList() << "2. Find Me");
+        QTest::newRow("text only") << "find me" << int(ArtifactTextIndex::Text) << (QStringList() << "1. foo");
+        QTest::newRow("short text") << "fi" << both << (QStringList() << "1. foo" << "2. Find Me");
+        QTest::newRow("empty text") << "" << both << (QStringList() << "1. foo" << "2. Find Me" << "3. baz");
+        QTest::newRow("spread trigrams") << "abcde" << both << QStringList();
+        QTest::newRow("unknown trigram") << "qux" << both << QStringList();
+    }
+
+    void shouldFindSubstringsInTitleAndText()
+    {
+        // GIVEN
+        QFETCH(QString, text);
+        QFETCH(int, fields);
+        QFETCH(QStringList, expectedTitles);
+
+        ArtifactTextIndex index;
+        index.insert(createTask(QStringLiteral("1. foo"), QStringLiteral("find me, abcd bcde")));
+        index.insert(createTask(QStringLiteral("2. Find Me"), QStringLiteral("bar")));
+        index.insert(createTask(QStringLiteral("3. baz"), QStringLiteral("baz")));
+
+        // WHEN
+        const auto result = index.find(text, ArtifactTextIndex::Fields(fields));
+
+        // THEN
+        QCOMPARE(titles(result), expectedTitles);
+    }
+
+    void shouldIndexAgainChangedArtifacts()
+    {
+        // GIVEN
+        ArtifactTextIndex index;
+        auto artifact = createTask(QStringLiteral("foo"), QStringLiteral("bar"));
+        index.insert(artifact);
+        QVERIFY(index.matches(artifact, QStringLiteral("FOO")));
+
+        // WHEN
+        artifact->setTitle(QStringLiteral("baz"));
+        index.insert(artifact);
+
+        // THEN
+        QCOMPARE(index.size(), 1);
+        QVERIFY(index.find(QStringLiteral("foo")).isEmpty());
+        QCOMPARE(titles(index.find(QStringLiteral("baz"))), QStringList() << "baz");
+        QVERIFY(!index.matches(artifact, QStringLiteral("foo")));
+    }
+
+    void shouldForgetRemovedArtifacts()
+    {
+        // GIVEN
+        ArtifactTextIndex index;
+        auto artifact1 = createTask(QStringLiteral("foo 1"), QString());
+        auto artifact2 = createTask(QStringLiteral("foo 2"), QString());
+        index.insert(artifact1);
+        index.insert(artifact2);
+
+        // WHEN
+        index.remove(artifact1);
+
+        // THEN
+        QCOMPARE(index.size(), 1);
+        QVERIFY(!index.contains(artifact1));
+        QVERIFY(index.contains(artifact2));
+        QCOMPARE(index.artifact(artifact2.data()), artifact2);
+        QCOMPARE(titles(index.find(QStringLiteral("foo"))), QStringList() << "foo 2");
+
+        // WHEN
+        index.clear();
+
+        // THEN
+        QCOMPARE(index.size(), 0);
+        QVERIFY(index.find(QStringLiteral("foo")).isEmpty());
+    }
+};
+
+ZANSHIN_TEST_MAIN(ArtifactTextIndexTest)
+
+#include "artifacttextindextest.moc"
@@ -261,16 +261,16 @@ private slots:
         // WHEN
         Domain::Artifact::Ptr taskToDrop2(new Domain::Task);
         Domain::Artifact::Ptr noteToDrop2(new Domain::Note);
-        projectRepositoryMock(&Domain::ProjectRepository::associate).when(project1, taskToDrop2).thenReturn(new FakeJob(this));
-        projectRepositoryMock(&Domain::ProjectRepository::associate).when(project1, noteToDrop2).thenReturn(new FakeJob(this));
+        const auto droppedArtifacts = Domain::Artifact::List() << taskToDrop2 << noteToDrop2;
+        projectRepositoryMock(&Domain::ProjectRepository::associateArtifacts).when(project1, droppedArtifacts).thenReturn(new FakeJob(this));
         data.reset(new QMimeData);
         data->setData(QStringLiteral("application/x-zanshin-object"), "object");
-        data->setProperty("objects", QVariant::fromValue(Domain::Artifact::List() << taskToDrop2 << noteToDrop2));
+        data->setProperty("objects", QVariant::fromValue(droppedArtifacts));
         model->dropMimeData(data.get(), Qt::MoveAction, -1, -1, project1Index);
 
         // THEN
-        QVERIFY(projectRepositoryMock(&Domain::ProjectRepository::associate).when(project1, taskToDrop2).exactly(1));
-        QVERIFY(projectRepositoryMock(&Domain::ProjectRepository::associate).when(project1, noteToDrop2).exactly(1));
+        QVERIFY(projectRepositoryMock(&Domain::ProjectRepository::associateArtifacts).when(project1, droppedArtifacts).exactly(1));
+        QVERIFY(projectRepositoryMock(&Domain::ProjectRepository::associate).when(project1, taskToDrop2).exactly(0));
 
         // WHEN a task and a note are dropped on a context
         data.reset(new QMimeData);
@@ -309,8 +309,8 @@ private slots:
         // WHEN two task are drop on the workday
         Domain::Task::Ptr taskToDrop6(new Domain::Task);
         Domain::Task::Ptr taskToDrop7(new Domain::Task);
-        taskRepositoryMock(&Domain::TaskRepository::update).when(taskToDrop6).thenReturn(new FakeJob(this));
-        taskRepositoryMock(&Domain::TaskRepository::update).when(taskToDrop7).thenReturn(new FakeJob(this));
+        const auto tasksToDrop = Domain::Task::List() << taskToDrop6 << taskToDrop7;
+        taskRepositoryMock(&Domain::TaskRepository::updateTasks).when(tasksToDrop).thenReturn(new FakeJob(this));
         data.reset(new QMimeData);
         data->setData(QStringLiteral("application/x-zanshin-object"), "object");
         data->setProperty("objects", QVariant::fromValue(Domain::Artifact::List() << taskToDrop6 << taskToDrop7));
@@ -319,6 +319,7 @@ private slots:
         // THEN
         QCOMPARE(taskToDrop6->startDate().date(), Utils::DateTime::currentDateTime().date());
         QCOMPARE(taskToDrop7->startDate().date(), Utils::DateTime::currentDateTime().date());
+        QVERIFY(taskRepositoryMock(&Domain::TaskRepository::updateTasks).when(tasksToDrop).exactly(1));
     }
 
 
@@ -457,6 +458,132 @@ private slots:
         QCOMPARE(qobject_cast<Presentation::ProjectPageModel*>(project2Page)->project(), project2);
     }
 
+    void shouldCountItemsOfPages()
+    {
+        // GIVEN
+
+        // One project
+        auto project = Domain::Project::Ptr::create();
+        project->setName(QStringLiteral("Project"));
+        auto projectProvider = Domain::QueryResultProvider<Domain::Project::Ptr>::Ptr::create();
+        auto projectResult = Domain::QueryResult<Domain::Project::Ptr>::create(projectProvider);
+        projectProvider->append(project);
+
+        // No contexts
+        auto contextProvider = Domain::QueryResultProvider<Domain::Context::Ptr>::Ptr::create();
+        auto contextResult = Domain::QueryResult<Domain::Context::Ptr>::create(contextProvider);
+
+        // Counters
+        auto inboxCounter = Domain::Counter::Ptr::create();
+        inboxCounter->setCount(3);
+        auto workdayCounter = Domain::Counter::Ptr::create();
+        workdayCounter->setCount(1);
+        auto projectCounter = Domain::Counter::Ptr::create();
+        projectCounter->setCount(2);
+
+        Utils::MockObject<Domain::ProjectQueries> projectQueriesMock;
+        projectQueriesMock(&Domain::ProjectQueries::findAll).when().thenReturn(projectResult);
+        projectQueriesMock(&Domain::ProjectQueries::countTopLevel).when(project).thenReturn(projectCounter);
+
+        Utils::MockObject<Domain::ContextQueries> contextQueriesMock;
+        contextQueriesMock(&Domain::ContextQueries::findAll).when().thenReturn(contextResult);
+
+        Utils::MockObject<Domain::TaskQueries> taskQueriesMock;
+        taskQueriesMock(&Domain::TaskQueries::countInboxTopLevel).when().thenReturn(inboxCounter);
+        taskQueriesMock(&Domain::TaskQueries::countWorkdayTopLevel).when().thenReturn(workdayCounter);
+
+        Presentation::AvailableTaskPagesModel pages(projectQueriesMock.getInstance(),
+                                                    Domain::ProjectRepository::Ptr(),
+                                                    contextQueriesMock.getInstance(),
+                                                    Domain::ContextRepository::Ptr(),
+                                                    taskQueriesMock.getInstance(),
+                                                    Domain::TaskRepository::Ptr());
+        QAbstractItemModel *model = pages.pageListModel();
+        const QModelIndex inboxIndex = model->index(0, 0);
+        const QModelIndex workdayIndex = model->index(1, 0);
+        const QModelIndex projectsIndex = model->index(2, 0);
+        const QModelIndex projectIndex = model->index(0, 0, projectsIndex);
+
+        // WHEN
+        const auto inboxCount = model->data(inboxIndex, Presentation::QueryTreeModelBase::CountRole);
+        const auto workdayCount = model->data(workdayIndex, Presentation::QueryTreeModelBase::CountRole);
+        const auto projectsCount = model->data(projectsIndex, Presentation::QueryTreeModelBase::CountRole);
+        const auto projectCount = model->data(projectIndex, Presentation::QueryTreeModelBase::CountRole);
+
+        // THEN
+        QCOMPARE(inboxCount.toInt(), 3);
+        QCOMPARE(workdayCount.toInt(), 1);
+        QVERIFY(!projectsCount.isValid());
+        QCOMPARE(projectCount.toInt(), 2);
+
+        // WHEN
+        QSignalSpy spy(model, &QAbstractItemModel::dataChanged);
+        inboxCounter->setCount(4);
+        model->data(inboxIndex, Presentation::QueryTreeModelBase::CountRole);
+
+        // THEN
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.first().at(0).toModelIndex(), inboxIndex);
+        QCOMPARE(spy.first().at(2).value<QVector<int>>(), QVector<int>() << Presentation::QueryTreeModelBase::CountRole);
+        QCOMPARE(model->data(inboxIndex, Presentation::QueryTreeModelBase::CountRole).toInt(), 4);
+        QVERIFY(taskQueriesMock(&Domain::TaskQueries::countInboxTopLevel).when().exactly(1));
+    }
+
+    void shouldReuseRecentlyCreatedPages()
+    {
+        // GIVEN
+
+        // Two projects
+        auto project1 = Domain::Project::Ptr::create();
+        project1->setName(QStringLiteral("Project 1"));
+        auto project2 = Domain::Project::Ptr::create();
+        project2->setName(QStringLiteral("Project 2"));
+        auto projectProvider = Domain::QueryResultProvider<Domain::Project::Ptr>::Ptr::create();
+        auto projectResult = Domain::QueryResult<Domain::Project::Ptr>::create(projectProvider);
+        projectProvider->append(project1);
+        projectProvider->append(project2);
+
+        // No contexts
+        auto contextProvider = Domain::QueryResultProvider<Domain::Context::Ptr>::Ptr::create();
+        auto contextResult = Domain::QueryResult<Domain::Context::Ptr>::create(contextProvider);
+
+        // projects mocking
+        Utils::MockObject<Domain::ProjectQueries> projectQueriesMock;
+        projectQueriesMock(&Domain::ProjectQueries::findAll).when().thenReturn(projectResult);
+
+        Utils::MockObject<Domain::ProjectRepository> projectRepositoryMock;
+
+        // contexts mocking
+        Utils::MockObject<Domain::ContextQueries> contextQueriesMock;
+        contextQueriesMock(&Domain::ContextQueries::findAll).when().thenReturn(contextResult);
+
+        Presentation::AvailableTaskPagesModel pages(projectQueriesMock.getInstance(),
+                                                    projectRepositoryMock.getInstance(),
+                                                    contextQueriesMock.getInstance(),
+                                                    Domain::ContextRepository::Ptr(),
+                                                    Domain::TaskQueries::Ptr(),
+                                                    Domain::TaskRepository::Ptr());
+        QAbstractItemModel *model = pages.pageListModel();
+        const QModelIndex inboxIndex = model->index(0, 0);
+        const QModelIndex projectsIndex = model->index(2, 0);
+        const QModelIndex project1Index = model->index(0, 0, projectsIndex);
+        const QModelIndex project2Index = model->index(1, 0, projectsIndex);
+
+        QObject *inboxPage = pages.createPageForIndex(inboxIndex);
+        QObject *project1Page = pages.createPageForIndex(project1Index);
+
+        // WHEN
+        QObject *project2Page = pages.createPageForIndex(project2Index);
+        QObject *project1PageAgain = pages.createPageForIndex(project1Index);
+        QObject *inboxPageAgain = pages.createPageForIndex(inboxIndex);
+
+        // THEN
+        QVERIFY(project2Page);
+        QVERIFY(project2Page != project1Page);
+        QCOMPARE(project1PageAgain, project1Page);
+        QCOMPARE(inboxPageAgain, inboxPage);
+    }
+
     void shouldCreateContextsPage()
     {
         // GIVEN
@@ -250,16 +250,15 @@ private slots:
         // WHEN two tasks are dropped
         auto childTask3 = Domain::Task::Ptr::create();
         auto childTask4 = Domain::Task::Ptr::create();
-        taskRepositoryMock(&Domain::TaskRepository::associate).when(task1, childTask3).thenReturn(new FakeJob(this));
-        taskRepositoryMock(&Domain::TaskRepository::associate).when(task1, childTask4).thenReturn(new FakeJob(this));
+        const auto childTasks = Domain::Task::List() << childTask3 << childTask4;
+        taskRepositoryMock(&Domain::TaskRepository::associateTasks).when(task1, childTasks).thenReturn(new FakeJob(this));
         data.reset(new QMimeData);
         data->setData(QStringLiteral("application/x-zanshin-object"), "object");
         data->setProperty("objects", QVariant::fromValue(Domain::Artifact::List() << childTask3 << childTask4));
         model->dropMimeData(data.get(), Qt::MoveAction, -1, -1, task1Index);
 
         // THEN
-        QVERIFY(taskRepositoryMock(&Domain::TaskRepository::associate).when(task1, childTask3).exactly(1));
-        QVERIFY(taskRepositoryMock(&Domain::TaskRepository::associate).when(task1, childTask4).exactly(1));
+        QVERIFY(taskRepositoryMock(&Domain::TaskRepository::associateTasks).when(task1, childTasks).exactly(1));
 
         // WHEN a task and a note are dropped
         Domain::Artifact::Ptr childTask5(new Domain::Task);
@@ -168,16 +168,15 @@ private slots:
         // WHEN
         auto childTask3 = Domain::Task::Ptr::create();
         auto childTask4 = Domain::Task::Ptr::create();
-        taskRepositoryMock(&Domain::TaskRepository::associate).when(rootTask, childTask3).thenReturn(new FakeJob(this));
-        taskRepositoryMock(&Domain::TaskRepository::associate).when(rootTask, childTask4).thenReturn(new FakeJob(this));
+        const auto childTasks = Domain::Task::List() << childTask3 << childTask4;
+        taskRepositoryMock(&Domain::TaskRepository::associateTasks).when(rootTask, childTasks).thenReturn(new FakeJob(this));
         data.reset(new QMimeData);
         data->setData(QStringLiteral("application/x-zanshin-object"), "object");
         data->setProperty("objects", QVariant::fromValue(Domain::Artifact::List() << childTask3 << childTask4));
         model->dropMimeData(data.get(), Qt::MoveAction, -1, -1, rootTaskIndex);
 
         // THEN
-        QVERIFY(taskRepositoryMock(&Domain::TaskRepository::associate).when(rootTask, childTask3).exactly(1));
-        QVERIFY(taskRepositoryMock(&Domain::TaskRepository::associate).when(rootTask, childTask4).exactly(1));
+        QVERIFY(taskRepositoryMock(&Domain::TaskRepository::associateTasks).when(rootTask, childTasks).exactly(1));
     }
 
     void shouldAddTasksInProject()
@@ -566,20 +565,32 @@ private slots:
         // WHEN
         auto childTask3 = Domain::Task::Ptr::create();
         childTask3->setTitle(QStringLiteral("childTask3"));
-        auto childTask4 = Domain::Task::Ptr::create();
         auto job = new FakeJob(this);
         job->setExpectedError(KJob::KilledJobError, QStringLiteral("Foo"));
         taskRepositoryMock(&Domain::TaskRepository::associate).when(rootTask, childTask3).thenReturn(job);
-        taskRepositoryMock(&Domain::TaskRepository::associate).when(rootTask, childTask4).thenReturn(new FakeJob(this));
         auto data = std::make_unique<QMimeData>();
         data->setData(QStringLiteral("application/x-zanshin-object"), "object");
-        data->setProperty("objects", QVariant::fromValue(Domain::Artifact::List() << childTask3 << childTask4));
+        data->setProperty("objects", QVariant::fromValue(Domain::Artifact::List() << childTask3));
         model->dropMimeData(data.get(), Qt::MoveAction, -1, -1, rootTaskIndex);
 
         // THEN
         QTest::qWait(150);
         QCOMPARE(errorHandler.m_message, QStringLiteral("Cannot move task childTask3 as a sub-task of rootTask: Foo"));
-        QVERIFY(taskRepositoryMock(&Domain::TaskRepository::associate).when(rootTask, childTask4).exactly(1));
+
+        // WHEN
+        auto childTask4 = Domain::Task::Ptr::create();
+        const auto childTasks = Domain::Task::List() << childTask3 << childTask4;
+        job = new FakeJob(this);
+        job->setExpectedError(KJob::KilledJobError, QStringLiteral("Foo"));
+        taskRepositoryMock(&Domain::TaskRepository::associateTasks).when(rootTask, childTasks).thenReturn(job);
+        data.reset(new QMimeData);
+        data->setData(QStringLiteral("application/x-zanshin-object"), "object");
+        data->setProperty("objects", QVariant::fromValue(Domain::Artifact::List() << childTask3 << childTask4));
+        model->dropMimeData(data.get(), Qt::MoveAction, -1, -1, rootTaskIndex);
+
+        // THEN
+        QTest::qWait(150);
+        QCOMPARE(errorHandler.m_message, QStringLiteral("Cannot move tasks as sub-tasks of rootTask: Foo"));
     }
 
     void shouldAssociateToProjectWhenDroppingOnEmptyArea()
@@ -630,18 +641,17 @@ private slots:
         auto model = page.centralListModel();
 
         // WHEN
-        projectRepositoryMock(&Domain::ProjectRepository::associate).when(project, childTask1).thenReturn(new FakeJob(this));
-        projectRepositoryMock(&Domain::ProjectRepository::associate).when(project, childTask2).thenReturn(new FakeJob(this));
+        const auto droppedArtifacts = Domain::Artifact::List() << childTask1 << childTask2;
+        projectRepositoryMock(&Domain::ProjectRepository::associateArtifacts).when(project, droppedArtifacts).thenReturn(new FakeJob(this));
 
         auto data = std::make_unique<QMimeData>();
         data->setData(QStringLiteral("application/x-zanshin-object"), "object");
-        data->setProperty("objects", QVariant::fromValue(Domain::Artifact::List() << childTask1 << childTask2)); // both will be DnD on the empty part
+        data->setProperty("objects", QVariant::fromValue(droppedArtifacts)); // both will be DnD on the empty part
         model->dropMimeData(data.get(), Qt::MoveAction, -1, -1, QModelIndex());
 
         // THEN
         QTest::qWait(150);
-        QVERIFY(projectRepositoryMock(&Domain::ProjectRepository::associate).when(project, childTask1).exactly(1));
-        QVERIFY(projectRepositoryMock(&Domain::ProjectRepository::associate).when(project, childTask2).exactly(1));
+        QVERIFY(projectRepositoryMock(&Domain::ProjectRepository::associateArtifacts).when(project, droppedArtifacts).exactly(1));
     }
 };
 
@@ -116,6 +116,7 @@ private slots:
         QCOMPARE(roles.value(Presentation::QueryTreeModel<QColor>::ObjectRole), QByteArray("object"));
         QCOMPARE(roles.value(Presentation::QueryTreeModel<QColor>::IconNameRole), QByteArray("icon"));
         QCOMPARE(roles.value(Presentation::QueryTreeModel<QColor>::IsDefaultRole), QByteArray("default"));
+        QCOMPARE(roles.value(Presentation::QueryTreeModel<QColor>::CountRole), QByteArray("count"));
     }
 
     void shouldListTasks()
@@ -227,6 +228,200 @@ private slots:
         QCOMPARE(model.rowCount(), 0);
     }
 
+    void shouldResolveParentRowsAfterInsertsAndRemoves()
+    {
+        // GIVEN
+        auto provider = Domain::QueryResultProvider<QString>::Ptr::create();
+        for (int i = 0; i < 5; i++)
+            provider->append(QString::number(i));
+
+        auto queryGenerator = [provider](const QString &item) -> Domain::QueryResultInterface<QString>::Ptr {
+            if (item.isEmpty())
+                return Domain::QueryResult<QString>::create(provider);
+
+            if (item.startsWith('+'))
+                return Domain::QueryResultInterface<QString>::Ptr();
+
+            auto childProvider = Domain::QueryResultProvider<QString>::Ptr::create();
+            childProvider->append('+' + item);
+            return Domain::QueryResult<QString>::create(childProvider);
+        };
+        auto flagsFunction = [](const QString &) {
+            return Qt::ItemIsSelectable | Qt::ItemIsEnabled;
+        };
+        auto dataFunction = [](const QString &item, int role) -> QVariant {
+            if (role != Qt::DisplayRole)
+                return QVariant();
+            return item;
+        };
+        auto setDataFunction = [](const QString &, const QVariant &, int) {
+            return false;
+        };
+        Presentation::QueryTreeModel<QString> model(queryGenerator, flagsFunction, dataFunction, setDataFunction, Q_NULLPTR);
+        new ModelTest(&model, this);
+
+        // WHEN
+        provider->insert(0, QStringLiteral("a"));
+        provider->insert(3, QStringLiteral("b"));
+        provider->removeAt(1);
+        provider->append(QStringLiteral("c"));
+        provider->removeFirst();
+
+        // THEN
+        const QStringList expected = {"1", "b", "2", "3", "4", "c"};
+        QCOMPARE(model.rowCount(), expected.size());
+        for (int row = 0; row < expected.size(); row++) {
+            const auto index = model.index(row, 0);
+            QCOMPARE(index.data().toString(), expected.at(row));
+
+            const auto child = model.index(0, 0, index);
+            QCOMPARE(child.data().toString(), '+' + expected.at(row));
+            QCOMPARE(model.parent(child), index);
+        }
+    }
+
+    void shouldMoveSubtreesBetweenQueries()
+    {
+        // GIVEN
+        QHash<QString, Domain::QueryResultProvider<QString>::Ptr> providers;
+        providers.insert(QString(), Domain::QueryResultProvider<QString>::Ptr::create());
+        providers.value(QString())->append(QStringLiteral("a"));
+        providers.value(QString())->append(QStringLiteral("b"));
+        providers.value(QString())->append(QStringLiteral("c"));
+        providers.insert(QStringLiteral("c"), Domain::QueryResultProvider<QString>::Ptr::create());
+        providers.value(QStringLiteral("c"))->append(QStringLiteral("c1"));
+
+        int generatedQueries = 0;
+        auto queryGenerator = [&providers, &generatedQueries](const QString &item) -> Domain::QueryResultInterface<QString>::Ptr {
+            generatedQueries++;
+            if (!providers.contains(item))
+                providers.insert(item, Domain::QueryResultProvider<QString>::Ptr::create());
+            return Domain::QueryResult<QString>::create(providers.value(item));
+        };
+        auto flagsFunction = [](const QString &) {
+            return Qt::ItemIsSelectable | Qt::ItemIsEnabled;
+        };
+        auto dataFunction = [](const QString &item, int role) -> QVariant {
+            if (role != Qt::DisplayRole)
+                return QVariant();
+            return item;
+        };
+        auto setDataFunction = [](const QString &, const QVariant &, int) {
+            return false;
+        };
+        Presentation::QueryTreeModel<QString> model(queryGenerator, flagsFunction, dataFunction, setDataFunction, Q_NULLPTR);
+        model.setIdentityFunction([](const QString &item) { return QVariant(item); });
+        new ModelTest(&model, this);
+        QSignalSpy movedSpy(&model, &QAbstractItemModel::rowsMoved);
+        QSignalSpy removedSpy(&model, &QAbstractItemModel::rowsRemoved);
+        QSignalSpy insertedSpy(&model, &QAbstractItemModel::rowsInserted);
+        const int queriesBeforeMove = generatedQueries;
+
+        // WHEN
+        providers.value(QString())->removeAt(2);
+        providers.value(QStringLiteral("a"))->append(QStringLiteral("c"));
+
+        // THEN
+        QCOMPARE(movedSpy.size(), 1);
+        QCOMPARE(removedSpy.size(), 0);
+        QCOMPARE(insertedSpy.size(), 0);
+        QCOMPARE(generatedQueries, queriesBeforeMove);
+
+        QCOMPARE(model.rowCount(), 2);
+        const auto aIndex = model.index(0, 0);
+        QCOMPARE(model.rowCount(aIndex), 1);
+        const auto cIndex = model.index(0, 0, aIndex);
+        QCOMPARE(cIndex.data().toString(), QStringLiteral("c"));
+        QCOMPARE(model.parent(cIndex), aIndex);
+        QCOMPARE(model.index(0, 0, cIndex).data().toString(), QStringLiteral("c1"));
+
+        // WHEN
+        providers.value(QString())->removeAt(1);
+
+        // THEN
+        QCOMPARE(model.rowCount(), 2);
+        QTRY_COMPARE(model.rowCount(), 1);
+        QCOMPARE(removedSpy.size(), 1);
+        QCOMPARE(movedSpy.size(), 1);
+        QCOMPARE(model.index(0, 0).data().toString(), QStringLiteral("a"));
+    }
+
+    void shouldKeepTheNodesStillThereOnBulkUpdates()
+    {
+        // GIVEN
+        QHash<QString, Domain::QueryResultProvider<QString>::Ptr> providers;
+        providers.insert(QString(), Domain::QueryResultProvider<QString>::Ptr::create());
+        providers.value(QString())->append(QStringLiteral("a"));
+        providers.value(QString())->append(QStringLiteral("b"));
+        providers.value(QString())->append(QStringLiteral("c"));
+        providers.value(QString())->append(QStringLiteral("d"));
+        providers.insert(QStringLiteral("b"), Domain::QueryResultProvider<QString>::Ptr::create());
+        providers.value(QStringLiteral("b"))->append(QStringLiteral("b1"));
+
+        int generatedQueries = 0;
+        auto queryGenerator = [&providers, &generatedQueries](const QString &item) -> Domain::QueryResultInterface<QString>::Ptr {
+            generatedQueries++;
+            if (!providers.contains(item))
+                providers.insert(item, Domain::QueryResultProvider<QString>::Ptr::create());
+            return Domain::QueryResult<QString>::create(providers.value(item));
+        };
+        auto flagsFunction = [](const QString &) {
+            return Qt::ItemIsSelectable | Qt::ItemIsEnabled;
+        };
+        auto dataFunction = [](const QString &item, int role) -> QVariant {
+            if (role != Qt::DisplayRole)
+                return QVariant();
+            return item;
+        };
+        auto setDataFunction = [](const QString &, const QVariant &, int) {
+            return false;
+        };
+        Presentation::QueryTreeModel<QString> model(queryGenerator, flagsFunction, dataFunction, setDataFunction, Q_NULLPTR);
+        new ModelTest(&model, this);
+        const QPersistentModelIndex b1Index = model.index(0, 0, model.index(1, 0));
+        const QPersistentModelIndex dIndex = model.index(3, 0);
+        QSignalSpy removedSpy(&model, &QAbstractItemModel::rowsRemoved);
+        QSignalSpy insertedSpy(&model, &QAbstractItemModel::rowsInserted);
+        QSignalSpy movedSpy(&model, &QAbstractItemModel::rowsMoved);
+        QSignalSpy changedSpy(&model, &QAbstractItemModel::dataChanged);
+        QSignalSpy resetSpy(&model, &QAbstractItemModel::modelReset);
+        const int queriesBeforeUpdate = generatedQueries;
+
+        // WHEN
+        auto provider = providers.value(QString());
+        provider->beginBulkUpdate();
+        provider->removeAt(0);
+        provider->append(QStringLiteral("e"));
+        provider->append(QStringLiteral("f"));
+        provider->removeAt(1);
+        provider->insert(1, QStringLiteral("c"));
+        provider->endBulkUpdate();
+
+        // THEN
+        const QStringList expected = {"b", "c", "d", "e", "f"};
+        QCOMPARE(model.rowCount(), expected.size());
+        for (int row = 0; row < expected.size(); row++)
+            QCOMPARE(model.index(row, 0).data().toString(), expected.at(row));
+
+        QCOMPARE(resetSpy.size(), 0);
+        QCOMPARE(movedSpy.size(), 0);
+        QCOMPARE(removedSpy.size(), 1);
+        QCOMPARE(removedSpy.first().at(1).toInt(), 0);
+        QCOMPARE(removedSpy.first().at(2).toInt(), 0);
+        QCOMPARE(insertedSpy.size(), 1);
+        QCOMPARE(insertedSpy.first().at(1).toInt(), 3);
+        QCOMPARE(insertedSpy.first().at(2).toInt(), 4);
+        QCOMPARE(changedSpy.size(), 1);
+        QCOMPARE(changedSpy.first().at(0).toModelIndex(), model.index(0, 0));
+        QCOMPARE(changedSpy.first().at(1).toModelIndex(), model.index(2, 0));
+        QCOMPARE(generatedQueries, queriesBeforeUpdate + 2);
+
+        QVERIFY(b1Index.isValid());
+        QCOMPARE(b1Index.data().toString(), QStringLiteral("b1"));
+        QCOMPARE(model.parent(b1Index), model.index(0, 0));
+        QCOMPARE(dIndex.row(), 2);
+    }
+
     void shouldReactToTaskAdd()
     {
         // GIVEN
@@ -675,6 +870,7 @@ private slots:
         new ModelTest(&model, this);
         QSignalSpy titleChangedSpy(task.data(), &Domain::Task::titleChanged);
         QSignalSpy doneChangedSpy(task.data(), &Domain::Task::doneChanged);
+        QSignalSpy dataChangedSpy(&model, &QAbstractItemModel::dataChanged);
 
         // WHEN
         const auto index = model.index(taskPos, 0);
@@ -684,6 +880,10 @@ private slots:
         // THEN
         QVERIFY(repositoryMock(&Domain::TaskRepository::update).when(task).exactly(2));
 
+        QCOMPARE(dataChangedSpy.size(), 2);
+        QCOMPARE(dataChangedSpy.first().at(0).toModelIndex(), index);
+        QCOMPARE(dataChangedSpy.last().at(1).toModelIndex(), index);
+
         QCOMPARE(titleChangedSpy.size(), 1);
         QCOMPARE(titleChangedSpy.first().first().toString(), QStringLiteral("alternate second"));
         QCOMPARE(doneChangedSpy.size(), 1);
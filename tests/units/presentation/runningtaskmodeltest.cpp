@@ -41,7 +41,7 @@ public:
         m_taskProvider = Domain::QueryResultProvider<Domain::Task::Ptr>::Ptr::create();
         auto taskResult = Domain::QueryResult<Domain::Task::Ptr>::create(m_taskProvider);
 
-        m_taskQueriesMock(&Domain::TaskQueries::findAll).when().thenReturn(taskResult);
+        m_taskQueriesMock(&Domain::TaskQueries::findRunning).when().thenReturn(taskResult);
         m_taskQueriesMockInstance = m_taskQueriesMock.getInstance();
 
         Utils::MockObject<Domain::TaskRepository> taskRepositoryMock;
@@ -84,6 +84,26 @@ private slots:
         QCOMPARE(model.runningTask(), initialTask);
     }
 
+    void shouldKeepTheTaskItStartedWhenItShowsUpAsRunning()
+    {
+        // GIVEN
+        TestDependencies deps;
+        Presentation::RunningTaskModel model(deps.m_taskQueriesMockInstance, deps.m_taskRepositoryMockInstance);
+        Domain::Task::Ptr task = Domain::Task::Ptr::create();
+        model.setRunningTask(task);
+        QSignalSpy spy(&model, &Presentation::RunningTaskModel::runningTaskChanged);
+
+        // WHEN
+        auto storedTask = Domain::Task::Ptr::create();
+        storedTask->setRunning(true);
+        deps.m_taskProvider->append(storedTask);
+
+        // THEN
+        QCOMPARE(model.runningTask(), task);
+        QVERIFY(task->isRunning());
+        QCOMPARE(spy.count(), 0);
+    }
+
     void shouldStartTask()
     {
         // GIVEN
@@ -157,16 +157,15 @@ private slots:
         // WHEN
         auto childTask3 = Domain::Task::Ptr::create();
         auto childTask4 = Domain::Task::Ptr::create();
-        taskRepositoryMock(&Domain::TaskRepository::associate).when(rootTask, childTask3).thenReturn(new FakeJob(this));
-        taskRepositoryMock(&Domain::TaskRepository::associate).when(rootTask, childTask4).thenReturn(new FakeJob(this));
+        const auto childTasks = Domain::Task::List() << childTask3 << childTask4;
+        taskRepositoryMock(&Domain::TaskRepository::associateTasks).when(rootTask, childTasks).thenReturn(new FakeJob(this));
         data.reset(new QMimeData);
         data->setData(QStringLiteral("application/x-zanshin-object"), "object");
         data->setProperty("objects", QVariant::fromValue(Domain::Artifact::List() << childTask3 << childTask4));
         model->dropMimeData(data.get(), Qt::MoveAction, -1, -1, rootTaskIndex);
 
         // THEN
-        QVERIFY(taskRepositoryMock(&Domain::TaskRepository::associate).when(rootTask, childTask3).exactly(1));
-        QVERIFY(taskRepositoryMock(&Domain::TaskRepository::associate).when(rootTask, childTask4).exactly(1));
+        QVERIFY(taskRepositoryMock(&Domain::TaskRepository::associateTasks).when(rootTask, childTasks).exactly(1));
     }
 
     void shouldAddTasksInInbox()
@@ -289,6 +288,43 @@ private slots:
         QVERIFY(taskRepositoryMock(&Domain::TaskRepository::remove).when(task2).exactly(1));
     }
 
+    void shouldDeleteSeveralItemsAtOnce()
+    {
+        // GIVEN
+
+        // Three tasks
+        auto task1 = Domain::Task::Ptr::create();
+        auto task2 = Domain::Task::Ptr::create();
+        auto task3 = Domain::Task::Ptr::create();
+        auto taskProvider = Domain::QueryResultProvider<Domain::Task::Ptr>::Ptr::create();
+        auto taskResult = Domain::QueryResult<Domain::Task::Ptr>::create(taskProvider);
+        taskProvider->append(task1);
+        taskProvider->append(task2);
+        taskProvider->append(task3);
+
+        Utils::MockObject<Domain::TaskQueries> taskQueriesMock;
+        taskQueriesMock(&Domain::TaskQueries::findInboxTopLevel).when().thenReturn(taskResult);
+        taskQueriesMock(&Domain::TaskQueries::findChildren).when(task1).thenReturn(Domain::QueryResult<Domain::Task::Ptr>::Ptr());
+        taskQueriesMock(&Domain::TaskQueries::findChildren).when(task2).thenReturn(Domain::QueryResult<Domain::Task::Ptr>::Ptr());
+        taskQueriesMock(&Domain::TaskQueries::findChildren).when(task3).thenReturn(Domain::QueryResult<Domain::Task::Ptr>::Ptr());
+
+        const auto removedTasks = Domain::Task::List() << task1 << task3;
+        Utils::MockObject<Domain::TaskRepository> taskRepositoryMock;
+        taskRepositoryMock(&Domain::TaskRepository::removeTasks).when(removedTasks).thenReturn(new FakeJob(this));
+
+        Presentation::TaskInboxPageModel inbox(taskQueriesMock.getInstance(),
+                                               taskRepositoryMock.getInstance());
+
+        // WHEN
+        const auto indexes = QModelIndexList() << inbox.centralListModel()->index(0, 0)
+                                               << inbox.centralListModel()->index(2, 0);
+        inbox.removeItems(indexes);
+
+        // THEN
+        QVERIFY(taskRepositoryMock(&Domain::TaskRepository::removeTasks).when(removedTasks).exactly(1));
+        QVERIFY(taskRepositoryMock(&Domain::TaskRepository::remove).when(any<Domain::Task::Ptr>()).exactly(0));
+    }
+
     void shouldGetAnErrorMessageWhenDeleteItemsFailed()
     {
         // GIVEN
@@ -461,20 +497,32 @@ private slots:
         // WHEN
         auto childTask3 = Domain::Task::Ptr::create();
         childTask3->setTitle(QStringLiteral("childTask3"));
-        auto childTask4 = Domain::Task::Ptr::create();
         auto job = new FakeJob(this);
         job->setExpectedError(KJob::KilledJobError, QStringLiteral("Foo"));
         taskRepositoryMock(&Domain::TaskRepository::associate).when(rootTask, childTask3).thenReturn(job);
-        taskRepositoryMock(&Domain::TaskRepository::associate).when(rootTask, childTask4).thenReturn(new FakeJob(this));
         auto data = std::make_unique<QMimeData>();
         data->setData(QStringLiteral("application/x-zanshin-object"), "object");
-        data->setProperty("objects", QVariant::fromValue(Domain::Artifact::List() << childTask3 << childTask4));
+        data->setProperty("objects", QVariant::fromValue(Domain::Artifact::List() << childTask3));
         model->dropMimeData(data.get(), Qt::MoveAction, -1, -1, rootTaskIndex);
 
         // THEN
         QTest::qWait(150);
         QCOMPARE(errorHandler.m_message, QStringLiteral("Cannot move task childTask3 as sub-task of rootTask: Foo"));
-        QVERIFY(taskRepositoryMock(&Domain::TaskRepository::associate).when(rootTask, childTask4).exactly(1));
+
+        // WHEN
+        auto childTask4 = Domain::Task::Ptr::create();
+        const auto childTasks = Domain::Task::List() << childTask3 << childTask4;
+        job = new FakeJob(this);
+        job->setExpectedError(KJob::KilledJobError, QStringLiteral("Foo"));
+        taskRepositoryMock(&Domain::TaskRepository::associateTasks).when(rootTask, childTasks).thenReturn(job);
+        data.reset(new QMimeData);
+        data->setData(QStringLiteral("application/x-zanshin-object"), "object");
+        data->setProperty("objects", QVariant::fromValue(Domain::Artifact::List() << childTask3 << childTask4));
+        model->dropMimeData(data.get(), Qt::MoveAction, -1, -1, rootTaskIndex);
+
+        // THEN
+        QTest::qWait(150);
+        QCOMPARE(errorHandler.m_message, QStringLiteral("Cannot move tasks as sub-tasks of rootTask: Foo"));
     }
 
     void shouldDeparentWhenNoErrorHappens()
@@ -149,6 +149,21 @@ private slots:
         QVERIFY(!item.payload<KCalCore::Todo::Ptr>()->isCompleted());
     }
 
+    void shouldAllowToSetRunningState()
+    {
+        // GIVEN
+        Akonadi::Item item = GenTodo().running();
+
+        // THEN
+        QCOMPARE(item.payload<KCalCore::Todo::Ptr>()->customProperty("Zanshin", "Running"), QStringLiteral("1"));
+
+        // WHEN
+        item = GenTodo(item).running(false);
+
+        // THEN
+        QVERIFY(item.payload<KCalCore::Todo::Ptr>()->customProperty("Zanshin", "Running").isEmpty());
+    }
+
     void shouldAllowToSetDoneDate()
     {
         // GIVEN
@@ -0,0 +1,87 @@
+/* This file is part of Zanshin
+
+   Copyright 2016 Kevin Ottens <ervin@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+#include <testlib/qtest_zanshin.h>
+
+#include <QSignalSpy>
+
+#include "utils/daychangenotifier.h"
+
+using namespace Utils;
+
+class DayChangeNotifierTest : public QObject
+{
+    Q_OBJECT
+private slots:
+    void cleanup()
+    {
+        qunsetenv("ZANSHIN_OVERRIDE_DATETIME");
+    }
+
+    void shouldStartWithCurrentDate()
+    {
+        // GIVEN
+        qputenv("ZANSHIN_OVERRIDE_DATETIME", "2015-03-10T12:00:00UTC");
+
+        // WHEN
+        DayChangeNotifier notifier;
+
+        // THEN
+        QCOMPARE(notifier.currentDate(), QDate(2015, 3, 10));
+    }
+
+    void shouldNotifyAtMidnight()
+    {
+        // GIVEN
+        qputenv("ZANSHIN_OVERRIDE_DATETIME", "2015-03-10T23:59:59UTC");
+        DayChangeNotifier notifier;
+        QSignalSpy spy(&notifier, &DayChangeNotifier::dayChanged);
+
+        // WHEN
+        qputenv("ZANSHIN_OVERRIDE_DATETIME", "2015-03-11T00:00:01UTC");
+
+        // THEN
+        QTRY_COMPARE(spy.count(), 1);
+        QCOMPARE(spy.takeFirst().at(0).toDate(), QDate(2015, 3, 11));
+        QCOMPARE(notifier.currentDate(), QDate(2015, 3, 11));
+    }
+
+    void shouldNotNotifyWhenDateIsUnchanged()
+    {
+        // GIVEN
+        qputenv("ZANSHIN_OVERRIDE_DATETIME", "2015-03-10T23:59:59UTC");
+        DayChangeNotifier notifier;
+        QSignalSpy spy(&notifier, &DayChangeNotifier::dayChanged);
+
+        // WHEN
+        QTest::qWait(1500);
+
+        // THEN
+        QVERIFY(spy.isEmpty());
+        QCOMPARE(notifier.currentDate(), QDate(2015, 3, 10));
+    }
+};
+
+ZANSHIN_TEST_MAIN(DayChangeNotifierTest)
+
+#include "daychangenotifiertest.moc"
@@ -0,0 +1,280 @@
+/* This file is part of Zanshin
+
+   Copyright 2016 Kevin Ottens <ervin@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+#include <testlib/qtest_zanshin.h>
+
+#include "utils/future.h"
+
+#include "testlib/fakejob.h"
+
+using namespace Utils;
+
+class FutureTest : public QObject
+{
+    Q_OBJECT
+private slots:
+    void shouldChainContinuations()
+    {
+        // GIVEN
+        Future<int> source;
+        auto calls = QStringList();
+        auto result = source.then([&calls] (int value) {
+            calls << QStringLiteral("first");
+            return QString::number(value * 2);
+        }).then([&calls] (const QString &value) {
+            calls << QStringLiteral("second");
+            return value + QStringLiteral("!");
+        });
+        QVERIFY(!result.isFinished());
+
+        // WHEN
+        source.setResult(21);
+
+        // THEN
+        QVERIFY(result.isFinished());
+        QCOMPARE(result.error(), int(KJob::NoError));
+        QCOMPARE(result.result(), QStringLiteral("42!"));
+        QCOMPARE(calls, QStringList() << QStringLiteral("first") << QStringLiteral("second"));
+    }
+
+    void shouldCallContinuationsRightAwayWhenFinished()
+    {
+        // GIVEN
+        Future<int> source;
+        source.setResult(2);
+
+        // WHEN
+        auto result = source.then([] (int value) { return value + 1; });
+
+        // THEN
+        QVERIFY(result.isFinished());
+        QCOMPARE(result.result(), 3);
+    }
+
+    void shouldForwardErrors()
+    {
+        // GIVEN
+        Future<int> source;
+        bool called = false;
+        auto result = source.then([&called] (int value) {
+            called = true;
+            return value;
+        });
+
+        // WHEN
+        source.setError(KJob::UserDefinedError, QStringLiteral("Foo"));
+
+        // THEN
+        QVERIFY(!called);
+        QVERIFY(result.isFinished());
+        QVERIFY(!result.isCanceled());
+        QCOMPARE(result.error(), int(KJob::UserDefinedError));
+        QCOMPARE(result.errorText(), QStringLiteral("Foo"));
+    }
+
+    void shouldFollowFuturesReturnedByContinuations()
+    {
+        // GIVEN
+        Future<int> source;
+        Future<QString> inner;
+        auto result = source.then([inner] (int) { return inner; });
+
+        // WHEN
+        source.setResult(1);
+
+        // THEN
+        QVERIFY(!result.isFinished());
+
+        // WHEN
+        inner.setResult(QStringLiteral("done"));
+
+        // THEN
+        QVERIFY(result.isFinished());
+        QCOMPARE(result.result(), QStringLiteral("done"));
+    }
+
+    void shouldPropagateCancellationUpstream()
+    {
+        // GIVEN
+        Future<int> source;
+        bool canceled = false;
+        source.setCanceler([&canceled] { canceled = true; });
+        bool called = false;
+        auto result = source.then([&called] (int) { called = true; });
+
+        // WHEN
+        result.cancel();
+
+        // THEN
+        QVERIFY(canceled);
+        QVERIFY(source.isCanceled());
+        QVERIFY(result.isCanceled());
+
+        // WHEN
+        source.setResult(1);
+
+        // THEN
+        QVERIFY(!called);
+    }
+
+    void shouldCombineFuturesInOrder()
+    {
+        // GIVEN
+        auto futures = QVector<Future<int>>() << Future<int>() << Future<int>() << Future<int>();
+        auto all = whenAll(futures);
+
+        // WHEN
+        futures[2].setResult(3);
+        futures[0].setResult(1);
+
+        // THEN
+        QVERIFY(!all.isFinished());
+
+        // WHEN
+        futures[1].setResult(2);
+
+        // THEN
+        QVERIFY(all.isFinished());
+        QCOMPARE(all.result(), QVector<int>() << 1 << 2 << 3);
+    }
+
+    void shouldCombineNoFutures()
+    {
+        // WHEN
+        auto all = whenAll(QVector<Future<int>>());
+
+        // THEN
+        QVERIFY(all.isFinished());
+        QVERIFY(all.result().isEmpty());
+    }
+
+    void shouldFailCombinationOnFirstError()
+    {
+        // GIVEN
+        auto futures = QVector<Future<int>>() << Future<int>() << Future<int>();
+        auto all = whenAll(futures);
+
+        // WHEN
+        futures[0].setError(KJob::UserDefinedError, QStringLiteral("Foo"));
+
+        // THEN
+        QVERIFY(all.isFinished());
+        QCOMPARE(all.error(), int(KJob::UserDefinedError));
+        QCOMPARE(all.errorText(), QStringLiteral("Foo"));
+        QVERIFY(futures[1].isCanceled());
+    }
+
+    void shouldGetValuesFromJobs()
+    {
+        // GIVEN
+        auto job = new FakeJob(this);
+        auto future = fromJob(job, [] { return 42; });
+        QCOMPARE(pendingFutureCount(), 1);
+
+        // WHEN
+        QTest::qWait(FakeJob::DURATION + 10);
+
+        // THEN
+        QVERIFY(future.isFinished());
+        QCOMPARE(future.result(), 42);
+        QCOMPARE(pendingFutureCount(), 0);
+    }
+
+    void shouldGetErrorsFromJobs()
+    {
+        // GIVEN
+        auto job = new FakeJob(this);
+        job->setExpectedError(KJob::UserDefinedError, QStringLiteral("Foo"));
+        bool called = false;
+        auto future = fromJob(job, [&called] {
+            called = true;
+            return 42;
+        });
+
+        // WHEN
+        QTest::qWait(FakeJob::DURATION + 10);
+
+        // THEN
+        QVERIFY(!called);
+        QCOMPARE(future.error(), int(KJob::UserDefinedError));
+        QCOMPARE(future.errorText(), QStringLiteral("Foo"));
+        QCOMPARE(pendingFutureCount(), 0);
+    }
+
+    void shouldEmitJobResultWhenFutureIsDone()
+    {
+        // GIVEN
+        Future<int> future;
+        auto job = toJob(future);
+        QSignalSpy spy(job, &KJob::result);
+        job->start();
+
+        // WHEN
+        future.setError(KJob::UserDefinedError, QStringLiteral("Foo"));
+
+        // THEN
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(job->error(), int(KJob::UserDefinedError));
+        QCOMPARE(job->errorText(), QStringLiteral("Foo"));
+    }
+
+    void shouldEmitJobResultOnlyOnceStarted()
+    {
+        // GIVEN
+        Future<int> future;
+        future.setResult(1);
+        auto job = toJob(future);
+        QSignalSpy spy(job, &KJob::result);
+
+        // WHEN
+        QTest::qWait(10);
+
+        // THEN
+        QCOMPARE(spy.count(), 0);
+
+        // WHEN
+        job->start();
+
+        // THEN
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(job->error(), int(KJob::NoError));
+    }
+
+    void shouldCancelFutureWhenJobIsKilled()
+    {
+        // GIVEN
+        Future<int> future;
+        auto job = toJob(future);
+        job->start();
+
+        // WHEN
+        QVERIFY(job->kill());
+
+        // THEN
+        QVERIFY(future.isCanceled());
+    }
+};
+
+ZANSHIN_TEST_MAIN(FutureTest)
+
+#include "futuretest.moc"
@@ -39,6 +39,7 @@
 #include "presentation/metatypes.h"
 #include "presentation/querytreemodelbase.h"
 
+#include "widgets/availablepagesdelegate.h"
 #include "widgets/availablepagesview.h"
 #include "widgets/newprojectdialog.h"
 #include "widgets/quickselectdialog.h"
@@ -177,6 +178,7 @@ private slots:
         QVERIFY(pagesView->isVisibleTo(&available));
         QVERIFY(!pagesView->header()->isVisibleTo(&available));
         QCOMPARE(pagesView->dragDropMode(), QTreeView::DropOnly);
+        QVERIFY(qobject_cast<Widgets::AvailablePagesDelegate*>(pagesView->itemDelegate()));
 
         auto actionBar = available.findChild<QToolBar*>(QStringLiteral("actionBar"));
         QVERIFY(actionBar);
@@ -280,6 +282,53 @@ private slots:
         QCOMPARE(pagesView->selectionModel()->currentIndex(), model.index(0, 0));
     }
 
+    void shouldDisplayPageCounts()
+    {
+        // GIVEN
+        QStandardItemModel model;
+        auto inboxItem = new QStandardItem(QStringLiteral("Inbox"));
+        inboxItem->setData(3, Presentation::QueryTreeModelBase::CountRole);
+        model.appendRow(inboxItem);
+        auto projectsItem = new QStandardItem(QStringLiteral("Projects"));
+        model.appendRow(projectsItem);
+
+        AvailablePagesModelStub stubPagesModel;
+        stubPagesModel.setProperty("pageListModel", QVariant::fromValue(static_cast<QAbstractItemModel*>(&model)));
+
+        Widgets::AvailablePagesView available;
+        available.setModel(&stubPagesModel);
+        QTest::qWait(10);
+
+        auto pagesView = available.findChild<QTreeView*>(QStringLiteral("pagesView"));
+        QVERIFY(pagesView);
+        auto delegate = qobject_cast<Widgets::AvailablePagesDelegate*>(pagesView->itemDelegate());
+        QVERIFY(delegate);
+
+        // WHEN
+        QStyleOptionViewItem inboxOption;
+        delegate->initStyleOption(&inboxOption, inboxItem->index());
+        QStyleOptionViewItem projectsOption;
+        delegate->initStyleOption(&projectsOption, projectsItem->index());
+
+        // THEN
+        QCOMPARE(inboxOption.text, QStringLiteral("Inbox (3)"));
+        QCOMPARE(projectsOption.text, QStringLiteral("Projects"));
+
+        // WHEN
+        inboxItem->setData(4, Presentation::QueryTreeModelBase::CountRole);
+        delegate->initStyleOption(&inboxOption, inboxItem->index());
+
+        // THEN
+        QCOMPARE(inboxOption.text, QStringLiteral("Inbox (4)"));
+
+        // WHEN
+        inboxItem->setData(0, Presentation::QueryTreeModelBase::CountRole);
+        delegate->initStyleOption(&inboxOption, inboxItem->index());
+
+        // THEN
+        QCOMPARE(inboxOption.text, QStringLiteral("Inbox"));
+    }
+
     void shouldNotCrashWithNullModel()
     {
         // GIVEN
@@ -26,22 +26,40 @@
 #include <QCheckBox>
 #include <QComboBox>
 #include <QLineEdit>
+#include <QStandardItemModel>
 #include <QToolButton>
 
 #include <KLocalizedString>
 
 #include "widgets/filterwidget.h"
 
+#include "domain/task.h"
+
 #include "presentation/artifactfilterproxymodel.h"
+#include "presentation/querytreemodelbase.h"
 
 class FilterWidgetTest : public QObject
 {
     Q_OBJECT
+private:
+    QStandardItem *createTaskItem(const QString &title) const
+    {
+        auto task = Domain::Task::Ptr::create();
+        task->setTitle(title);
+
+        auto item = new QStandardItem;
+        item->setData(task->title(), Qt::DisplayRole);
+        item->setData(QVariant::fromValue(Domain::Artifact::Ptr(task)),
+                      Presentation::QueryTreeModelBase::ObjectRole);
+        return item;
+    }
+
 private slots:
     void shouldHaveDefaultState()
     {
         Widgets::FilterWidget filter;
 
+        QVERIFY(filter.isAsynchronous());
         QVERIFY(filter.proxyModel());
         QVERIFY(!filter.proxyModel()->sourceModel());
         QCOMPARE(filter.proxyModel()->filterRegExp(), QRegExp());
@@ -94,10 +112,65 @@ private slots:
         // WHEN
         QTest::keyClicks(filterEdit, QStringLiteral("find me"));
 
+        // THEN
+        QTRY_COMPARE(filter.proxyModel()->filterRegExp().pattern(), QStringLiteral("find me"));
+    }
+
+    void shouldChangeAppliedFilterSynchronously()
+    {
+        // GIVEN
+        Widgets::FilterWidget filter;
+        filter.setAsynchronous(false);
+        QVERIFY(!filter.isAsynchronous());
+
+        QLineEdit *filterEdit = filter.findChild<QLineEdit*>(QStringLiteral("filterEdit"));
+        QVERIFY(filterEdit);
+
+        // WHEN
+        QTest::keyClicks(filterEdit, QStringLiteral("find me"));
+
         // THEN
         QCOMPARE(filter.proxyModel()->filterRegExp().pattern(), QStringLiteral("find me"));
     }
 
+    void shouldOnlyApplyTheLastTypedFilter()
+    {
+        // GIVEN
+        QStandardItemModel input;
+        input.appendRow(createTaskItem(QStringLiteral("foo")));
+        input.appendRow(createTaskItem(QStringLiteral("foobar")));
+        input.appendRow(createTaskItem(QStringLiteral("baz")));
+
+        Widgets::FilterWidget filter;
+        filter.proxyModel()->setSourceModel(&input);
+
+        QLineEdit *filterEdit = filter.findChild<QLineEdit*>(QStringLiteral("filterEdit"));
+        QVERIFY(filterEdit);
+
+        // WHEN
+        QTest::keyClicks(filterEdit, QStringLiteral("foo"));
+
+        // THEN
+        QCOMPARE(filter.proxyModel()->rowCount(), 3);
+        QTRY_COMPARE(filter.proxyModel()->rowCount(), 2);
+
+        // WHEN
+        QTest::keyClicks(filterEdit, QStringLiteral("b"));
+        filterEdit->setText(QStringLiteral("ba"));
+
+        // THEN
+        QTRY_COMPARE(filter.proxyModel()->filterRegExp().pattern(), QStringLiteral("ba"));
+        QCOMPARE(filter.proxyModel()->rowCount(), 2);
+        QCOMPARE(filter.proxyModel()->index(0, 0).data().toString(), QStringLiteral("foobar"));
+        QCOMPARE(filter.proxyModel()->index(1, 0).data().toString(), QStringLiteral("baz"));
+
+        // WHEN
+        filter.clear();
+
+        // THEN
+        QCOMPARE(filter.proxyModel()->rowCount(), 3);
+    }
+
     void shouldClearFilter()
     {
         // GIVEN
@@ -0,0 +1,123 @@
+/* This file is part of Zanshin
+
+   Copyright 2016 Kevin Ottens <ervin@kde.org>
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License as
+   published by the Free Software Foundation; either version 2 of
+   the License or (at your option) version 3 or any later version
+   accepted by the membership of KDE e.V. (or its successor approved
+   by the membership of KDE e.V.), which shall act as a proxy
+   defined in Section 14 of version 3 of the license.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,
+   USA.
+*/
+
+#include <testlib/qtest_gui_zanshin.h>
+
+#include <QPainter>
+#include <QStandardItemModel>
+#include <QTreeView>
+
+#include "domain/task.h"
+
+#include "presentation/metatypes.h"
+#include "presentation/querytreemodelbase.h"
+
+#include "widgets/itemdelegate.h"
+
+class ItemDelegateTest : public QObject
+{
+    Q_OBJECT
+private:
+    QImage paintRow(Widgets::ItemDelegate *delegate, QTreeView *view, const QModelIndex &index) const
+    {
+        auto option = QStyleOptionViewItem();
+        option.initFrom(view);
+        option.widget = view;
+        option.locale = view->locale();
+        option.rect = QRect(0, 0, 300, 20);
+
+        auto image = QImage(option.rect.size(), QImage::Format_ARGB32);
+        image.fill(Qt::white);
+        QPainter painter(&image);
+        delegate->paint(&painter, option, index);
+        return image;
+    }
+
+    QStandardItem *createTaskItem(const Domain::Task::Ptr &task) const
+    {
+        auto item = new QStandardItem(task->title());
+        item->setData(QVariant::fromValue<Domain::Artifact::Ptr>(task), Presentation::QueryTreeModelBase::ObjectRole);
+        return item;
+    }
+
+private slots:
+    void shouldLayoutRowAgainWhenItsDataChanges()
+    {
+        // GIVEN
+        auto task = Domain::Task::Ptr::create();
+        task->setTitle(QStringLiteral("Foo"));
+
+        QStandardItemModel model;
+        auto item = createTaskItem(task);
+        model.appendRow(item);
+
+        QTreeView view;
+        view.setModel(&model);
+
+        Widgets::ItemDelegate delegate;
+        const auto before = paintRow(&delegate, &view, item->index());
+        QCOMPARE(paintRow(&delegate, &view, item->index()), before);
+
+        // WHEN
+        task->setTitle(QStringLiteral("A much longer title"));
+        item->setText(task->title());
+
+        // THEN
+        Widgets::ItemDelegate freshDelegate;
+        const auto after = paintRow(&delegate, &view, item->index());
+        QVERIFY(after != before);
+        QCOMPARE(after, paintRow(&freshDelegate, &view, item->index()));
+    }
+
+    void shouldLayoutRowAgainWhenLocaleChanges()
+    {
+        // GIVEN
+        auto task = Domain::Task::Ptr::create();
+        task->setTitle(QStringLiteral("Foo"));
+        task->setDueDate(QDateTime(QDate(2014, 3, 26)));
+
+        QStandardItemModel model;
+        auto item = createTaskItem(task);
+        model.appendRow(item);
+
+        QTreeView view;
+        view.setLocale(QLocale(QLocale::English, QLocale::UnitedStates));
+        view.setModel(&model);
+
+        Widgets::ItemDelegate delegate;
+        const auto before = paintRow(&delegate, &view, item->index());
+
+        // WHEN
+        view.setLocale(QLocale(QLocale::German, QLocale::Germany));
+
+        // THEN
+        Widgets::ItemDelegate freshDelegate;
+        const auto after = paintRow(&delegate, &view, item->index());
+        QVERIFY(after != before);
+        QCOMPARE(after, paintRow(&freshDelegate, &view, item->index()));
+    }
+};
+
+ZANSHIN_TEST_MAIN(ItemDelegateTest)
+
+#include "itemdelegatetest.moc"
@@ -95,9 +95,11 @@ public slots:
         parentIndices << parentIndex;
     }
 
-    void removeItem(const QModelIndex &index)
+    void removeItems(const QModelIndexList &indexes)
     {
-        removedIndices << index;
+        removeItemsCalls++;
+        foreach (const QModelIndex &index, indexes)
+            removedIndices << index;
     }
 
     void promoteItem(const QModelIndex &index)
@@ -106,6 +108,7 @@ public slots:
     }
 
 public:
+    int removeItemsCalls = 0;
     QStringList taskNames;
     QList<QPersistentModelIndex> parentIndices;
     QList<QPersistentModelIndex> removedIndices;
@@ -154,6 +157,7 @@ private slots:
         QVERIFY(!centralView->header()->isVisibleTo(&page));
         QVERIFY(qobject_cast<Widgets::ItemDelegate*>(centralView->itemDelegate()));
         QVERIFY(centralView->alternatingRowColors());
+        QVERIFY(centralView->uniformRowHeights());
         QCOMPARE(centralView->dragDropMode(), QTreeView::DragDrop);
 
         auto filter = page.findChild<Widgets::FilterWidget*>(QStringLiteral("filterWidget"));
@@ -548,6 +552,40 @@ private slots:
         QCOMPARE(stubPageModel.removedIndices.at(1), index2);
     }
 
+    void shouldDeleteItemsInOneBatch()
+    {
+        // GIVEN
+        PageModelStub stubPageModel;
+        stubPageModel.addStubItems(QStringList() << QStringLiteral("A") << QStringLiteral("B") << QStringLiteral("C"));
+        QPersistentModelIndex index = stubPageModel.itemModel.index(1, 0);
+        QPersistentModelIndex index2 = stubPageModel.itemModel.index(2, 0);
+
+        Widgets::PageView page;
+        page.setModel(&stubPageModel);
+        auto msgbox = MessageBoxStub::Ptr::create();
+        page.setMessageBoxInterface(msgbox);
+
+        QTreeView *centralView = page.findChild<QTreeView*>(QStringLiteral("centralView"));
+        centralView->selectionModel()->setCurrentIndex(index, QItemSelectionModel::ClearAndSelect);
+        centralView->selectionModel()->setCurrentIndex(index2, QItemSelectionModel::Select);
+        centralView->setFocus();
+
+        // Needed for shortcuts to work
+        page.show();
+        QTest::qWaitForWindowShown(&page);
+        QTest::qWait(100);
+
+        // WHEN
+        QTest::keyPress(centralView, Qt::Key_Delete);
+
+        // THEN
+        QVERIFY(msgbox->called());
+        QCOMPARE(stubPageModel.removeItemsCalls, 1);
+        QCOMPARE(stubPageModel.removedIndices.size(), 2);
+        QCOMPARE(stubPageModel.removedIndices.first(), index);
+        QCOMPARE(stubPageModel.removedIndices.at(1), index2);
+    }
+
     void shouldPromoteItem()
     {
         // GIVEN